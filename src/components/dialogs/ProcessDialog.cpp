@@ -1,5 +1,7 @@
 #include "ProcessDialog.h"
+#include "../../core/LaunchCoordinator.h"
 #include "../../styles/ButtonStyle.h"
+#include "../../styles/GroupBoxStyle.h"
 #include "../../styles/InputStyle.h"
 #include <QFileDialog>
 #include <QFormLayout>
@@ -63,6 +65,16 @@ void ProcessDialog::setupUI()
     workingDirLayout->addWidget(browseButton);
     formLayout->addRow("Directory:", workingDirLayout);
 
+    QGroupBox* dependencyGroup = new QGroupBox("Starts after");
+    dependencyGroup->setStyleSheet(GroupBoxStyle::primary());
+    QVBoxLayout* dependencyLayout = new QVBoxLayout(dependencyGroup);
+
+    dependencyListWidget = new QListWidget();
+    dependencyListWidget->setStyleSheet("background: transparent; border: none;");
+    dependencyListWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    dependencyListWidget->setMaximumHeight(120);
+    dependencyLayout->addWidget(dependencyListWidget);
+
     auto* buttonLayout = new QHBoxLayout();
     buttonLayout->addStretch();
 
@@ -75,9 +87,11 @@ void ProcessDialog::setupUI()
     buttonLayout->addWidget(okButton);
 
     mainLayout->addLayout(formLayout);
+    mainLayout->addWidget(dependencyGroup);
     mainLayout->addLayout(buttonLayout);
 
     loadTemplatesFromRepository();
+    loadDependencies();
 }
 
 void ProcessDialog::setupConnections()
@@ -123,6 +137,39 @@ void ProcessDialog::loadTemplatesFromRepository()
     templateComboBox->setCurrentIndex(0);
 }
 
+void ProcessDialog::loadDependencies()
+{
+    dependencyListWidget->clear();
+
+    const QList<int> dependencyIds = process.getId() > 0 ? processRepository.findDependencyIds(process.getId())
+                                                         : QList<int>();
+
+    for (const Process& candidate : processRepository.findByProjectId(project.getId()))
+    {
+        if (candidate.getId() == process.getId())
+            continue;
+
+        QListWidgetItem* item = new QListWidgetItem(candidate.getName(), dependencyListWidget);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(dependencyIds.contains(candidate.getId()) ? Qt::Checked : Qt::Unchecked);
+        item->setData(Qt::UserRole, candidate.getId());
+    }
+}
+
+QList<int> ProcessDialog::getSelectedDependencyIds() const
+{
+    QList<int> selectedIds;
+    for (int i = 0; i < dependencyListWidget->count(); ++i)
+    {
+        QListWidgetItem* item = dependencyListWidget->item(i);
+        if (item->checkState() == Qt::Checked)
+        {
+            selectedIds.append(item->data(Qt::UserRole).toInt());
+        }
+    }
+    return selectedIds;
+}
+
 Process ProcessDialog::getProcess()
 {
     return process;
@@ -155,6 +202,25 @@ void ProcessDialog::onOkClicked()
         return;
     }
 
+    // A new process has no dependents yet, so only an existing one can close a cycle
+    if (process.getId() > 0)
+    {
+        QList<int> processIds;
+        for (const Process& other : processRepository.findByProjectId(project.getId()))
+        {
+            processIds.append(other.getId());
+        }
+
+        QHash<int, QList<int>> dependencies = processRepository.findDependenciesByProjectId(project.getId());
+        dependencies.insert(process.getId(), getSelectedDependencyIds());
+
+        if (LaunchCoordinator::hasCycle(processIds, dependencies))
+        {
+            QMessageBox::warning(this, "Validation Error", "Processes cannot wait on each other in a cycle!");
+            return;
+        }
+    }
+
     process.setName(name);
     process.setCommand(command);
     process.setWorkingDirectory(dir);
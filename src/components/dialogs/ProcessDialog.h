@@ -15,6 +15,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListWidget>
 #include <QMap>
 #include <QPushButton>
 #include <QSpinBox>
@@ -31,6 +32,7 @@ class ProcessDialog : public QDialog
 
     Process getProcess();
     void setProcess(const Process& process);
+    QList<int> getSelectedDependencyIds() const;
 
   private slots:
     void onOkClicked();
@@ -42,6 +44,7 @@ class ProcessDialog : public QDialog
     void setupUI();
     void setupConnections();
     void loadTemplatesFromRepository();
+    void loadDependencies();
     void applyTemplate(const ProcessTemplate& processTemplate);
 
   private:
@@ -56,6 +59,7 @@ class ProcessDialog : public QDialog
     QLineEdit* workingDirEdit;
     QPushButton* browseButton;
     QComboBox* templateComboBox;
+    QListWidget* dependencyListWidget;
     QPushButton* okButton;
     QPushButton* cancelButton;
     QMap<QString, ProcessTemplate> processTemplateMap;
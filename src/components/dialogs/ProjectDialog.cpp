@@ -198,7 +198,7 @@ void ProjectDialog::onDeleteClicked()
     {
         if (repositoryProvider.getProjectRepository().deleteById(project.getId()))
         {
-            LOG_INFO("Deleted project: " + project.getName());
+            LOG_INFO_IN(Ui, "Deleted project: " + project.getName());
             AppEvents::instance().notifyRefreshHomeSidebar();
             accept();
         }
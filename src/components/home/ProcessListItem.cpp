@@ -2,49 +2,41 @@
 #include "../../styles/ButtonStyle.h"
 #include "../../styles/GroupBoxStyle.h"
 #include "../../windows/ProcessWindow.h"
+#include "../../core/LogCompactor.h"
+#include "../../core/LogStream.h"
 #include "../../core/Logger.h"
-#include <QDir>
+#include "../../core/ProcessLogSink.h"
+#include "../../core/ProcessSupervisor.h"
 #include <QHBoxLayout>
+#include <QSettings>
 #include <QTimer>
 #include <QVBoxLayout>
+#include <memory>
 
-ProcessListItem::ProcessListItem(Process& process, IProcessRepository& processRepository, QWidget* parent)
-    : QGroupBox(parent), process(process), processRepository(processRepository)
+#if !defined(Q_OS_WIN)
+#include <unistd.h>
+#endif
+
+ProcessListItem::ProcessListItem(Process& process, ProcessStatusWriter& statusWriter, QWidget* parent)
+    : QGroupBox(parent), process(process), statusWriter(statusWriter)
 {
     setStyleSheet(GroupBoxStyle::primary());
     setupUI();
     setupConnections();
 
-    // Check if process is actually running when the list item is created
-    if (process.getStatus() == Process::Status::Running && process.getPID() > 0)
-    {
-        if (!isProcessRunning(process.getPID()))
-        {
-            // PID is no longer valid, check by port
-            int pidFromPort = findPidByPort(process.getPort());
-            if (pidFromPort > 0)
-            {
-                // Update with the correct PID
-                process.setPID(pidFromPort);
-                processRepository.save(process);
-            }
-            else
-            {
-                // Process is not actually running
-                process.setStatus(Process::Status::Stopped);
-                process.setPID(0);
-                processRepository.save(process);
-            }
-        }
-    }
-
     updateStatus();
 
-    // Start background monitoring for running processes
-    if (process.getStatus() == Process::Status::Running)
+    // The persisted state was reconciled when the project was loaded; from here on the supervisor
+    // reports a stale PID through pidChanged and a dead process through processStopped
+    if (this->process.getStatus() == Process::Status::Running)
     {
         startBackgroundMonitoring();
     }
+    else if (this->process.getStatus() == Process::Status::Starting)
+    {
+        // Left Starting by the reconciler: alive but its port is not bound yet
+        startPortPolling();
+    }
 }
 
 ProcessListItem::~ProcessListItem()
@@ -117,6 +109,38 @@ void ProcessListItem::setupConnections()
     connect(terminalButton, &QPushButton::clicked, this, &ProcessListItem::openTerminalWindow);
     connect(editButton, &QPushButton::clicked, this, [this]() { emit editRequested(this->process); });
     connect(deleteButton, &QPushButton::clicked, this, [this]() { emit deleteRequested(this->process); });
+
+    ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+    connect(&supervisor, &ProcessSupervisor::processReady, this,
+            [this](int processId, int pid)
+            {
+                if (processId == process.getId())
+                    onProcessReady(pid);
+            });
+    connect(&supervisor, &ProcessSupervisor::startupTimedOut, this,
+            [this](int processId)
+            {
+                if (processId == process.getId())
+                    onStartupTimedOut();
+            });
+    connect(&supervisor, &ProcessSupervisor::pidChanged, this,
+            [this](int processId, int pid)
+            {
+                if (processId == process.getId())
+                    onPidChanged(pid);
+            });
+    connect(&supervisor, &ProcessSupervisor::processStopped, this,
+            [this](int processId)
+            {
+                if (processId == process.getId())
+                    onProcessStopped();
+            });
+    connect(&supervisor, &ProcessSupervisor::stopFinished, this,
+            [this](int processId)
+            {
+                if (processId == process.getId())
+                    onStopFinished();
+            });
 }
 
 void ProcessListItem::setProcess(Process& process)
@@ -164,6 +188,8 @@ void ProcessListItem::updateStatus()
                             process.getStatus() == Process::Status::Error);
     stopButton->setEnabled(process.getStatus() == Process::Status::Running ||
                            process.getStatus() == Process::Status::Starting);
+
+    emit statusChanged(process.getId(), process.getStatus());
 }
 
 Process ProcessListItem::getProcess()
@@ -187,24 +213,47 @@ void ProcessListItem::startCommand()
         qProcess->setWorkingDirectory(process.getWorkingDirectory());
     }
 
-    QString logsDirPath = QDir::current().absoluteFilePath("logs");
-    QDir logsDir(logsDirPath);
-    if (!logsDir.exists())
-    {
-        logsDir.mkpath(".");
-    }
-
-    QString logFilePath = logsDir.filePath(process.getName() + ".log");
     qProcess->setProcessChannelMode(QProcess::MergedChannels);
 
-    QFile logHeader(logFilePath);
-    if (logHeader.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+    // Owned by the QProcess, so the buffered tail is written when the QProcess is deleted
+    ProcessLogSink* logSink =
+        new ProcessLogSink(SegmentedLog::directoryFor(process.getProjectId(), process.getId()),
+                           ProcessLogSink::BufferLimit, ProcessLogSink::FlushIntervalMs, qProcess);
+    // Open viewers follow the output through the stream; the file keeps the full history. The sink
+    // goes with the QProcess, after the last output was written.
+    LogStream* logStream = &LogStreamHub::instance().acquire(process.getId());
+    connect(logSink, &QObject::destroyed, [processId = process.getId()]()
+            { LogStreamHub::instance().release(processId); });
+    auto writeOutput = [logSink, logStream](const QByteArray& data)
     {
-        QTextStream out(&logHeader);
-        out << "\n\n===== Starting process: " << process.getName() << " ("
-            << QDateTime::currentDateTime().toString(Qt::ISODate) << ") =====\n";
-    }
-
+        if (data.isEmpty())
+            return;
+        logStream->write(data, logSink->position());
+        logSink->write(data);
+    };
+
+    // Progress bars and repeated lines are compacted unless the raw output was asked for
+    std::shared_ptr<LogCompactor> compactor;
+    if (QSettings().value("logs/compactOutput", true).toBool())
+        compactor = std::make_shared<LogCompactor>();
+    QTimer* compactorTimer = new QTimer(qProcess);
+    compactorTimer->setSingleShot(true);
+    compactorTimer->setInterval(LogCompactor::IdleFlushMs);
+    connect(compactorTimer, &QTimer::timeout, logSink,
+            [writeOutput, compactor]() { writeOutput(compactor->flush()); });
+
+    logSink->open();
+    writeOutput(QString("\n\n===== Starting process: %1 (%2) =====\n")
+                    .arg(process.getName(), QDateTime::currentDateTime().toString(Qt::ISODate))
+                    .toUtf8());
+
+    // What the compactor held back goes to the log before anyone reacts to the exit
+    connect(qProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), logSink,
+            [writeOutput, compactor]()
+            {
+                if (compactor)
+                    writeOutput(compactor->flush());
+            });
     connect(qProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
             [this](int exitCode, QProcess::ExitStatus exitStatus) { handleProcessFinished(exitCode, exitStatus); });
 
@@ -213,29 +262,37 @@ void ProcessListItem::startCommand()
     connect(qProcess, &QProcess::errorOccurred, this,
             [this](QProcess::ProcessError error)
             {
-                // Don't mark as error if we're shutting down
-                if (!isShuttingDown)
+                // Don't mark as error if we're shutting down or killed it ourselves
+                if (!isShuttingDown && !isStopping && process.getStatus() != Process::Status::Stopped)
                 {
                     process.setStatus(Process::Status::Error);
-                    processRepository.save(process);
+                    statusWriter.enqueue(process);
                     updateStatus();
                 }
             });
 
     connect(qProcess, &QProcess::readyReadStandardOutput, this,
-            [this, logFilePath]()
+            [this, writeOutput, compactor, compactorTimer]()
             {
-                QByteArray rawData = qProcess->readAllStandardOutput();
-
-                QFile logFile(logFilePath);
-                if (logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+                const QByteArray output = qProcess->readAllStandardOutput();
+                if (!compactor)
                 {
-                    QTextStream out(&logFile);
-                    out << QString::fromUtf8(rawData);
+                    writeOutput(output);
+                    return;
                 }
+                writeOutput(compactor->compact(output));
+                compactorTimer->start();
             });
 
+    ProcessSupervisor::instance().trackLaunch(qProcess);
+
+#if defined(Q_OS_WIN)
     qProcess->start("cmd.exe", {"/C", process.getCommand()});
+#else
+    // The shell leads a new process group, so stopping reaches everything the command spawns
+    qProcess->setChildProcessModifier([]() { ::setsid(); });
+    qProcess->start("/bin/sh", {"-c", process.getCommand()});
+#endif
 }
 
 void ProcessListItem::handleProcessStarted()
@@ -257,163 +314,97 @@ void ProcessListItem::handleProcessStarted()
 
 void ProcessListItem::startPortPolling()
 {
-    if (pollTimer)
-    {
-        pollTimer->stop();
-        pollTimer->deleteLater();
-    }
-
-    pollTimer = new QTimer(this);
-    int attempts = 0;
-    const int maxAttempts = 30;
-    const int intervalMs = 500;
-
-    connect(pollTimer, &QTimer::timeout, this,
-            [this, attempts, maxAttempts, intervalMs]() mutable
-            {
-                attempts++;
-                int realPid = findPidByPort(process.getPort());
-
-                if (realPid > 0)
-                {
-                    process.setStatus(Process::Status::Running);
-                    process.setLastStartedAt(QDateTime::currentDateTime());
-                    process.setPID(realPid);
-                    processRepository.save(process);
-                    updateStatus();
-
-                    // Start background monitoring since we now have the real PID
-                    startBackgroundMonitoring();
-
-                    pollTimer->stop();
-                    pollTimer->deleteLater();
-                    pollTimer = nullptr;
-                }
-                else if (attempts >= maxAttempts)
-                {
-                    LOG_INFO("Timeout: Could not find PID for port " + QString::number(process.getPort()));
-
-                    process.setStatus(Process::Status::Error);
-                    processRepository.save(process);
-                    updateStatus();
-                    pollTimer->stop();
-                    pollTimer->deleteLater();
-                    pollTimer = nullptr;
-                }
-            });
-
-    pollTimer->start(intervalMs);
+    // Without a port there is nothing to bind; outliving the grace period makes it Running
+    if (process.getPort() > 0)
+        ProcessSupervisor::instance().awaitPort(process.getId(), process.getPort());
+    else
+        ProcessSupervisor::instance().awaitRunning(process.getId(), process.getPID());
 }
 
 void ProcessListItem::startBackgroundMonitoring()
 {
-    if (monitorTimer)
-    {
-        monitorTimer->stop();
-        monitorTimer->deleteLater();
-    }
-
     // Only monitor if process is running
     if (process.getStatus() != Process::Status::Running)
     {
         return;
     }
 
-    monitorTimer = new QTimer(this);
-    connect(monitorTimer, &QTimer::timeout, this,
-            [this]()
-            {
-                // Check if the process is still running using multiple methods
-                bool isRunning = false;
+    ProcessSupervisor::instance().monitor(process.getId(), process.getPID(), process.getPort());
+}
 
-                // Method 1: Check by stored PID
-                if (process.getPID() > 0)
-                {
-                    isRunning = isProcessRunning(process.getPID());
-                }
+void ProcessListItem::onProcessReady(int pid)
+{
+    process.setStatus(Process::Status::Running);
+    process.setLastStartedAt(QDateTime::currentDateTime());
+    process.setPID(pid);
+    statusWriter.enqueue(process);
+    updateStatus();
 
-                // Method 2: If PID check fails, check by port
-                if (!isRunning && process.getPort() > 0)
-                {
-                    int pidFromPort = findPidByPort(process.getPort());
-                    if (pidFromPort > 0)
-                    {
-                        // Update PID if it changed
-                        if (pidFromPort != process.getPID())
-                        {
-                            process.setPID(pidFromPort);
-                            processRepository.save(process);
-                        }
-                        isRunning = true;
-                    }
-                }
+    // The supervisor keeps watching the real PID from here on
+    startBackgroundMonitoring();
+}
 
-                // Update status if process is no longer running
-                if (!isRunning)
-                {
-                    process.setStatus(Process::Status::Stopped);
-                    process.setPID(0);
-                    processRepository.save(process);
-                    updateStatus();
+void ProcessListItem::onStartupTimedOut()
+{
+    process.setStatus(Process::Status::Error);
+    statusWriter.enqueue(process);
+    updateStatus();
+}
 
-                    monitorTimer->stop();
-                    monitorTimer->deleteLater();
-                    monitorTimer = nullptr;
-                }
-            });
+void ProcessListItem::onPidChanged(int pid)
+{
+    process.setPID(pid);
+    statusWriter.enqueue(process);
+    updateStatus();
+}
 
-    monitorTimer->start(5000);
+void ProcessListItem::onProcessStopped()
+{
+    process.setStatus(Process::Status::Stopped);
+    process.setPID(0);
+    statusWriter.enqueue(process);
+    updateStatus();
 }
 
 void ProcessListItem::stopCommand()
 {
-    // Stop monitoring first
-    if (monitorTimer)
+    if (isStopping)
     {
-        monitorTimer->stop();
-        monitorTimer->deleteLater();
-        monitorTimer = nullptr;
+        return;
     }
 
-    // Stop port polling
-    if (pollTimer)
-    {
-        pollTimer->stop();
-        pollTimer->deleteLater();
-        pollTimer = nullptr;
-    }
+    isStopping = true;
+    stopButton->setEnabled(false);
+    statusLabel->setText("Stopping...");
 
-    // Method 1: Stop by stored PID
-    if (process.getPID() > 0)
+    // Terminating and waiting for the exit happens on the supervisor's worker thread
+    QList<int> pids = {process.getPID()};
+    if (qProcess && qProcess->state() != QProcess::NotRunning)
     {
-        QProcess::execute("taskkill", {"/PID", QString::number(process.getPID()), "/T", "/F"});
+        pids.append(static_cast<int>(qProcess->processId()));
     }
+    ProcessSupervisor::instance().stop(process.getId(), pids, process.getPort());
 
-    // Method 2: Stop QProcess if it exists
-    if (qProcess && qProcess->state() == QProcess::Running)
+#if defined(Q_OS_WIN)
+    if (qProcess && qProcess->state() != QProcess::NotRunning)
     {
         qProcess->terminate();
-        if (!qProcess->waitForFinished(3000))
-        {
-            qProcess->kill();
-            qProcess->waitForFinished(1000);
-        }
+        QTimer::singleShot(ProcessSupervisor::StopTimeoutMs, qProcess, &QProcess::kill);
     }
+#endif
+}
 
-    // Method 3: Fallback - kill by port
-    int pidFromPort = findPidByPort(process.getPort());
-    if (pidFromPort > 0 && pidFromPort != process.getPID())
-    {
-        QProcess::execute("taskkill", {"/PID", QString::number(pidFromPort), "/T", "/F"});
-    }
+void ProcessListItem::onStopFinished()
+{
+    isStopping = false;
 
     process.setPID(0);
     process.setStatus(Process::Status::Stopped);
-    processRepository.save(process);
+    statusWriter.enqueue(process);
     updateStatus();
 
-    // Clean up QProcess
-    if (qProcess)
+    // A QProcess that is still exiting is cleaned up by handleProcessFinished
+    if (qProcess && qProcess->state() == QProcess::NotRunning)
     {
         qProcess->deleteLater();
         qProcess = nullptr;
@@ -425,29 +416,12 @@ void ProcessListItem::handleProcessFinished(int exitCode, QProcess::ExitStatus e
     Q_UNUSED(exitCode)
     Q_UNUSED(exitStatus)
 
-    // Don't immediately mark as stopped check if the actual application is still running
-    if (process.getStatus() == Process::Status::Running)
+    // Don't immediately mark as stopped, the launcher may exit while the application keeps running.
+    // The supervisor re-checks PID and port off the GUI thread and reports pidChanged or processStopped.
+    if (process.getStatus() == Process::Status::Running && !isStopping)
     {
-        // Check if the real process (by port) is still running
-        int pidFromPort = findPidByPort(process.getPort());
-        if (pidFromPort > 0)
-        {
-            // Application is still running, just update the PID
-            process.setPID(pidFromPort);
-            processRepository.save(process);
-            updateStatus();
-
-            // Ensure monitoring continues
-            startBackgroundMonitoring();
-        }
-        else
-        {
-            // Application is actually stopped
-            process.setPID(0);
-            process.setStatus(Process::Status::Stopped);
-            processRepository.save(process);
-            updateStatus();
-        }
+        startBackgroundMonitoring();
+        ProcessSupervisor::instance().requestSweep();
     }
 
     if (qProcess)
@@ -461,20 +435,8 @@ void ProcessListItem::prepareForShutdown()
 {
     isShuttingDown = true;
 
-    // Stop all timers
-    if (pollTimer)
-    {
-        pollTimer->stop();
-        pollTimer->deleteLater();
-        pollTimer = nullptr;
-    }
-
-    if (monitorTimer)
-    {
-        monitorTimer->stop();
-        monitorTimer->deleteLater();
-        monitorTimer = nullptr;
-    }
+    // Monitoring of a running process is owned by the supervisor and outlives this item,
+    // so a reloaded list picks it up again without probing
 
     // Don't terminate QProcess during shutdown, let the OS handle it
     // This prevents the error signals from being emitted
@@ -485,8 +447,9 @@ void ProcessListItem::prepareForShutdown()
 
         if (process.getStatus() == Process::Status::Starting)
         {
+            ProcessSupervisor::instance().release(process.getId());
             process.setStatus(Process::Status::Stopped);
-            processRepository.save(process);
+            statusWriter.enqueue(process);
         }
     }
 }
@@ -509,49 +472,3 @@ QPushButton* ProcessListItem::getStopButton()
 {
     return stopButton;
 }
-
-bool ProcessListItem::isProcessRunning(int pid)
-{
-    QProcess process;
-    process.start("tasklist", {"/FI", QString("PID eq %1").arg(pid)});
-    process.waitForFinished();
-
-    QString output = process.readAllStandardOutput();
-    return output.contains(QString::number(pid));
-}
-
-int ProcessListItem::findPidByPort(int port)
-{
-    QString command = QString("netstat -ano | findstr :%1").arg(port);
-    QProcess getPid;
-    getPid.start("cmd.exe", QStringList() << "/C" << command);
-    getPid.waitForFinished();
-
-    QString output = getPid.readAllStandardOutput();
-    QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-
-    QRegularExpression re("\\s+(\\d+)\\s*$");
-
-    for (const QString& line : lines)
-    {
-        QString trimmed = line.trimmed();
-
-        if (trimmed.contains("TIME_WAIT") || trimmed.contains("CLOSE_WAIT"))
-        {
-            continue;
-        }
-
-        QRegularExpressionMatch match = re.match(trimmed);
-        if (match.hasMatch())
-        {
-            int pid = match.captured(1).toInt();
-            if (pid != 0)
-            {
-                LOG_INFO("Found PID: " + QString::number(pid));
-                return pid;
-            }
-        }
-    }
-
-    return 0;
-}
@@ -2,48 +2,52 @@
 #define PROCESSLISTITEM_H
 
 #include "../../models/Process.h"
-#include "../../repositories/interfaces/IProcessRepository.h"
+#include "../../repositories/ProcessStatusWriter.h"
 #include <QGroupBox>
 #include <QLabel>
 #include <QProcess>
 #include <QPushButton>
 #include <QTextEdit>
-#include <QTimer>
 
 class ProcessListItem : public QGroupBox
 {
     Q_OBJECT
 
   public:
-    explicit ProcessListItem(Process& process, IProcessRepository& processRepository, QWidget* parent = nullptr);
+    explicit ProcessListItem(Process& process, ProcessStatusWriter& statusWriter, QWidget* parent = nullptr);
     ~ProcessListItem();
 
     void setProcess(Process& process);
     QPushButton* getStartButton();
     QPushButton* getStopButton();
     Process getProcess();
+    void startCommand();
 
   private:
     void setupUI();
     void setupConnections();
-    void startCommand();
     void stopCommand();
     void updateStatus();
     void openTerminalWindow();
-    bool isProcessRunning(int pid);
-    int findPidByPort(int port);
     void handleProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void startBackgroundMonitoring();
     void startPortPolling();
     void handleProcessStarted();
+    void onProcessReady(int pid);
+    void onStartupTimedOut();
+    void onPidChanged(int pid);
+    void onProcessStopped();
+    void onStopFinished();
     void prepareForShutdown();
 
   signals:
     void editRequested(Process& process);
     void deleteRequested(Process& process);
+    // Emitted on every status refresh; a launch plan waits for Running before starting dependents
+    void statusChanged(int processId, Process::Status status);
 
   private:
-    IProcessRepository& processRepository;
+    ProcessStatusWriter& statusWriter;
 
     Process process;
     QLabel* portLabel = nullptr;
@@ -54,9 +58,8 @@ class ProcessListItem : public QGroupBox
     QPushButton* editButton = nullptr;
     QPushButton* deleteButton = nullptr;
     QProcess* qProcess = nullptr;
-    QTimer* pollTimer = nullptr;
-    QTimer* monitorTimer = nullptr;
     bool isShuttingDown = false;
+    bool isStopping = false;
 };
 
 #endif // PROCESSLISTITEM_H
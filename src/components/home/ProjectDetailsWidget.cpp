@@ -1,9 +1,11 @@
 #include "ProjectDetailsWidget.h"
 
 #include "../../core/Logger.h"
+#include "../../core/ProcessReconciler.h"
 #include "../../core/ProjectLauncher.h"
 #include "../../styles/ButtonStyle.h"
 #include "../../styles/FontStyle.h"
+#include "../../windows/ProjectLogWindow.h"
 #include "../shared/FlowLayout.h"
 #include "NoteCard.h"
 #include "ProcessListItem.h"
@@ -23,6 +25,17 @@ ProjectDetailsWidget::ProjectDetailsWidget(RepositoryProvider& repoProvider, QWi
       processRepository(repoProvider.getProcessRepository()), noteRepository(repoProvider.getNoteRepository()),
       editorRepository(repoProvider.getEditorRepository()), settings("Dev", "Pilot")
 {
+    launchCoordinator = new LaunchCoordinator(
+        [this](int processId)
+        {
+            // The list may have been rebuilt for another project since the launch began
+            if (ProcessListItem* item = processItems.value(processId, nullptr))
+                item->startCommand();
+            else
+                launchCoordinator->markFailed(processId);
+        },
+        this);
+
     setupUI();
     setupConnections();
 }
@@ -126,6 +139,19 @@ void ProjectDetailsWidget::setupConnections()
     connect(openInIDEButton, &QPushButton::clicked, this, &ProjectDetailsWidget::onOpenInIDEClicked);
     connect(openAllAppsButton, &QPushButton::clicked, this, &ProjectDetailsWidget::onOpenAllAppsClicked);
     connect(addProcessButton, &QPushButton::clicked, this, &ProjectDetailsWidget::onAddProcessClicked);
+    connect(startAllProcessesButton, &QPushButton::clicked, this, &ProjectDetailsWidget::onStartAllProcessesClicked);
+    connect(projectLogsButton, &QPushButton::clicked, this, &ProjectDetailsWidget::onProjectLogsClicked);
+    connect(launchCoordinator, &LaunchCoordinator::processSkipped, this,
+            [](int processId)
+            {
+                LOG_WARNING_IN(Ui, "Skipped process ID " + QString::number(processId) + " because a dependency failed");
+            });
+    connect(launchCoordinator, &LaunchCoordinator::finished, this,
+            [this](bool success)
+            {
+                startAllProcessesButton->setEnabled(true);
+                LOG_INFO_IN(Ui, success ? "Started all processes" : "Started processes, some failed or were skipped");
+            });
     connect(toggleNotesBtn, &QToolButton::toggled, this, &ProjectDetailsWidget::onToggleNotesClicked);
     connect(addNoteButton, &QToolButton::clicked, this, &ProjectDetailsWidget::onAddNoteClicked);
 }
@@ -156,10 +182,27 @@ QHBoxLayout* ProjectDetailsWidget::createHeader()
     addProcessButton->setFixedSize(25, 25);
     addProcessButton->setStyleSheet(ButtonStyle::primary());
 
+    startAllProcessesButton = new QPushButton(QIcon(":/Images/Play"), "");
+    startAllProcessesButton->setFixedSize(25, 25);
+    startAllProcessesButton->setStyleSheet(ButtonStyle::primary());
+    startAllProcessesButton->setToolTip("Start all processes in dependency order");
+
+    projectLogsButton = new QPushButton("Logs");
+    projectLogsButton->setFixedHeight(25);
+    projectLogsButton->setStyleSheet(ButtonStyle::primary());
+    projectLogsButton->setToolTip("Output of all processes in one view, in the order it was received");
+
+    QHBoxLayout* processButtonsLayout = new QHBoxLayout();
+    processButtonsLayout->setSpacing(8);
+    processButtonsLayout->addWidget(addProcessButton);
+    processButtonsLayout->addWidget(startAllProcessesButton);
+    processButtonsLayout->addWidget(projectLogsButton);
+    processButtonsLayout->addStretch();
+
     QVBoxLayout* projectInfoLayout = new QVBoxLayout();
     projectInfoLayout->addLayout(titleLayout);
     projectInfoLayout->addWidget(projectPathLabel);
-    projectInfoLayout->addWidget(addProcessButton);
+    projectInfoLayout->addLayout(processButtonsLayout);
 
     openInFolderButton = new QPushButton(QIcon(":/Images/Folder"), "");
     openInFolderButton->setStyleSheet(ButtonStyle::primary());
@@ -206,11 +249,30 @@ void ProjectDetailsWidget::loadProject()
 
 void ProjectDetailsWidget::loadProjectProcesses(int projectId)
 {
-    currentProcesses = processRepository.findByProjectId(projectId);
-    refreshProcesses();
-
-    LOG_INFO("Loaded " + QString::number(currentProcesses.size()) +
-             " processes for project ID: " + QString::number(projectId));
+    // Status changes are written behind; read what the list items last reported, corrected for
+    // anything that started or died while nobody was watching. The list is built once the
+    // corrections are in, so no item starts following a stale PID.
+    repositoryProvider.getProcessStatusWriter().flush();
+    const quint64 generation = ++processLoadGeneration;
+    if (!currentProcesses.isEmpty() && currentProcesses.first().getProjectId() != projectId)
+    {
+        // The list of the previous project is not to be started meanwhile
+        currentProcesses.clear();
+        refreshProcesses();
+    }
+    ProcessReconciler::runAsync(processRepository, this,
+                                [this, projectId, generation](int)
+                                {
+                                    // Another project, or the same one again, is loading by now
+                                    if (generation != processLoadGeneration)
+                                        return;
+
+                                    currentProcesses = processRepository.findByProjectId(projectId);
+                                    refreshProcesses();
+
+                                    LOG_INFO_IN(Ui, "Loaded " + QString::number(currentProcesses.size()) +
+                                                " processes for project ID: " + QString::number(projectId));
+                                });
 }
 
 void ProjectDetailsWidget::loadProjectNotes(int projectId)
@@ -288,6 +350,14 @@ void ProjectDetailsWidget::refreshProject()
 
 void ProjectDetailsWidget::refreshProcesses()
 {
+    // The items of a launch in progress go away with the list and never report back
+    if (launchCoordinator->isLaunching())
+    {
+        launchCoordinator->cancel();
+        startAllProcessesButton->setEnabled(true);
+        LOG_INFO_IN(Ui, "Cancelled starting all processes, the process list was rebuilt");
+    }
+
     // Clear existing processes
     QLayoutItem* child;
     while ((child = processListLayout->takeAt(0)) != nullptr)
@@ -297,13 +367,24 @@ void ProjectDetailsWidget::refreshProcesses()
         delete child;
     }
 
+    processItems.clear();
+
     // Create process list items
     for (Process& process : currentProcesses)
     {
-        ProcessListItem* item = new ProcessListItem(process, repositoryProvider.getProcessRepository(), this);
+        ProcessListItem* item = new ProcessListItem(process, repositoryProvider.getProcessStatusWriter(), this);
+        processItems.insert(process.getId(), item);
 
         connect(item, &ProcessListItem::editRequested, this, &ProjectDetailsWidget::onEditProcessClicked);
         connect(item, &ProcessListItem::deleteRequested, this, &ProjectDetailsWidget::onDeleteProcessClicked);
+        connect(item, &ProcessListItem::statusChanged, this,
+                [this](int processId, Process::Status status)
+                {
+                    if (status == Process::Status::Running)
+                        launchCoordinator->markReady(processId);
+                    else if (status == Process::Status::Error || status == Process::Status::Stopped)
+                        launchCoordinator->markFailed(processId);
+                });
 
         processListLayout->addWidget(item);
     }
@@ -356,7 +437,7 @@ void ProjectDetailsWidget::onEditProjectClicked()
     QList<int> selectedAppIds = dialog.getSelectedAppIds();
     repositoryProvider.getAppRepository().setLinkedApps(savedProject->getId(), selectedAppIds);
 
-    LOG_INFO("Updated project: " + savedProject->getName());
+    LOG_INFO_IN(Ui, "Updated project: " + savedProject->getName());
 
     refreshProject();
 }
@@ -422,7 +503,7 @@ void ProjectDetailsWidget::onOpenAllAppsClicked()
 
         if (!QFile::exists(path))
         {
-            LOG_WARNING("App not found: " + path);
+            LOG_WARNING_IN(Ui, "App not found: " + path);
             continue;
         }
 
@@ -435,7 +516,7 @@ void ProjectDetailsWidget::onOpenAllAppsClicked()
         process->startDetached(); // Run independently
     }
 
-    LOG_INFO("Launched all enabled apps for project: " + currentProject.getName());
+    LOG_INFO_IN(Ui, "Launched all enabled apps for project: " + currentProject.getName());
 }
 
 void ProjectDetailsWidget::onAddProcessClicked()
@@ -458,10 +539,53 @@ void ProjectDetailsWidget::onAddProcessClicked()
         return;
     }
 
-    LOG_INFO("Created process: " + savedProcess->getName());
+    processRepository.setDependencies(savedProcess->getId(), dialog.getSelectedDependencyIds());
+
+    LOG_INFO_IN(Ui, "Created process: " + savedProcess->getName());
     loadProjectProcesses(currentProject.getId());
 }
 
+void ProjectDetailsWidget::onProjectLogsClicked()
+{
+    if (currentProcesses.isEmpty())
+        return;
+
+    ProjectLogWindow* window = new ProjectLogWindow(currentProject, currentProcesses);
+    window->setAttribute(Qt::WA_DeleteOnClose);
+    window->show();
+    window->raise();
+    window->activateWindow();
+}
+
+void ProjectDetailsWidget::onStartAllProcessesClicked()
+{
+    if (launchCoordinator->isLaunching() || processItems.isEmpty())
+    {
+        return;
+    }
+
+    QList<int> processIds;
+    QSet<int> runningIds;
+    for (ProcessListItem* item : std::as_const(processItems))
+    {
+        Process process = item->getProcess();
+        processIds.append(process.getId());
+        if (process.getStatus() == Process::Status::Running)
+            runningIds.insert(process.getId());
+    }
+
+    QHash<int, QList<int>> dependencies = processRepository.findDependenciesByProjectId(currentProject.getId());
+    if (!launchCoordinator->launch(processIds, dependencies, runningIds))
+    {
+        QMessageBox::warning(this, "Start All", "The process dependencies form a cycle. Edit the processes to fix it.");
+        return;
+    }
+
+    // Re-enabled by LaunchCoordinator::finished, unless everything was already running
+    startAllProcessesButton->setEnabled(!launchCoordinator->isLaunching());
+    LOG_INFO_IN(Ui, "Starting all processes for project: " + currentProject.getName());
+}
+
 void ProjectDetailsWidget::onEditProcessClicked(const Process& process)
 {
     ProcessDialog dialog(process, repositoryProvider, currentProject, this);
@@ -473,7 +597,8 @@ void ProjectDetailsWidget::onEditProcessClicked(const Process& process)
         std::optional<Process> savedProcess = processRepository.save(updatedProcess);
         if (savedProcess.has_value())
         {
-            LOG_INFO("Updated process: " + savedProcess->getName());
+            processRepository.setDependencies(savedProcess->getId(), dialog.getSelectedDependencyIds());
+            LOG_INFO_IN(Ui, "Updated process: " + savedProcess->getName());
             loadProjectProcesses(currentProject.getId());
         }
     }
@@ -489,7 +614,7 @@ void ProjectDetailsWidget::onDeleteProcessClicked(const Process& process)
     {
         if (processRepository.deleteById(process.getId()))
         {
-            LOG_INFO("Deleted process: " + process.getName());
+            LOG_INFO_IN(Ui, "Deleted process: " + process.getName());
             loadProjectProcesses(currentProject.getId());
         }
         else
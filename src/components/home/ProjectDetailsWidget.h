@@ -1,6 +1,7 @@
 #ifndef PROJECTDETAILSWIDGET_H
 #define PROJECTDETAILSWIDGET_H
 
+#include "../../core/LaunchCoordinator.h"
 #include "../../models/Note.h"
 #include "../../models/Project.h"
 #include "../../repositories/RepositoryProvider.h"
@@ -9,6 +10,7 @@
 #include "../../repositories/interfaces/IProcessRepository.h"
 #include "../../repositories/interfaces/IProjectRepository.h"
 #include <QGridLayout>
+#include <QHash>
 #include <QLabel>
 #include <QList>
 #include <QPushButton>
@@ -17,6 +19,8 @@
 #include <QWidget>
 #include <QSettings>
 
+class ProcessListItem;
+
 class ProjectDetailsWidget : public QWidget
 {
     Q_OBJECT
@@ -47,6 +51,8 @@ class ProjectDetailsWidget : public QWidget
     void onOpenInIDEClicked();
     void onOpenAllAppsClicked();
     void onAddProcessClicked();
+    void onStartAllProcessesClicked();
+    void onProjectLogsClicked();
     void onToggleNotesClicked(bool checked);
     void onEditProcessClicked(const Process& process);
     void onDeleteProcessClicked(const Process& process);
@@ -60,6 +66,10 @@ class ProjectDetailsWidget : public QWidget
 
     Project currentProject;
     QList<Process> currentProcesses;
+    QHash<int, ProcessListItem*> processItems;
+    // Drops the reconciled list of a load that a later one overtook
+    quint64 processLoadGeneration = 0;
+    LaunchCoordinator* launchCoordinator = nullptr;
 
     QLabel* projectNameLabel = nullptr;
     QLabel* projectPathLabel = nullptr;
@@ -76,6 +86,7 @@ class ProjectDetailsWidget : public QWidget
     QScrollArea* notesScrollArea = nullptr;
     QPushButton* addProcessButton = nullptr;
     QPushButton* startAllProcessesButton = nullptr;
+    QPushButton* projectLogsButton = nullptr;
     QPushButton* stopAllProcessesButton = nullptr;
     QVBoxLayout* processListLayout = nullptr;
     QToolButton* addNoteButton = nullptr;
@@ -101,7 +101,7 @@ void SidebarWidget::onAddProjectClicked()
         return;
     }
 
-    LOG_INFO("Created project: " + savedProject->getName());
+    LOG_INFO_IN(Ui, "Created project: " + savedProject->getName());
     refreshProjectList();
 }
 
@@ -0,0 +1,580 @@
+#include "LogView.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QDesktopServices>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QUrl>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    constexpr int Margin = 8;
+    const QColor LinkColor("#1E90FF");
+
+    QByteArray withoutLineEnd(QByteArray text)
+    {
+        if (text.endsWith('\n'))
+            text.chop(1);
+        if (text.endsWith('\r'))
+            text.chop(1);
+        return text;
+    }
+
+    QString displayText(const QString& text)
+    {
+        QString display = text;
+        display.replace('\t', "    ");
+        return display;
+    }
+
+    QFont spanFont(const QFont& base, const AnsiStyle& style)
+    {
+        QFont font = base;
+        font.setBold(style.bold);
+        font.setItalic(style.italic);
+        return font;
+    }
+}
+
+LogView::LogView(QWidget* parent) : QAbstractScrollArea(parent), backgroundColor("#1e1e1e"), foregroundColor("#d4d4d4")
+{
+    QFont monospace("Consolas");
+    monospace.setStyleHint(QFont::Monospace);
+    monospace.setPointSize(9);
+    setFont(monospace);
+
+    viewport()->setMouseTracking(true);
+    viewport()->setCursor(Qt::IBeamCursor);
+    setFocusPolicy(Qt::StrongFocus);
+
+    indexTimer = new QTimer(this);
+    indexTimer->setInterval(0);
+    connect(indexTimer, &QTimer::timeout, this, &LogView::indexSlice);
+
+    olderTimer = new QTimer(this);
+    olderTimer->setInterval(0);
+    olderTimer->setSingleShot(true);
+    connect(olderTimer, &QTimer::timeout, this, &LogView::indexOlderSlice);
+}
+
+void LogView::setDocument(LogDocument* document)
+{
+    this->document = document;
+    pendingOffset = -1;
+    liveLines.clear();
+    widestRow = 0;
+    refreshDocument();
+}
+
+void LogView::setMergedLog(MergedLog* merged)
+{
+    mergedLog = merged;
+    pendingOffset = -1;
+    liveLines.clear();
+    filterOffsets.clear();
+    filtered = false;
+    selectionAnchor = selectionEnd = -1;
+    widestRow = 0;
+    updateScrollBars(true);
+    refreshDocument();
+}
+
+void LogView::refreshDocument()
+{
+    if (mergedLog)
+    {
+        indexSlice();
+        return;
+    }
+    if (!document)
+        return;
+
+    document->refresh();
+    indexSlice();
+}
+
+void LogView::appendLiveLines(const QList<LogLine>& lines)
+{
+    const bool followTail = isAtBottom();
+
+    for (const LogLine& line : lines)
+    {
+        if (document && line.fileOffset < document->indexedEnd())
+            continue;
+        liveLines.append(line);
+    }
+
+    // Anything dropped here is in the document by the next refresh
+    if (liveLines.size() > LiveLineLimit)
+        liveLines.remove(0, liveLines.size() - LiveLineLimit);
+
+    updateScrollBars(followTail);
+    viewport()->update();
+}
+
+void LogView::clearLiveLines()
+{
+    liveLines.clear();
+    selectionAnchor = selectionEnd = -1;
+    widestRow = 0;
+    updateScrollBars(true);
+    viewport()->update();
+}
+
+void LogView::setColors(const QColor& background, const QColor& foreground)
+{
+    backgroundColor = background;
+    foregroundColor = foreground;
+    viewport()->update();
+}
+
+void LogView::setFilter(const QList<qint64>& lineOffsets)
+{
+    // Rows change meaning, a selection would point at other lines
+    const bool followTail = !filtered || isAtBottom();
+    filterOffsets = lineOffsets;
+    filtered = true;
+    pendingOffset = -1;
+    selectionAnchor = selectionEnd = -1;
+    updateScrollBars(followTail);
+    viewport()->update();
+}
+
+void LogView::appendFilter(const QList<qint64>& lineOffsets)
+{
+    if (!filtered)
+    {
+        setFilter(lineOffsets);
+        return;
+    }
+
+    const bool followTail = isAtBottom();
+    filterOffsets.append(lineOffsets);
+    updateScrollBars(followTail);
+    viewport()->update();
+}
+
+void LogView::clearFilter()
+{
+    if (!filtered)
+        return;
+
+    filterOffsets.clear();
+    filtered = false;
+    selectionAnchor = selectionEnd = -1;
+    updateScrollBars(true);
+    viewport()->update();
+}
+
+bool LogView::isFiltered() const
+{
+    return filtered;
+}
+
+bool LogView::scrollToOffset(qint64 offset)
+{
+    if (!document)
+        return false;
+
+    if (filtered)
+    {
+        const qint64 row = std::upper_bound(filterOffsets.begin(), filterOffsets.end(), offset) -
+                           filterOffsets.begin() - 1;
+        if (row < 0)
+            return false;
+
+        selectionAnchor = selectionEnd = row;
+        const qint64 top = qMax<qint64>(row - verticalScrollBar()->pageStep() / 2, 0);
+        verticalScrollBar()->setValue(static_cast<int>(qMin<qint64>(top, verticalScrollBar()->maximum())));
+        viewport()->update();
+        return true;
+    }
+
+    // Older output is indexed towards the row in slices, see indexOlderSlice()
+    pendingOffset = -1;
+    if (offset < document->startOffset() && document->hasOlder())
+    {
+        if (offset < document->logStartOffset())
+            return false;
+
+        pendingOffset = offset;
+        olderTimer->start();
+        return true;
+    }
+    return showOffset(offset);
+}
+
+qint64 LogView::rowCount() const
+{
+    if (mergedLog)
+        return mergedLog->rowCount();
+    if (filtered)
+        return filterOffsets.size();
+
+    const qint64 documentRows = document ? document->lineCount() : 0;
+    return documentRows + liveLines.size() + (hasPartialRow() ? 1 : 0);
+}
+
+QList<QByteArray> LogView::rows(qint64 first, int count, AnsiStyle* style) const
+{
+    if (mergedLog)
+    {
+        // Each row starts with the reset after its tag
+        if (style)
+            *style = AnsiStyle();
+        QList<QByteArray> result;
+        for (qint64 row = qMax<qint64>(first, 0); row < mergedLog->rowCount() && result.size() < count; ++row)
+            result.append(mergedLog->rowText(row));
+        return result;
+    }
+
+    if (filtered)
+    {
+        // Filtered lines are far apart; each starts from the default style
+        if (style)
+            *style = AnsiStyle();
+        QList<QByteArray> result;
+        for (qint64 row = qMax<qint64>(first, 0); row < filterOffsets.size() && result.size() < count; ++row)
+            result.append(document ? document->lineFrom(filterOffsets.at(row)) : QByteArray());
+        return result;
+    }
+
+    const qint64 documentRows = document ? document->lineCount() : 0;
+    QList<QByteArray> result;
+    if (first < documentRows)
+        result = document->lines(first, count, style);
+
+    qint64 liveIndex = qMax<qint64>(first + result.size() - documentRows, 0);
+    if (style && first >= documentRows)
+    {
+        AnsiParser parser(document ? document->endStyle() : AnsiStyle());
+        for (qint64 skipped = 0; skipped < liveIndex && skipped < liveLines.size(); ++skipped)
+            parser.skip(liveLines.at(skipped).text.constData(), liveLines.at(skipped).text.size());
+        *style = parser.style();
+    }
+
+    for (; result.size() < count && liveIndex < liveLines.size(); ++liveIndex)
+        result.append(withoutLineEnd(liveLines.at(liveIndex).text));
+
+    if (result.size() < count && liveIndex == 0 && hasPartialRow())
+        result.append(withoutLineEnd(document->bytes(document->indexedEnd(), document->endOffset())));
+
+    return result;
+}
+
+QString LogView::selectedText() const
+{
+    if (selectionAnchor < 0)
+        return QString();
+
+    const qint64 first = qMin(selectionAnchor, selectionEnd);
+    const qint64 last = qMax(selectionAnchor, selectionEnd);
+    QStringList lines;
+    const int count = static_cast<int>(qMin<qint64>(last - first + 1, std::numeric_limits<int>::max()));
+    for (const QByteArray& row : rows(first, count))
+        lines.append(AnsiParser::plainText(row));
+    return lines.join('\n');
+}
+
+void LogView::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(viewport());
+    painter.fillRect(viewport()->rect(), backgroundColor);
+
+    const QFontMetrics metrics(font());
+    const int lineHeight = metrics.height();
+    const qint64 first = verticalScrollBar()->value();
+    const int visibleRows = viewport()->height() / lineHeight + 1;
+    const int left = Margin - horizontalScrollBar()->value();
+    const qint64 selectionFirst = qMin(selectionAnchor, selectionEnd);
+    const qint64 selectionLast = qMax(selectionAnchor, selectionEnd);
+
+    int widest = widestRow;
+    AnsiStyle style;
+    const QList<QByteArray> visible = rows(first, visibleRows, &style);
+    AnsiParser parser(style);
+    for (int i = 0; i < visible.size(); ++i)
+    {
+        const int top = i * lineHeight;
+        if (selectionAnchor >= 0 && first + i >= selectionFirst && first + i <= selectionLast)
+            painter.fillRect(0, top, viewport()->width(), lineHeight, palette().color(QPalette::Highlight));
+
+        // Only the style carries over, and not between filtered or merged rows; a sequence cut off at the
+        // end of a row is dropped
+        parser.reset(filtered || mergedLog ? AnsiStyle() : parser.style());
+        int x = left;
+        for (const AnsiSpan& span : parser.feed(visible.at(i)))
+        {
+            const QFont font = spanFont(this->font(), span.style);
+            const QString text = displayText(span.text);
+            const int width = QFontMetrics(font).horizontalAdvance(text);
+
+            if (x + width > 0 && x < viewport()->width())
+            {
+                if (span.style.background.isValid())
+                    painter.fillRect(x, top, width, lineHeight, span.style.background);
+
+                QColor color = span.style.foreground.isValid() ? span.style.foreground : foregroundColor;
+                if (!span.link.isEmpty())
+                    color = LinkColor;
+
+                painter.setFont(font);
+                painter.setPen(color);
+                painter.drawText(x, top + metrics.ascent(), text);
+                if (!span.link.isEmpty() || span.style.underline)
+                    painter.drawLine(x, top + metrics.ascent() + 1, x + width, top + metrics.ascent() + 1);
+            }
+            x += width;
+        }
+        widest = qMax(widest, x - left);
+    }
+
+    // The horizontal range grows with the widest row seen so far; measuring every row would defeat the point
+    if (widest > widestRow)
+    {
+        widestRow = widest;
+        updateScrollBars(false);
+    }
+}
+
+void LogView::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars(isAtBottom());
+}
+
+void LogView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx)
+    Q_UNUSED(dy)
+    viewport()->update();
+
+    if (hasOlder() && verticalScrollBar()->value() < OlderRowsMargin)
+        olderTimer->start();
+}
+
+void LogView::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton)
+        return;
+
+    const QString link = linkAt(event->position().toPoint());
+    if (!link.isEmpty())
+    {
+        QDesktopServices::openUrl(QUrl(link));
+        return;
+    }
+
+    const qint64 row = rowAt(event->position().toPoint().y());
+    if (!(event->modifiers() & Qt::ShiftModifier) || selectionAnchor < 0)
+        selectionAnchor = row;
+    selectionEnd = row;
+    viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent* event)
+{
+    const QPoint position = event->position().toPoint();
+
+    if (event->buttons() & Qt::LeftButton && selectionAnchor >= 0)
+    {
+        selectionEnd = rowAt(position.y());
+        viewport()->update();
+        return;
+    }
+
+    viewport()->setCursor(linkAt(position).isEmpty() ? Qt::IBeamCursor : Qt::PointingHandCursor);
+}
+
+void LogView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy))
+    {
+        QApplication::clipboard()->setText(selectedText());
+        return;
+    }
+
+    if (event->matches(QKeySequence::SelectAll))
+    {
+        selectionAnchor = 0;
+        selectionEnd = rowCount() - 1;
+        viewport()->update();
+        return;
+    }
+
+    if (event->key() == Qt::Key_End)
+    {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+        return;
+    }
+
+    if (event->key() == Qt::Key_Home)
+    {
+        verticalScrollBar()->setValue(0);
+        return;
+    }
+
+    QAbstractScrollArea::keyPressEvent(event);
+}
+
+void LogView::indexSlice()
+{
+    if (!document && !mergedLog)
+        return;
+
+    const bool followTail = isAtBottom();
+    const bool more = mergedLog ? mergedLog->refresh() : document->indexMore();
+    if (!mergedLog)
+        pruneLiveLines();
+
+    // Following the tail, the oldest merged rows go; scrolling back up merges them again
+    const qint64 dropped = mergedLog && followTail ? mergedLog->dropOldest() : 0;
+    if (dropped > 0 && qMin(selectionAnchor, selectionEnd) < dropped)
+    {
+        selectionAnchor = selectionEnd = -1;
+    }
+    else if (dropped > 0)
+    {
+        selectionAnchor -= dropped;
+        selectionEnd -= dropped;
+    }
+    updateScrollBars(followTail);
+    viewport()->update();
+
+    if (more && !indexTimer->isActive())
+        indexTimer->start();
+    else if (!more)
+        indexTimer->stop();
+
+    // A tail shorter than the margin leaves the view near the top without any scrolling
+    if (hasOlder() && verticalScrollBar()->value() < OlderRowsMargin)
+        olderTimer->start();
+}
+
+void LogView::indexOlderSlice()
+{
+    // Older lines shift the rows of the document, not those of a filter. A pending jump indexes
+    // towards its row wherever the view is scrolled.
+    const bool jumping = pendingOffset >= 0 && document;
+    if (!filtered && hasOlder() && (jumping || verticalScrollBar()->value() < OlderRowsMargin))
+    {
+        const bool followTail = isAtBottom();
+        const qint64 added = mergedLog ? mergedLog->mergeOlder() : document->indexOlder();
+        if (selectionAnchor >= 0)
+        {
+            selectionAnchor += added;
+            selectionEnd += added;
+        }
+
+        // Rows shift down by as many as were added above, so the same output stays on screen
+        const int value = verticalScrollBar()->value();
+        updateScrollBars(followTail);
+        if (!followTail)
+            verticalScrollBar()->setValue(
+                static_cast<int>(qMin<qint64>(value + added, verticalScrollBar()->maximum())));
+        viewport()->update();
+    }
+
+    if (jumping && (pendingOffset >= document->startOffset() || !document->hasOlder()))
+    {
+        const qint64 offset = pendingOffset;
+        pendingOffset = -1;
+        showOffset(offset);
+    }
+    else if (hasOlder() && (jumping || verticalScrollBar()->value() < OlderRowsMargin))
+    {
+        olderTimer->start();
+    }
+}
+
+bool LogView::showOffset(qint64 offset)
+{
+    qint64 row = document->lineAt(offset);
+    for (qsizetype i = 0; row < 0 && i < liveLines.size(); ++i)
+    {
+        const LogLine& line = liveLines.at(i);
+        if (offset >= line.fileOffset && offset < line.fileOffset + line.text.size())
+            row = document->lineCount() + i;
+    }
+    if (row < 0)
+        return false;
+
+    selectionAnchor = selectionEnd = row;
+    updateScrollBars(false);
+    const qint64 top = qMax<qint64>(row - verticalScrollBar()->pageStep() / 2, 0);
+    verticalScrollBar()->setValue(static_cast<int>(qMin<qint64>(top, verticalScrollBar()->maximum())));
+    viewport()->update();
+    return true;
+}
+
+void LogView::pruneLiveLines()
+{
+    qsizetype indexed = 0;
+    while (indexed < liveLines.size() && liveLines.at(indexed).fileOffset < document->indexedEnd())
+        ++indexed;
+    liveLines.remove(0, indexed);
+}
+
+void LogView::updateScrollBars(bool followTail)
+{
+    const int lineHeight = QFontMetrics(font()).height();
+    const int pageRows = qMax(viewport()->height() / lineHeight, 1);
+    const qint64 maximum = qMax<qint64>(rowCount() - pageRows, 0);
+
+    verticalScrollBar()->setRange(0, static_cast<int>(qMin<qint64>(maximum, std::numeric_limits<int>::max())));
+    verticalScrollBar()->setPageStep(pageRows);
+    verticalScrollBar()->setSingleStep(1);
+    horizontalScrollBar()->setRange(0, qMax(widestRow + 2 * Margin - viewport()->width(), 0));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+
+    if (followTail)
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+bool LogView::isAtBottom() const
+{
+    return verticalScrollBar()->value() == verticalScrollBar()->maximum();
+}
+
+bool LogView::hasPartialRow() const
+{
+    return document && !filtered && liveLines.isEmpty() && !document->isIndexing() &&
+           document->endOffset() > document->indexedEnd();
+}
+
+bool LogView::hasOlder() const
+{
+    if (mergedLog)
+        return mergedLog->hasOlder();
+    return document && document->hasOlder();
+}
+
+qint64 LogView::rowAt(int y) const
+{
+    const int lineHeight = QFontMetrics(font()).height();
+    return qMin(verticalScrollBar()->value() + qMax(y, 0) / lineHeight, qMax<qint64>(rowCount() - 1, 0));
+}
+
+QString LogView::linkAt(const QPoint& position) const
+{
+    const qint64 rowIndex = verticalScrollBar()->value() + position.y() / QFontMetrics(font()).height();
+    const QList<QByteArray> row = rows(rowIndex, 1);
+    if (position.y() < 0 || row.isEmpty())
+        return QString();
+
+    int x = Margin - horizontalScrollBar()->value();
+    for (const AnsiSpan& span : AnsiParser::parseLine(row.first()))
+    {
+        const int width = QFontMetrics(spanFont(font(), span.style)).horizontalAdvance(displayText(span.text));
+        if (position.x() >= x && position.x() < x + width)
+            return span.link;
+        x += width;
+    }
+    return QString();
+}
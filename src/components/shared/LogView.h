@@ -0,0 +1,96 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include "../../core/AnsiParser.h"
+#include "../../core/LogDocument.h"
+#include "../../core/LogLineRing.h"
+#include "../../core/MergedLog.h"
+#include <QAbstractScrollArea>
+#include <QColor>
+#include <QTimer>
+
+// Scrollable view of a process log that lays out only the rows on screen. Older output comes from a
+// memory mapped LogDocument, output the document has not indexed yet from live lines of the log
+// stream. Rows are parsed for ANSI colors when painted, continuing the style of the rows above;
+// memory stays flat however long the log is. The view opens on the tail of the document and indexes
+// older output only while the user scrolls near the top. A filter narrows the rows down to a list of
+// lines, like the errors found by a LogRecordIndex, read from the document by offset. Instead of a
+// document the view can show a MergedLog of several processes, merged further back the same way.
+class LogView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+  public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    // The document is not owned. Indexing runs in slices on the event loop.
+    void setDocument(LogDocument* document);
+    // Shows merged instead of the document until it is set back to nullptr; not owned
+    void setMergedLog(MergedLog* merged);
+    // Picks up output written to the document, or the merged logs, since the last refresh
+    void refreshDocument();
+
+    void appendLiveLines(const QList<LogLine>& lines);
+    void clearLiveLines();
+
+    void setColors(const QColor& background, const QColor& foreground);
+
+    // Shows only the lines starting at lineOffsets, oldest first, until clearFilter(); live lines are hidden
+    void setFilter(const QList<qint64>& lineOffsets);
+    // Adds lines found since, after the ones shown; a view following the tail keeps following it
+    void appendFilter(const QList<qint64>& lineOffsets);
+    void clearFilter();
+    bool isFiltered() const;
+
+    // Scrolls the row containing offset into the middle of the view and selects it; false if no row
+    // contains offset. A row before the indexed ones is shown once older output has been indexed up to
+    // it, in slices on the event loop. While filtered, the last row starting at or before offset.
+    bool scrollToOffset(qint64 offset);
+
+    qint64 rowCount() const;
+    // style receives the ANSI style in effect at the start of the first row
+    QList<QByteArray> rows(qint64 first, int count, AnsiStyle* style = nullptr) const;
+    QString selectedText() const;
+
+    static constexpr int LiveLineLimit = LogLineRing::LineCapacity;
+    // Older output is indexed while fewer rows than this are above the first visible one
+    static constexpr int OlderRowsMargin = 1000;
+
+  protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+
+  private:
+    void indexSlice();
+    void indexOlderSlice();
+    // Selects and centers the indexed or live row containing offset
+    bool showOffset(qint64 offset);
+    void pruneLiveLines();
+    void updateScrollBars(bool followTail);
+    bool isAtBottom() const;
+    bool hasPartialRow() const;
+    bool hasOlder() const;
+    qint64 rowAt(int y) const;
+    QString linkAt(const QPoint& position) const;
+
+    LogDocument* document = nullptr;
+    MergedLog* mergedLog = nullptr;
+    QList<LogLine> liveLines;
+    QList<qint64> filterOffsets;
+    bool filtered = false;
+    // Offset scrollToOffset() is indexing older output towards, or -1
+    qint64 pendingOffset = -1;
+    QTimer* indexTimer = nullptr;
+    QTimer* olderTimer = nullptr;
+    QColor backgroundColor;
+    QColor foregroundColor;
+    qint64 selectionAnchor = -1;
+    qint64 selectionEnd = -1;
+    int widestRow = 0;
+};
+
+#endif // LOGVIEW_H
@@ -0,0 +1,88 @@
+#include "Sparkline.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+
+Sparkline::Sparkline(const QString& caption, QWidget* parent) : QWidget(parent), caption(caption)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+void Sparkline::setValues(const QList<double>& values, const QString& valueText)
+{
+    this->values = values;
+    this->valueText = valueText;
+    update();
+}
+
+void Sparkline::setCeiling(double ceiling)
+{
+    this->ceiling = ceiling;
+    update();
+}
+
+void Sparkline::clear()
+{
+    values.clear();
+    valueText = "--";
+    update();
+}
+
+QSize Sparkline::sizeHint() const
+{
+    return QSize(180, 56);
+}
+
+QSize Sparkline::minimumSizeHint() const
+{
+    return QSize(100, 56);
+}
+
+void Sparkline::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    const QColor textColor = palette().color(QPalette::WindowText);
+    const QColor lineColor = palette().color(QPalette::Highlight);
+
+    QFontMetrics metrics(font());
+    const int textHeight = metrics.height();
+
+    painter.setPen(textColor);
+    painter.drawText(QRect(0, 0, width(), textHeight), Qt::AlignLeft | Qt::AlignVCenter, caption);
+    painter.drawText(QRect(0, 0, width(), textHeight), Qt::AlignRight | Qt::AlignVCenter, valueText);
+
+    const QRectF chart(0, textHeight + 4, width() - 1, height() - textHeight - 5);
+    if (values.size() < 2 || chart.height() <= 0)
+        return;
+
+    double maximum = std::max(ceiling, *std::max_element(values.cbegin(), values.cend()));
+    if (maximum <= 0.0)
+        maximum = 1.0;
+
+    const double step = chart.width() / (values.size() - 1);
+    QPainterPath line;
+    for (int i = 0; i < values.size(); ++i)
+    {
+        QPointF point(chart.left() + i * step, chart.bottom() - values[i] / maximum * chart.height());
+        if (i == 0)
+            line.moveTo(point);
+        else
+            line.lineTo(point);
+    }
+
+    QPainterPath area = line;
+    area.lineTo(chart.right(), chart.bottom());
+    area.lineTo(chart.left(), chart.bottom());
+    area.closeSubpath();
+
+    QColor fillColor = lineColor;
+    fillColor.setAlpha(50);
+    painter.fillPath(area, fillColor);
+
+    painter.setPen(QPen(lineColor, 1.5));
+    painter.drawPath(line);
+}
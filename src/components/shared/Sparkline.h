@@ -0,0 +1,35 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <QList>
+#include <QString>
+#include <QWidget>
+
+// Caption, current value and a small line chart of recent values. Paints directly with QPainter,
+// so updating it once per second costs next to nothing.
+class Sparkline : public QWidget
+{
+    Q_OBJECT
+
+  public:
+    explicit Sparkline(const QString& caption, QWidget* parent = nullptr);
+
+    // Values are scaled between zero and their maximum, or ceiling if that is larger
+    void setValues(const QList<double>& values, const QString& valueText);
+    void setCeiling(double ceiling);
+    void clear();
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+  protected:
+    void paintEvent(QPaintEvent* event) override;
+
+  private:
+    QString caption;
+    QString valueText = "--";
+    QList<double> values;
+    double ceiling = 0.0;
+};
+
+#endif // SPARKLINE_H
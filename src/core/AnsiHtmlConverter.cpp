@@ -1,105 +1,50 @@
 #include "AnsiHtmlConverter.h"
-#include <QRegularExpression>
 
-QMap<QString, QString> AnsiHtmlConverter::foregroundColors()
+namespace
 {
-    return {{"30", "black"},     {"31", "red"},        {"32", "green"},      {"33", "yellow"},
-            {"34", "blue"},      {"35", "magenta"},    {"36", "cyan"},       {"37", "white"},
-            {"90", "gray"},      {"91", "lightcoral"}, {"92", "lightgreen"}, {"93", "lightyellow"},
-            {"94", "lightblue"}, {"95", "violet"},     {"96", "cyan"},       {"97", "white"}};
+    QString styleAttribute(const AnsiStyle& style)
+    {
+        QString css;
+        if (style.foreground.isValid())
+            css += "color:" + style.foreground.name() + ";";
+        if (style.background.isValid())
+            css += "background-color:" + style.background.name() + ";";
+        if (style.bold)
+            css += "font-weight:bold;";
+        if (style.italic)
+            css += "font-style:italic;";
+        if (style.underline)
+            css += "text-decoration:underline;";
+        return css;
+    }
 }
 
-QMap<QString, QString> AnsiHtmlConverter::backgroundColors()
+QString AnsiHtmlConverter::convert(const QByteArray& chunk)
 {
-    return {{"40", "black"}, {"41", "red"},     {"42", "green"}, {"43", "yellow"},
-            {"44", "blue"},  {"45", "magenta"}, {"46", "cyan"},  {"47", "white"}};
+    return toHtml(parser.feed(chunk));
 }
 
 QString AnsiHtmlConverter::toHtml(const QString& text)
 {
-    QString html = text;
-
-    // 1. First, escape HTML entities
-    html.replace("&", "&amp;");
-    html.replace("<", "&lt;");
-    html.replace(">", "&gt;");
-
-    // 2. Apply ANSI color codes FIRST
-    QRegularExpression ansiRegex("\x1B\\[([0-9;]+)m");
-    int offset = 0;
-    QString result;
-    int lastPos = 0;
-
-    QMap<QString, QString> fg = foregroundColors();
-    QMap<QString, QString> bg = backgroundColors();
-
-    bool inSpan = false;
+    return toHtml(AnsiParser::parseLine(text.toUtf8()));
+}
 
-    while (true)
+QString AnsiHtmlConverter::toHtml(const QList<AnsiSpan>& spans)
+{
+    QString html;
+    for (const AnsiSpan& span : spans)
     {
-        QRegularExpressionMatch match = ansiRegex.match(html, offset);
-        if (!match.hasMatch())
-        {
-            break;
-        }
-
-        int matchStart = match.capturedStart();
-        int matchEnd = match.capturedEnd();
-
-        result += html.mid(lastPos, matchStart - lastPos);
+        QString text = span.text.toHtmlEscaped();
+        text.replace('\n', QLatin1String("<br>"));
 
-        QStringList codes = match.captured(1).split(';');
-        QString style;
-
-        for (const QString& code : codes)
-        {
-            if (code == "0")
-            {
-                if (inSpan)
-                {
-                    result += "</span>";
-                    inSpan = false;
-                }
-                style = "";
-                break;
-            }
-            if (fg.contains(code))
-                style += "color:" + fg[code] + ";";
-            if (bg.contains(code))
-                style += "background-color:" + bg[code] + ";";
-            if (code == "1")
-                style += "font-weight:bold;";
-            if (code == "3")
-                style += "font-style:italic;";
-        }
-
-        if (!style.isEmpty())
+        if (!span.link.isEmpty())
         {
-            if (inSpan)
-            {
-                result += "</span>";
-            }
-            result += "<span style=\"" + style + "\">";
-            inSpan = true;
+            text = "<a href=\"" + span.link.toHtmlEscaped() +
+                   "\" style=\"color: #1E90FF; text-decoration: underline;\">" + text + "</a>";
         }
 
-        lastPos = matchEnd;
-        offset = matchEnd;
+        const QString css = styleAttribute(span.style);
+        html += css.isEmpty() ? text : "<span style=\"" + css + "\">" + text + "</span>";
     }
-
-    result += html.mid(lastPos);
-
-    if (inSpan)
-    {
-        result += "</span>";
-    }
-
-    // 3. Now detect and linkify URLs
-    QRegularExpression urlRegex(R"(\b(https?://[^\s&lt;&gt;&quot;]+))");
-    result.replace(urlRegex, R"(<a href="\1" style="color: #1E90FF; text-decoration: underline;">\1</a>)");
-
-    // 4. Finally convert newlines
-    result.replace("\n", "<br>");
-
-    return result;
+    return html;
 }
@@ -1,17 +1,23 @@
 #ifndef ANSIHTMLCONVERTER_H
 #define ANSIHTMLCONVERTER_H
 
-#include <QMap>
+#include "AnsiParser.h"
+#include <QByteArray>
 #include <QString>
 
+// Turns terminal output into HTML for rich text widgets. A converter instance keeps the ANSI state
+// between chunks, so colors carry over from one chunk or line to the next; toHtml() converts a
+// single piece of text on its own.
 class AnsiHtmlConverter
 {
   public:
+    QString convert(const QByteArray& chunk);
+
     static QString toHtml(const QString& text);
+    static QString toHtml(const QList<AnsiSpan>& spans);
 
   private:
-    static QMap<QString, QString> foregroundColors();
-    static QMap<QString, QString> backgroundColors();
+    AnsiParser parser;
 };
 
 #endif // ANSIHTMLCONVERTER_H
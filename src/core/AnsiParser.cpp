@@ -0,0 +1,244 @@
+#include "AnsiParser.h"
+#include <cstring>
+
+namespace
+{
+    constexpr qsizetype MaxEscapeLength = 64;
+
+    // Length of the escape sequence starting at data[0] == ESC, or 0 if it is cut off
+    qsizetype escapeLength(const char* data, qsizetype size)
+    {
+        if (size < 2)
+            return 0;
+        if (data[1] != '[')
+            return 2;
+
+        for (qsizetype i = 2; i < size; ++i)
+        {
+            const uchar c = static_cast<uchar>(data[i]);
+            if (c >= 0x40 && c <= 0x7e)
+                return i + 1;
+            if (c < 0x20 || c > 0x3f)
+                return i;
+        }
+        return 0;
+    }
+
+    bool isLinkStart(const QString& text, qsizetype position)
+    {
+        const QStringView rest = QStringView(text).mid(position);
+        return rest.startsWith(u"https://") || rest.startsWith(u"http://");
+    }
+
+    qsizetype linkEnd(const QString& text, qsizetype start)
+    {
+        qsizetype end = start;
+        while (end < text.size() && !text.at(end).isSpace() && text.at(end) != '<' && text.at(end) != '>' &&
+               text.at(end) != '"')
+            ++end;
+        return end;
+    }
+
+    // Reads the color that follows 38 or 48 and advances index past it
+    QColor extendedColor(const QList<int>& codes, qsizetype& index)
+    {
+        if (index + 2 < codes.size() && codes.at(index + 1) == 5)
+        {
+            index += 2;
+            return AnsiParser::paletteColor(codes.at(index));
+        }
+        if (index + 4 < codes.size() && codes.at(index + 1) == 2)
+        {
+            index += 4;
+            return QColor(qBound(0, codes.at(index - 2), 255), qBound(0, codes.at(index - 1), 255),
+                          qBound(0, codes.at(index), 255));
+        }
+        index = codes.size();
+        return QColor();
+    }
+}
+
+AnsiParser::AnsiParser(const AnsiStyle& style) : current(style)
+{
+}
+
+QList<AnsiSpan> AnsiParser::feed(const char* data, qsizetype size)
+{
+    QList<AnsiSpan> spans;
+    parse(data, size,
+          [&](const char* text, qsizetype length)
+          { appendText(spans, decoder.decode(QByteArrayView(text, length)), current); });
+    return spans;
+}
+
+QList<AnsiSpan> AnsiParser::feed(const QByteArray& data)
+{
+    return feed(data.constData(), data.size());
+}
+
+void AnsiParser::skip(const char* data, qsizetype size)
+{
+    parse(data, size, [](const char*, qsizetype) {});
+}
+
+const AnsiStyle& AnsiParser::style() const
+{
+    return current;
+}
+
+void AnsiParser::reset(const AnsiStyle& style)
+{
+    current = style;
+    pending.clear();
+    decoder.resetState();
+}
+
+QList<AnsiSpan> AnsiParser::parseLine(const QByteArray& line, const AnsiStyle& style)
+{
+    AnsiParser parser(style);
+    return parser.feed(line);
+}
+
+QString AnsiParser::plainText(const QByteArray& line)
+{
+    QString text;
+    for (const AnsiSpan& span : parseLine(line))
+        text += span.text;
+    return text;
+}
+
+template <typename TextHandler> void AnsiParser::parse(const char* data, qsizetype size, TextHandler handleText)
+{
+    // A sequence cut off by the previous chunk is completed first; only its few bytes are copied
+    QByteArray joined;
+    if (!pending.isEmpty())
+    {
+        joined = pending + QByteArray::fromRawData(data, size);
+        pending.clear();
+        data = joined.constData();
+        size = joined.size();
+    }
+
+    qsizetype position = 0;
+    while (position < size)
+    {
+        const char* escape = static_cast<const char*>(std::memchr(data + position, '\x1b', size - position));
+        const qsizetype textEnd = escape ? escape - data : size;
+        if (textEnd > position)
+            handleText(data + position, textEnd - position);
+
+        if (!escape)
+            break;
+
+        qsizetype length = escapeLength(escape, size - textEnd);
+        if (length == 0 && size - textEnd < MaxEscapeLength)
+        {
+            pending = QByteArray(escape, size - textEnd);
+            break;
+        }
+
+        // Whatever never ends is not an escape sequence; drop the ESC and keep the rest as text
+        if (length == 0)
+            length = 1;
+
+        if (length > 2 && escape[length - 1] == 'm')
+            applySgr(QByteArray::fromRawData(escape + 2, length - 3), current);
+        position = textEnd + length;
+    }
+}
+
+void AnsiParser::applySgr(const QByteArray& parameters, AnsiStyle& style)
+{
+    // ':' separates the parts of 38:2:r:g:b in the ITU form; both forms mean the same here
+    QList<int> codes;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= parameters.size(); ++i)
+    {
+        if (i == parameters.size() || parameters.at(i) == ';' || parameters.at(i) == ':')
+        {
+            codes.append(i > start ? QByteArray::fromRawData(parameters.constData() + start, i - start).toInt() : 0);
+            start = i + 1;
+        }
+    }
+
+    for (qsizetype i = 0; i < codes.size(); ++i)
+    {
+        const int code = codes.at(i);
+        if (code == 0)
+            style = AnsiStyle();
+        else if (code == 1)
+            style.bold = true;
+        else if (code == 3)
+            style.italic = true;
+        else if (code == 4)
+            style.underline = true;
+        else if (code == 22)
+            style.bold = false;
+        else if (code == 23)
+            style.italic = false;
+        else if (code == 24)
+            style.underline = false;
+        else if (code >= 30 && code <= 37)
+            style.foreground = paletteColor(code - 30);
+        else if (code == 38)
+            style.foreground = extendedColor(codes, i);
+        else if (code == 39)
+            style.foreground = QColor();
+        else if (code >= 40 && code <= 47)
+            style.background = paletteColor(code - 40);
+        else if (code == 48)
+            style.background = extendedColor(codes, i);
+        else if (code == 49)
+            style.background = QColor();
+        else if (code >= 90 && code <= 97)
+            style.foreground = paletteColor(code - 90 + 8);
+        else if (code >= 100 && code <= 107)
+            style.background = paletteColor(code - 100 + 8);
+    }
+}
+
+QColor AnsiParser::paletteColor(int index)
+{
+    static const QColor standard[] = {
+        QColor("black"), QColor("red"),        QColor("green"),      QColor("yellow"),
+        QColor("blue"),  QColor("magenta"),    QColor("cyan"),       QColor("white"),
+        QColor("gray"),  QColor("lightcoral"), QColor("lightgreen"), QColor("lightyellow"),
+        QColor("lightblue"), QColor("violet"), QColor("cyan"),       QColor("white")};
+
+    if (index < 0 || index > 255)
+        return QColor();
+    if (index < 16)
+        return standard[index];
+    if (index < 232)
+    {
+        static const int levels[] = {0, 95, 135, 175, 215, 255};
+        const int cube = index - 16;
+        return QColor(levels[cube / 36], levels[(cube / 6) % 6], levels[cube % 6]);
+    }
+    const int gray = 8 + (index - 232) * 10;
+    return QColor(gray, gray, gray);
+}
+
+void AnsiParser::appendText(QList<AnsiSpan>& spans, const QString& text, const AnsiStyle& style)
+{
+    qsizetype position = 0;
+    while (position < text.size())
+    {
+        qsizetype link = text.indexOf(QLatin1String("http"), position);
+        while (link >= 0 && !isLinkStart(text, link))
+            link = text.indexOf(QLatin1String("http"), link + 4);
+        if (link < 0)
+            link = text.size();
+
+        if (link > position)
+            spans.append({text.mid(position, link - position), style, QString()});
+
+        if (link < text.size())
+        {
+            const QString url = text.mid(link, linkEnd(text, link) - link);
+            spans.append({url, style, url});
+            link += url.size();
+        }
+        position = link;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef ANSIPARSER_H
+#define ANSIPARSER_H
+
+#include <QByteArray>
+#include <QColor>
+#include <QList>
+#include <QString>
+#include <QStringDecoder>
+
+// Text attributes selected by SGR escape sequences; an invalid color means the default one
+struct AnsiStyle
+{
+    QColor foreground;
+    QColor background;
+    bool bold = false;
+    bool italic = false;
+    bool underline = false;
+};
+
+struct AnsiSpan
+{
+    QString text;
+    AnsiStyle style;
+    QString link; // set when the text is part of a URL
+};
+
+// Streaming parser for terminal output. The style, an escape sequence and a UTF-8 character cut off
+// at the end of a chunk all carry over to the next feed(), so output can be parsed as it arrives.
+// SGR sequences (ESC [ ... m) change the style, including 256-color and 24-bit colors; any other
+// CSI sequence such as cursor movement is dropped, and URLs get their own spans. ESC is found with
+// memchr, which libc vectorizes, so plain text costs one pass and one UTF-8 decode.
+class AnsiParser
+{
+  public:
+    explicit AnsiParser(const AnsiStyle& style = AnsiStyle());
+
+    QList<AnsiSpan> feed(const char* data, qsizetype size);
+    QList<AnsiSpan> feed(const QByteArray& data);
+
+    // Applies the SGR sequences in data without decoding any text, to move past output that is not shown
+    void skip(const char* data, qsizetype size);
+
+    const AnsiStyle& style() const;
+    void reset(const AnsiStyle& style = AnsiStyle());
+
+    // One line on its own, starting from style
+    static QList<AnsiSpan> parseLine(const QByteArray& line, const AnsiStyle& style = AnsiStyle());
+    static QString plainText(const QByteArray& line);
+
+    static void applySgr(const QByteArray& parameters, AnsiStyle& style);
+    // Colors 0-15 are the classic terminal colors, 16-255 the xterm cube and gray ramp
+    static QColor paletteColor(int index);
+
+  private:
+    template <typename TextHandler> void parse(const char* data, qsizetype size, TextHandler handleText);
+    static void appendText(QList<AnsiSpan>& spans, const QString& text, const AnsiStyle& style);
+
+    AnsiStyle current;
+    QByteArray pending;
+    QStringDecoder decoder{QStringDecoder::Utf8};
+};
+
+#endif // ANSIPARSER_H
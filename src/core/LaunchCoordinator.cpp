@@ -0,0 +1,172 @@
+#include "LaunchCoordinator.h"
+#include "Logger.h"
+
+LaunchCoordinator::LaunchCoordinator(StartFunction start, QObject* parent)
+    : QObject(parent), startFunction(std::move(start))
+{
+}
+
+bool LaunchCoordinator::launch(const QList<int>& processIds, const QHash<int, QList<int>>& dependencies,
+                               const QSet<int>& alreadyReady)
+{
+    if (launching)
+        return false;
+
+    if (hasCycle(processIds, dependencies))
+    {
+        LOG_ERROR_IN(Process, "Launch plan has a dependency cycle, nothing was started");
+        return false;
+    }
+
+    const QSet<int> planned(processIds.cbegin(), processIds.cend());
+    waitingOn.clear();
+    dependents.clear();
+    inFlight.clear();
+    failed = false;
+
+    for (int processId : processIds)
+    {
+        if (alreadyReady.contains(processId))
+            continue;
+
+        QSet<int>& waits = waitingOn[processId];
+        for (int dependencyId : dependencies.value(processId))
+        {
+            if (planned.contains(dependencyId) && !alreadyReady.contains(dependencyId))
+            {
+                waits.insert(dependencyId);
+                dependents[dependencyId].append(processId);
+            }
+        }
+    }
+
+    launching = true;
+
+    // Copy the roots first: start() may complete synchronously and modify waitingOn
+    QList<int> roots;
+    for (auto it = waitingOn.cbegin(); it != waitingOn.cend(); ++it)
+    {
+        if (it->isEmpty())
+            roots.append(it.key());
+    }
+
+    for (int processId : roots)
+        start(processId);
+
+    finishIfDone();
+    return true;
+}
+
+void LaunchCoordinator::markReady(int processId)
+{
+    if (!inFlight.remove(processId))
+        return;
+
+    for (int dependentId : dependents.take(processId))
+    {
+        auto it = waitingOn.find(dependentId);
+        if (it == waitingOn.end())
+            continue;
+
+        it->remove(processId);
+        if (it->isEmpty())
+            start(dependentId);
+    }
+
+    finishIfDone();
+}
+
+void LaunchCoordinator::markFailed(int processId)
+{
+    if (!inFlight.remove(processId))
+        return;
+
+    failed = true;
+
+    // Everything downstream can never become startable
+    QList<int> blocked = dependents.take(processId);
+    while (!blocked.isEmpty())
+    {
+        int dependentId = blocked.takeFirst();
+        if (!waitingOn.remove(dependentId))
+            continue;
+
+        blocked.append(dependents.take(dependentId));
+        emit processSkipped(dependentId);
+    }
+
+    finishIfDone();
+}
+
+void LaunchCoordinator::cancel()
+{
+    waitingOn.clear();
+    dependents.clear();
+    inFlight.clear();
+    launching = false;
+}
+
+bool LaunchCoordinator::isLaunching() const
+{
+    return launching;
+}
+
+bool LaunchCoordinator::hasCycle(const QList<int>& processIds, const QHash<int, QList<int>>& dependencies)
+{
+    // Kahn's algorithm: whatever cannot be ordered sits on a cycle
+    const QSet<int> planned(processIds.cbegin(), processIds.cend());
+    QHash<int, int> unmet;
+    QHash<int, QList<int>> reverse;
+
+    for (int processId : planned)
+    {
+        int& count = unmet[processId];
+        for (int dependencyId : dependencies.value(processId))
+        {
+            if (planned.contains(dependencyId))
+            {
+                ++count;
+                reverse[dependencyId].append(processId);
+            }
+        }
+    }
+
+    QList<int> ready;
+    for (auto it = unmet.cbegin(); it != unmet.cend(); ++it)
+    {
+        if (it.value() == 0)
+            ready.append(it.key());
+    }
+
+    int ordered = 0;
+    while (!ready.isEmpty())
+    {
+        int processId = ready.takeLast();
+        ++ordered;
+
+        for (int dependentId : reverse.value(processId))
+        {
+            if (--unmet[dependentId] == 0)
+                ready.append(dependentId);
+        }
+    }
+
+    return ordered != planned.size();
+}
+
+void LaunchCoordinator::start(int processId)
+{
+    waitingOn.remove(processId);
+    inFlight.insert(processId);
+    emit processStarted(processId);
+    startFunction(processId);
+}
+
+void LaunchCoordinator::finishIfDone()
+{
+    if (!launching || !inFlight.isEmpty() || !waitingOn.isEmpty())
+        return;
+
+    launching = false;
+    emit finished(!failed);
+}
@@ -0,0 +1,56 @@
+#ifndef LAUNCHCOORDINATOR_H
+#define LAUNCHCOORDINATOR_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <functional>
+
+// Starts a set of processes following their dependency graph. Everything whose dependencies are
+// ready is started at once, so a stack comes up in the time of its critical path. Readiness and
+// failures are reported back through markReady() and markFailed().
+class LaunchCoordinator : public QObject
+{
+    Q_OBJECT
+
+  public:
+    using StartFunction = std::function<void(int processId)>;
+
+    explicit LaunchCoordinator(StartFunction start, QObject* parent = nullptr);
+
+    // Dependencies map a process to the processes it waits for; ones outside processIds are ignored.
+    // Processes in alreadyReady are not started and count as ready. Returns false without starting
+    // anything if a launch is in progress or the graph has a cycle.
+    bool launch(const QList<int>& processIds, const QHash<int, QList<int>>& dependencies,
+                const QSet<int>& alreadyReady = {});
+
+    void markReady(int processId);
+    void markFailed(int processId);
+    // Abandons the launch in progress without finished(): nothing waiting is started any more and
+    // whatever is in flight no longer counts, for when nobody is left to report on it
+    void cancel();
+    bool isLaunching() const;
+
+    // Returns true if following the dependencies from any of processIds leads back to itself
+    static bool hasCycle(const QList<int>& processIds, const QHash<int, QList<int>>& dependencies);
+
+  signals:
+    void processStarted(int processId);
+    // Not started because a process it depends on, directly or not, failed
+    void processSkipped(int processId);
+    void finished(bool success);
+
+  private:
+    void start(int processId);
+    void finishIfDone();
+
+    StartFunction startFunction;
+    QHash<int, QSet<int>> waitingOn;
+    QHash<int, QList<int>> dependents;
+    QSet<int> inFlight;
+    bool launching = false;
+    bool failed = false;
+};
+
+#endif // LAUNCHCOORDINATOR_H
@@ -0,0 +1,183 @@
+#include "LogArchive.h"
+#include "Logger.h"
+#include <QDataStream>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace
+{
+    constexpr quint32 ArchiveMagic = 0x4C415243; // "LARC"
+    constexpr quint32 ArchiveVersion = 1;
+    // Archives are written once and read often; the slowest level is worth it
+    constexpr int CompressionLevel = 9;
+}
+
+LogArchive::LogArchive(const QString& path) : file(path)
+{
+    cache.reserve(CachedBlocks);
+}
+
+bool LogArchive::open()
+{
+    if (opened)
+        return true;
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != ArchiveMagic || version != ArchiveVersion)
+    {
+        file.close();
+        return false;
+    }
+    stream >> sourceFileId >> totalSize >> blockSize >> blockOffsets;
+    dataStart = file.pos();
+
+    const qint64 blockCount = blockSize > 0 ? (totalSize + blockSize - 1) / blockSize : -1;
+    if (stream.status() != QDataStream::Ok || totalSize < 0 || blockOffsets.size() != blockCount + 1 ||
+        !std::is_sorted(blockOffsets.begin(), blockOffsets.end()) || dataStart + blockOffsets.last() != file.size())
+    {
+        LOG_WARNING_IN(Logs, "Damaged log archive " + file.fileName());
+        file.close();
+        return false;
+    }
+
+    opened = true;
+    return true;
+}
+
+bool LogArchive::isOpen() const
+{
+    return opened;
+}
+
+qint64 LogArchive::size() const
+{
+    return totalSize;
+}
+
+quint64 LogArchive::fileId() const
+{
+    return sourceFileId;
+}
+
+qint64 LogArchive::blockBytes() const
+{
+    return blockSize;
+}
+
+const char* LogArchive::dataAt(qint64 position, qint64& available)
+{
+    available = 0;
+    if (!opened || position < 0 || position >= totalSize)
+        return nullptr;
+
+    const QByteArray* data = block(position / blockSize);
+    if (!data)
+        return nullptr;
+
+    const qint64 within = position % blockSize;
+    available = data->size() - within;
+    return data->constData() + within;
+}
+
+QByteArray LogArchive::read(qint64 position, qint64 maxBytes)
+{
+    QByteArray result;
+    const qint64 end = qMin(totalSize, position + maxBytes);
+    result.reserve(qMax<qint64>(end - position, 0));
+
+    while (position < end)
+    {
+        qint64 available = 0;
+        const char* data = dataAt(position, available);
+        if (available == 0)
+            break;
+
+        const qint64 length = qMin(available, end - position);
+        result.append(data, length);
+        position += length;
+    }
+    return result;
+}
+
+bool LogArchive::write(const QString& sourcePath, const QString& archivePath, quint64 fileId, qint64 blockBytes)
+{
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly))
+    {
+        LOG_WARNING_IN(Logs, "Failed to read log segment " + sourcePath + ": " + source.errorString());
+        return false;
+    }
+    const QByteArray data = source.readAll();
+
+    QList<QByteArray> blocks;
+    QList<qint64> offsets = {0};
+    for (qint64 start = 0; start < data.size(); start += blockBytes)
+    {
+        const qint64 length = qMin<qint64>(blockBytes, data.size() - start);
+        blocks.append(qCompress(reinterpret_cast<const uchar*>(data.constData() + start), length, CompressionLevel));
+        offsets.append(offsets.last() + blocks.last().size());
+    }
+
+    QSaveFile archive(archivePath);
+    if (!archive.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING_IN(Logs, "Failed to write log archive " + archivePath + ": " + archive.errorString());
+        return false;
+    }
+
+    QDataStream stream(&archive);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << ArchiveMagic << ArchiveVersion << fileId << qint64(data.size()) << blockBytes << offsets;
+    for (const QByteArray& block : blocks)
+        stream.writeRawData(block.constData(), block.size());
+
+    if (stream.status() != QDataStream::Ok || !archive.commit())
+    {
+        LOG_WARNING_IN(Logs, "Failed to write log archive " + archivePath + ": " + archive.errorString());
+        return false;
+    }
+    return true;
+}
+
+const QByteArray* LogArchive::block(qsizetype index)
+{
+    ++uses;
+    for (CachedBlock& cached : cache)
+    {
+        if (cached.index == index)
+        {
+            cached.lastUse = uses;
+            return &cached.data;
+        }
+    }
+
+    const qint64 expected = qMin(blockSize, totalSize - index * blockSize);
+    const qint64 compressedSize = blockOffsets.at(index + 1) - blockOffsets.at(index);
+    if (!file.seek(dataStart + blockOffsets.at(index)))
+        return nullptr;
+
+    QByteArray data = qUncompress(file.read(compressedSize));
+    if (data.size() != expected)
+    {
+        LOG_WARNING_IN(Logs, "Damaged block " + QString::number(index) + " in log archive " + file.fileName());
+        return nullptr;
+    }
+
+    // The least recently used block makes room
+    if (cache.size() < size_t(CachedBlocks))
+        cache.push_back(CachedBlock());
+    CachedBlock& slot = *std::min_element(cache.begin(), cache.end(),
+                                          [](const CachedBlock& left, const CachedBlock& right)
+                                          { return left.lastUse < right.lastUse; });
+    slot.index = index;
+    slot.data = std::move(data);
+    slot.lastUse = uses;
+    return &slot.data;
+}
@@ -0,0 +1,64 @@
+#ifndef LOGARCHIVE_H
+#define LOGARCHIVE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <vector>
+
+// Finished log segment stored as independently compressed blocks of BlockBytes, so any range can be
+// read by decompressing only the blocks it touches. The header lists where every block starts; blocks
+// are qCompress'ed. Decompressed blocks are kept in a small cache, since readers tend to come back to
+// the lines they just read. Not thread-safe; every reader opens its own.
+class LogArchive
+{
+  public:
+    explicit LogArchive(const QString& path);
+
+    // Reads the header; blocks are read when first touched
+    bool open();
+    bool isOpen() const;
+
+    // Uncompressed size
+    qint64 size() const;
+    // fileId of the segment the archive was made from, so readers see the same file
+    quint64 fileId() const;
+    qint64 blockBytes() const;
+
+    // Contiguous bytes at position, up to the end of its block; available is 0 past the end or if the
+    // block is damaged. Valid until CachedBlocks other blocks were read.
+    const char* dataAt(qint64 position, qint64& available);
+    // Up to maxBytes from position on
+    QByteArray read(qint64 position, qint64 maxBytes);
+
+    // Compresses sourcePath into archivePath, replacing it atomically
+    static bool write(const QString& sourcePath, const QString& archivePath, quint64 fileId,
+                      qint64 blockBytes = BlockBytes);
+
+    static constexpr qint64 BlockBytes = 64 * 1024;
+    static constexpr int CachedBlocks = 8;
+
+  private:
+    struct CachedBlock
+    {
+        qsizetype index = -1;
+        QByteArray data;
+        quint64 lastUse = 0;
+    };
+
+    const QByteArray* block(qsizetype index);
+
+    QFile file;
+    qint64 totalSize = 0;
+    quint64 sourceFileId = 0;
+    qint64 blockSize = BlockBytes;
+    // Relative to dataStart, one more than there are blocks
+    QList<qint64> blockOffsets;
+    qint64 dataStart = 0;
+    bool opened = false;
+    std::vector<CachedBlock> cache;
+    quint64 uses = 0;
+};
+
+#endif // LOGARCHIVE_H
@@ -0,0 +1,116 @@
+#include "LogCompactor.h"
+
+namespace
+{
+    bool isBlank(const QByteArray& line)
+    {
+        return line == "\n" || line == "\r\n";
+    }
+}
+
+QByteArray LogCompactor::compact(const QByteArray& data)
+{
+    QByteArray output;
+    qsizetype start = 0;
+    while (start < data.size())
+    {
+        const qsizetype newline = data.indexOf('\n', start);
+        const qsizetype end = newline < 0 ? data.size() : newline;
+        appendFrame(data.constData() + start, end - start, output);
+        if (newline < 0)
+            break;
+
+        line.append('\n');
+        finishLine(output);
+        start = newline + 1;
+    }
+
+    if (line.size() > MaxLineBytes)
+        writePartial(output);
+    return output;
+}
+
+QByteArray LogCompactor::flush()
+{
+    QByteArray output;
+    writeRepeats(output);
+    if (!line.isEmpty())
+        writePartial(output);
+    return output;
+}
+
+void LogCompactor::appendFrame(const char* data, qsizetype size, QByteArray& output)
+{
+    if (size == 0)
+        return;
+
+    // A carriage return that turned out not to end the line starts it over, as does any in data but a
+    // last one, which may be followed by a newline in the next chunk
+    qsizetype from = line.endsWith('\r') ? 0 : -1;
+    for (qsizetype i = size - 2; i >= 0; --i)
+    {
+        if (data[i] == '\r')
+        {
+            from = i + 1;
+            break;
+        }
+    }
+
+    if (from >= 0)
+    {
+        line.clear();
+        if (partialWritten)
+        {
+            // The frame on screen stays as it is; the redrawn one goes below it
+            output.append('\n');
+            partialWritten = false;
+        }
+    }
+    line.append(data + qMax<qsizetype>(from, 0), size - qMax<qsizetype>(from, 0));
+}
+
+void LogCompactor::finishLine(QByteArray& output)
+{
+    if (partialWritten)
+    {
+        output.append(line);
+        partialWritten = false;
+        line.clear();
+        return;
+    }
+
+    if (line == lastLine && !isBlank(line))
+    {
+        ++repeats;
+        line.clear();
+        return;
+    }
+
+    writeRepeats(output);
+    output.append(line);
+    lastLine.swap(line);
+    line.clear();
+}
+
+void LogCompactor::writePartial(QByteArray& output)
+{
+    writeRepeats(output);
+    lastLine.clear();
+
+    // A trailing carriage return is held back until it is clear whether a newline follows
+    const bool pendingReturn = line.endsWith('\r');
+    output.append(line.constData(), line.size() - (pendingReturn ? 1 : 0));
+    line = pendingReturn ? QByteArray("\r") : QByteArray();
+    partialWritten = true;
+}
+
+void LogCompactor::writeRepeats(QByteArray& output)
+{
+    if (repeats == 0)
+        return;
+
+    // The count includes the line written before the run
+    output.append("\x1b[2m(\xc3\x97" + QByteArray::number(repeats + 1) + ")\x1b[0m\n");
+    repeats = 0;
+    lastLine.clear();
+}
@@ -0,0 +1,40 @@
+#ifndef LOGCOMPACTOR_H
+#define LOGCOMPACTOR_H
+
+#include <QByteArray>
+
+// Ingest stage between a process and its log that drops output nobody reads back. A line redrawn
+// with carriage returns, like a progress bar or a spinner, keeps only its last frame, and a line that
+// repeats the one before is written once, followed by a dimmed "(×N)" line when the run ends. An
+// unterminated line and a run in progress are held back until flush(), which callers run once the
+// output goes quiet; a frame written by flush() that is redrawn later ends up on a line of its own.
+// Line endings, colors and invalid UTF-8 pass through untouched.
+class LogCompactor
+{
+  public:
+    // Compacted data, continuing what came before; empty while everything is held back
+    QByteArray compact(const QByteArray& data);
+    // The count of a run in progress and the last frame of an unterminated line
+    QByteArray flush();
+
+    // An unterminated line longer than this is written as it is
+    static constexpr qsizetype MaxLineBytes = 64 * 1024;
+    // Quiet time after which callers flush
+    static constexpr int IdleFlushMs = 500;
+
+  private:
+    void appendFrame(const char* data, qsizetype size, QByteArray& output);
+    void finishLine(QByteArray& output);
+    void writePartial(QByteArray& output);
+    void writeRepeats(QByteArray& output);
+
+    // Last frame of the line being received, a pending '\r' at the end
+    QByteArray line;
+    // Part of the line was written by flush()
+    bool partialWritten = false;
+    // Last line written, with its line ending, and how often it came again since
+    QByteArray lastLine;
+    qint64 repeats = 0;
+};
+
+#endif // LOGCOMPACTOR_H
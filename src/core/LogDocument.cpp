@@ -0,0 +1,442 @@
+#include "LogDocument.h"
+#include <algorithm>
+#include <cstring>
+
+LogDocument::LogDocument(const QString& directoryPath) : log(directoryPath)
+{
+}
+
+LogDocument::~LogDocument()
+{
+}
+
+void LogDocument::refresh()
+{
+    log.load();
+    const QList<LogSegment> segments = log.segments();
+
+    std::vector<OpenSegment> updated;
+    updated.reserve(segments.size());
+    bool rewritten = false;
+    for (qsizetype i = 0; i < segments.size(); ++i)
+    {
+        // Only the last segment is still written to
+        const LogSegment& segment = segments.at(i);
+        const bool finished = i + 1 < segments.size();
+        OpenSegment open;
+        auto existing = std::find_if(openSegments.begin(), openSegments.end(),
+                                     [&](const OpenSegment& candidate)
+                                     { return candidate.segment.fileName == segment.fileName; });
+
+        // A segment is kept open until it grows, or is mapped once it is finished
+        if (existing != openSegments.end() && existing->segment.fileId == segment.fileId &&
+            existing->size() == segment.size && (!existing->reader || existing->reader->isFinished() == finished))
+        {
+            open = std::move(*existing);
+        }
+        else
+        {
+            if (existing != openSegments.end())
+            {
+                // Truncated, or replaced by another file of the same name: lines indexed from it are gone
+                rewritten = rewritten || existing->segment.fileId != segment.fileId || segment.size < existing->size();
+                existing->reader.reset();
+            }
+            open.segment = segment;
+            openSegment(open, finished);
+        }
+        open.segment = segment;
+        updated.push_back(std::move(open));
+    }
+    openSegments = std::move(updated);
+
+    // Output older than the first indexed line may go without affecting the index
+    if (rewritten || log.startOffset() > indexStart || indexEnd > endOffset())
+        resetIndex();
+}
+
+bool LogDocument::indexMore(qint64 maxBytes)
+{
+    const qint64 end = qMin(endOffset(), scanPosition + maxBytes);
+
+    while (scanPosition < end)
+    {
+        const qint64 newline = findNewline(scanPosition, end);
+        if (newline < 0)
+        {
+            // An unfinished line is indexed once its newline arrives; the scan goes on from here
+            scanPosition = end;
+            break;
+        }
+
+        // endStyle() only follows the SGR sequences since the previous checkpoint
+        if (indexedLines % CheckpointStride == 0)
+        {
+            checkpoints.append({indexEnd, endStyle()});
+        }
+        ++indexedLines;
+        indexEnd = newline + 1;
+        scanPosition = indexEnd;
+    }
+
+    return isIndexing();
+}
+
+bool LogDocument::isIndexing() const
+{
+    return scanPosition < endOffset();
+}
+
+qint64 LogDocument::indexOlder(qint64 maxBytes)
+{
+    if (!hasOlder())
+        return 0;
+
+    // indexStart - 1 ends the line before it; the slice starts after a newline, or at the very start
+    const qint64 floor = log.startOffset();
+    qint64 from = qMax(floor, indexStart - maxBytes);
+    if (from > floor)
+    {
+        qint64 newline = findNewline(from - 1, indexStart - 1);
+        if (newline < 0)
+            newline = findPreviousNewline(floor, from - 1);
+        from = newline < 0 ? floor : newline + 1;
+    }
+
+    QList<qint64> starts = {from};
+    for (qint64 newline = findNewline(from, indexStart); newline >= 0 && newline + 1 < indexStart;
+         newline = findNewline(newline + 1, indexStart))
+    {
+        starts.append(newline + 1);
+    }
+
+    // Line i of the slice is starts.size() - i lines before the old first line, plus the olderLines before that
+    const qint64 added = starts.size();
+    QList<Checkpoint> sliceCheckpoints;
+    AnsiParser parser;
+    qint64 parsed = from;
+    for (qsizetype i = 0; i < starts.size(); ++i)
+    {
+        if ((olderLines + added - i) % CheckpointStride == 0)
+        {
+            skipRange(parser, parsed, starts.at(i));
+            parsed = starts.at(i);
+            sliceCheckpoints.prepend({starts.at(i), parser.style()});
+        }
+    }
+
+    olderCheckpoints.append(sliceCheckpoints);
+    olderLines += added;
+    indexStart = from;
+    return added;
+}
+
+bool LogDocument::hasOlder() const
+{
+    return indexStart > log.startOffset();
+}
+
+qint64 LogDocument::lineCount() const
+{
+    return olderLines + indexedLines;
+}
+
+qint64 LogDocument::startOffset() const
+{
+    return indexStart;
+}
+
+qint64 LogDocument::indexedEnd() const
+{
+    return indexEnd;
+}
+
+qint64 LogDocument::endOffset() const
+{
+    qint64 end = log.startOffset();
+    for (const OpenSegment& open : openSegments)
+    {
+        if (open.reader)
+            end = qMax(end, open.segment.startOffset + open.size());
+    }
+    return end;
+}
+
+qint64 LogDocument::logStartOffset() const
+{
+    return log.startOffset();
+}
+
+QList<QByteArray> LogDocument::lines(qint64 first, int count, AnsiStyle* style) const
+{
+    QList<QByteArray> result;
+    if (first < 0 || first >= lineCount() || count <= 0)
+        return result;
+
+    // Line numbers relative to tailOffset; older lines have negative ones
+    const qint64 line = first - olderLines;
+    Checkpoint checkpoint = {indexStart, AnsiStyle()};
+    qint64 skip = first;
+    if (line >= 0)
+    {
+        checkpoint = checkpoints.at(line / CheckpointStride);
+        skip = line % CheckpointStride;
+    }
+    else
+    {
+        // Lines above the topmost older checkpoint are counted from indexStart
+        const qint64 block = (-line + CheckpointStride - 1) / CheckpointStride;
+        if (block <= olderCheckpoints.size())
+        {
+            checkpoint = olderCheckpoints.at(block - 1);
+            skip = line + block * CheckpointStride;
+        }
+    }
+
+    qint64 position = checkpoint.offset;
+    for (; skip > 0; --skip)
+        position = findNewline(position, indexEnd) + 1;
+
+    if (style)
+    {
+        AnsiParser parser(checkpoint.style);
+        skipRange(parser, checkpoint.offset, position);
+        *style = parser.style();
+    }
+
+    for (qint64 row = first; row < lineCount() && result.size() < count; ++row)
+    {
+        const qint64 newline = findNewline(position, indexEnd);
+        QByteArray text = bytes(position, newline);
+        if (text.endsWith('\r'))
+            text.chop(1);
+        result.append(text);
+        position = newline + 1;
+    }
+    return result;
+}
+
+qint64 LogDocument::lineAt(qint64 offset) const
+{
+    if (offset < indexStart || offset >= indexEnd)
+        return -1;
+
+    // The nearest checkpoint at or before offset; older checkpoints go backward from tailOffset
+    qint64 line = 0;
+    qint64 position = indexStart;
+    if (offset >= tailOffset)
+    {
+        auto checkpoint = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset,
+                                           [](qint64 value, const Checkpoint& candidate)
+                                           { return value < candidate.offset; }) - 1;
+        line = olderLines + (checkpoint - checkpoints.begin()) * CheckpointStride;
+        position = checkpoint->offset;
+    }
+    else
+    {
+        auto checkpoint = std::partition_point(olderCheckpoints.begin(), olderCheckpoints.end(),
+                                               [&](const Checkpoint& candidate) { return candidate.offset > offset; });
+        if (checkpoint != olderCheckpoints.end())
+        {
+            line = olderLines - (checkpoint - olderCheckpoints.begin() + 1) * CheckpointStride;
+            position = checkpoint->offset;
+        }
+    }
+
+    for (qint64 newline = findNewline(position, indexEnd); newline >= 0 && newline < offset;
+         newline = findNewline(position, indexEnd))
+    {
+        position = newline + 1;
+        ++line;
+    }
+    return line;
+}
+
+AnsiStyle LogDocument::endStyle() const
+{
+    if (checkpoints.isEmpty())
+        return AnsiStyle();
+
+    AnsiParser parser(checkpoints.last().style);
+    skipRange(parser, checkpoints.last().offset, indexEnd);
+    return parser.style();
+}
+
+QByteArray LogDocument::lineFrom(qint64 offset) const
+{
+    const qint64 newline = offset >= log.startOffset() ? findNewline(offset, endOffset()) : -1;
+    if (newline < 0)
+        return QByteArray();
+
+    QByteArray text = bytes(offset, newline);
+    if (text.endsWith('\r'))
+        text.chop(1);
+    return text;
+}
+
+qint64 LogDocument::nextLineStart(qint64 offset) const
+{
+    const qint64 newline = offset >= log.startOffset() ? findNewline(offset, endOffset()) : -1;
+    return newline < 0 ? -1 : newline + 1;
+}
+
+qint64 LogDocument::previousLineStart(qint64 offset) const
+{
+    const qint64 start = log.startOffset();
+    const qint64 end = findPreviousNewline(start, qMin(offset, endOffset()));
+    if (end < 0)
+        return -1;
+
+    const qint64 newline = findPreviousNewline(start, end);
+    return newline < 0 ? start : newline + 1;
+}
+
+QByteArray LogDocument::bytes(qint64 from, qint64 to) const
+{
+    QByteArray result;
+    result.reserve(qMax<qint64>(to - from, 0));
+
+    while (from < to)
+    {
+        qint64 available = 0;
+        const char* data = dataAt(from, available);
+        if (available == 0)
+            break;
+
+        const qint64 length = qMin(available, to - from);
+        result.append(data, length);
+        from += length;
+    }
+    return result;
+}
+
+bool LogDocument::clear()
+{
+    const bool cleared = log.clear();
+    refresh();
+    return cleared;
+}
+
+QString LogDocument::directoryPath() const
+{
+    return log.directoryPath();
+}
+
+void LogDocument::resetIndex()
+{
+    checkpoints.clear();
+    indexedLines = 0;
+    olderCheckpoints.clear();
+    olderLines = 0;
+    tailOffset = tailStart();
+    indexStart = tailOffset;
+    indexEnd = tailOffset;
+    scanPosition = tailOffset;
+}
+
+qint64 LogDocument::tailStart() const
+{
+    const qint64 floor = log.startOffset();
+    const qint64 limit = qMax(floor, endOffset() - TailBytes);
+
+    // position - 1 is the newline ending the line above position, not the start of another line
+    qint64 position = endOffset();
+    for (int line = 0; line < TailLines && position > floor; ++line)
+    {
+        const qint64 newline = findPreviousNewline(line == 0 ? floor : limit, position - 1);
+        if (newline < 0)
+            return line == 0 || limit == floor ? floor : position;
+        position = newline + 1;
+    }
+    return position;
+}
+
+bool LogDocument::openSegment(OpenSegment& open, bool finished)
+{
+    open.reader = std::make_unique<SegmentReader>(log, open.segment, finished, open.segment.size);
+    if (!open.reader->open())
+    {
+        open.reader.reset();
+        return false;
+    }
+    return true;
+}
+
+void LogDocument::skipRange(AnsiParser& parser, qint64 from, qint64 to) const
+{
+    while (from < to)
+    {
+        qint64 available = 0;
+        const char* data = dataAt(from, available);
+        if (available == 0)
+            return;
+
+        const qint64 length = qMin(available, to - from);
+        parser.skip(data, length);
+        from += length;
+    }
+}
+
+const char* LogDocument::dataAt(qint64 offset, qint64& available) const
+{
+    available = 0;
+    if (offset < log.startOffset())
+        return nullptr;
+
+    for (const OpenSegment& open : openSegments)
+    {
+        const qint64 start = open.segment.startOffset;
+        if (open.reader && offset >= start && offset < start + open.size())
+            return open.reader->dataAt(offset - start, available);
+    }
+    return nullptr;
+}
+
+qint64 LogDocument::findNewline(qint64 from, qint64 to) const
+{
+    while (from < to)
+    {
+        qint64 available = 0;
+        const char* data = dataAt(from, available);
+        if (available == 0)
+            return -1;
+
+        const qint64 length = qMin(available, to - from);
+        if (const void* newline = std::memchr(data, '\n', length))
+            return from + (static_cast<const char*>(newline) - data);
+        from += length;
+    }
+    return -1;
+}
+
+qint64 LogDocument::findPreviousNewline(qint64 from, qint64 to) const
+{
+    // Segments are walked backward; within one the bytes are scanned from the end a block at a time
+    for (auto open = openSegments.rbegin(); open != openSegments.rend() && to > from; ++open)
+    {
+        const qint64 start = qMax(open->segment.startOffset, from);
+        const qint64 end = qMin(open->segment.startOffset + open->size(), to);
+        if (!open->reader || start >= end)
+            continue;
+
+        const qint64 blockBytes = open->reader->blockBytes();
+        for (qint64 chunkEnd = end; chunkEnd > start;)
+        {
+            const qint64 block = (chunkEnd - 1 - open->segment.startOffset) / blockBytes;
+            const qint64 chunkStart = qMax(start, open->segment.startOffset + block * blockBytes);
+
+            qint64 available = 0;
+            const char* data = dataAt(chunkStart, available);
+            if (available < chunkEnd - chunkStart)
+                return -1;
+            for (qint64 i = chunkEnd - chunkStart - 1; i >= 0; --i)
+            {
+                if (data[i] == '\n')
+                    return chunkStart + i;
+            }
+            chunkEnd = chunkStart;
+        }
+        to = start;
+    }
+    return -1;
+}
@@ -0,0 +1,120 @@
+#ifndef LOGDOCUMENT_H
+#define LOGDOCUMENT_H
+
+#include "AnsiParser.h"
+#include "SegmentReader.h"
+#include "SegmentedLog.h"
+#include <QByteArray>
+#include <QList>
+#include <memory>
+#include <vector>
+
+// Read-only, line-addressable view of a SegmentedLog. Finished segments are memory mapped instead of read,
+// and lines are found through a sparse index that keeps the offset of every CheckpointStride-th
+// line together with the ANSI style in effect there, so colors carry across lines wherever reading
+// starts, and a gigabyte of output costs a few hundred kilobytes of index. Indexing starts at the tail:
+// the last TailLines lines are found by scanning backward from the end, so opening a log costs the
+// same however long it is. indexMore() then follows new output and indexOlder() extends the index
+// backward, each in bounded slices callers can spread over event loop iterations. Colors carry
+// across lines within a slice but not into an older slice. Only lines terminated by a newline are
+// indexed. Archived segments are decompressed one block at a time as lines are read from them.
+class LogDocument
+{
+  public:
+    explicit LogDocument(const QString& directoryPath);
+    ~LogDocument();
+    LogDocument(const LogDocument&) = delete;
+    LogDocument& operator=(const LogDocument&) = delete;
+
+    // Opens new segments and picks up new bytes; the index starts over if older output was deleted or cleared
+    void refresh();
+
+    // Indexes up to maxBytes of unindexed output; returns true while more is left
+    bool indexMore(qint64 maxBytes = IndexSliceBytes);
+    bool isIndexing() const;
+    // Indexes about maxBytes of the output before the first indexed line; returns the number of
+    // lines added in front, which shifts every line number by as much
+    qint64 indexOlder(qint64 maxBytes = OlderSliceBytes);
+    bool hasOlder() const;
+
+    qint64 lineCount() const;
+    // Start of the first indexed line
+    qint64 startOffset() const;
+    // End of the last indexed line; output after it has no newline yet or is not indexed yet
+    qint64 indexedEnd() const;
+    qint64 endOffset() const;
+    // First offset still in the log; lines between it and startOffset() are not indexed yet
+    qint64 logStartOffset() const;
+
+    // Up to count consecutive lines from first on, without their line endings. style receives the
+    // ANSI style in effect at the start of the first line.
+    QList<QByteArray> lines(qint64 first, int count, AnsiStyle* style = nullptr) const;
+    // Line containing offset, or -1 if the line is not indexed
+    qint64 lineAt(qint64 offset) const;
+    // Line starting at offset, indexed or not, without its line ending; empty if it has no newline yet
+    QByteArray lineFrom(qint64 offset) const;
+    // Start of the line after the one starting at offset, or -1 if that one has no newline yet
+    qint64 nextLineStart(qint64 offset) const;
+    // Start of the last line that ends before offset, indexed or not, or -1 if there is none
+    qint64 previousLineStart(qint64 offset) const;
+    // Style in effect after the last indexed line
+    AnsiStyle endStyle() const;
+    QByteArray bytes(qint64 from, qint64 to) const;
+
+    // Hides everything written so far, see SegmentedLog::clear()
+    bool clear();
+    QString directoryPath() const;
+
+    static constexpr int CheckpointStride = 64;
+    static constexpr qint64 IndexSliceBytes = 32 * 1024 * 1024;
+    static constexpr qint64 OlderSliceBytes = 1024 * 1024;
+    static constexpr int TailLines = 2000;
+    static constexpr qint64 TailBytes = 1024 * 1024;
+
+  private:
+    struct OpenSegment
+    {
+        LogSegment segment;
+        // Null if the segment could not be opened
+        std::unique_ptr<SegmentReader> reader;
+
+        qint64 size() const
+        {
+            return reader ? reader->size() : 0;
+        }
+    };
+
+    struct Checkpoint
+    {
+        qint64 offset = 0;
+        AnsiStyle style;
+    };
+
+    void resetIndex();
+    // Start of the TailLines-th line from the end, looking back at most TailBytes unless the last line is longer
+    qint64 tailStart() const;
+    void skipRange(AnsiParser& parser, qint64 from, qint64 to) const;
+    bool openSegment(OpenSegment& open, bool finished);
+    // Contiguous bytes at offset, valid until the next call; available is 0 past the end
+    const char* dataAt(qint64 offset, qint64& available) const;
+    qint64 findNewline(qint64 from, qint64 to) const;
+    // Last newline in [from, to), or -1
+    qint64 findPreviousNewline(qint64 from, qint64 to) const;
+
+    SegmentedLog log;
+    std::vector<OpenSegment> openSegments;
+    // Lines from where indexing started on, a checkpoint every CheckpointStride lines
+    QList<Checkpoint> checkpoints;
+    qint64 indexedLines = 0;
+    // Lines before it, counted backward: olderCheckpoints[k] starts line (k + 1) * CheckpointStride
+    // before it, and indexStart is the first of the olderLines lines
+    QList<Checkpoint> olderCheckpoints;
+    qint64 olderLines = 0;
+    qint64 tailOffset = 0;
+    // -1 until the first refresh finds the tail
+    qint64 indexStart = -1;
+    qint64 indexEnd = 0;
+    qint64 scanPosition = 0;
+};
+
+#endif // LOGDOCUMENT_H
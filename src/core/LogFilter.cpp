@@ -0,0 +1,128 @@
+#include "LogFilter.h"
+
+LogFilter::LogFilter(const QString& directoryPath, QObject* parent) : QObject(parent), directory(directoryPath)
+{
+    workerThread = new QThread(this);
+    workerThread->setObjectName("LogFilter");
+    worker = new QObject();
+    worker->moveToThread(workerThread);
+    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    workerThread->start();
+}
+
+LogFilter::~LogFilter()
+{
+    ++generation;
+    workerThread->quit();
+    workerThread->wait();
+}
+
+void LogFilter::start(const LogLineMatcher& matcher)
+{
+    currentMatcher = matcher;
+    scannedEnd = -1;
+    scan(-1);
+}
+
+void LogFilter::update()
+{
+    // A running scan picks up everything written before it reaches the end
+    if (running || scannedEnd < 0)
+        return;
+    scan(scannedEnd);
+}
+
+void LogFilter::cancel()
+{
+    ++generation;
+    running = false;
+}
+
+bool LogFilter::isRunning() const
+{
+    return running;
+}
+
+void LogFilter::scan(qint64 from)
+{
+    const quint64 scanGeneration = ++generation;
+    running = true;
+
+    QMetaObject::invokeMethod(
+        worker,
+        [this, from, scanGeneration, matcher = currentMatcher]()
+        {
+            if (generation != scanGeneration)
+                return;
+
+            if (!document)
+                document = std::make_unique<LogDocument>(directory);
+            document->refresh();
+
+            const qint64 end = document->endOffset();
+            qint64 position = qMax(from, document->logStartOffset());
+
+            // A line longer than a chunk is skipped up to its end
+            bool insideLongLine = false;
+            while (position < end && generation == scanGeneration)
+            {
+                const QByteArray chunk = document->bytes(position, qMin(end, position + ChunkBytes));
+                const qsizetype lastNewline = chunk.lastIndexOf('\n');
+                if (lastNewline < 0)
+                {
+                    if (chunk.size() < ChunkBytes)
+                        break;
+                    insideLongLine = true;
+                    position += chunk.size();
+                    continue;
+                }
+
+                QList<qint64> matches;
+                qsizetype lineStart = 0;
+                if (insideLongLine)
+                {
+                    lineStart = chunk.indexOf('\n') + 1;
+                    insideLongLine = false;
+                }
+                while (lineStart <= lastNewline)
+                {
+                    const qsizetype newline = chunk.indexOf('\n', lineStart);
+                    const char* line = chunk.constData() + lineStart;
+                    qsizetype length = newline - lineStart;
+                    if (length > 0 && line[length - 1] == '\r')
+                        --length;
+                    if (matcher.matches(line, length))
+                        matches.append(position + lineStart);
+                    lineStart = newline + 1;
+                }
+                position += lastNewline + 1;
+
+                if (!matches.isEmpty())
+                {
+                    QMetaObject::invokeMethod(
+                        this,
+                        [this, matches, scanGeneration]()
+                        {
+                            if (generation == scanGeneration)
+                                emit matchesFound(matches);
+                        },
+                        Qt::QueuedConnection);
+                }
+            }
+
+            if (generation != scanGeneration)
+                return;
+            QMetaObject::invokeMethod(
+                this,
+                [this, position, scanGeneration]()
+                {
+                    if (generation != scanGeneration)
+                        return;
+                    running = false;
+                    scannedEnd = position;
+                    emit finished(position);
+                },
+                Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
@@ -0,0 +1,54 @@
+#ifndef LOGFILTER_H
+#define LOGFILTER_H
+
+#include "LogDocument.h"
+#include "LogLineMatcher.h"
+#include <QList>
+#include <QObject>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+// Runs a LogLineMatcher over a process log on a worker thread of its own. The log is mapped and read
+// in chunks of ChunkBytes; the offsets of matching lines arrive through matchesFound() after every
+// chunk that had any, oldest first, so a view fills up while the scan goes on. Starting another
+// query, or cancel(), stops the running scan after the chunk at hand, and batches of a stopped scan
+// that were already on their way are dropped.
+class LogFilter : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit LogFilter(const QString& directoryPath, QObject* parent = nullptr);
+    ~LogFilter();
+
+    // Scans the whole log for matcher, cancelling the scan before
+    void start(const LogLineMatcher& matcher);
+    // Scans output written since the last scan finished, with the same matcher
+    void update();
+    void cancel();
+    bool isRunning() const;
+
+    static constexpr qint64 ChunkBytes = 4 * 1024 * 1024;
+
+  signals:
+    void matchesFound(const QList<qint64>& lineOffsets);
+    // endOffset is the end of the last line scanned
+    void finished(qint64 endOffset);
+
+  private:
+    void scan(qint64 from);
+
+    QString directory;
+    LogLineMatcher currentMatcher;
+    qint64 scannedEnd = -1;
+    bool running = false;
+    QThread* workerThread = nullptr;
+    QObject* worker = nullptr;
+    // Bumped by every start() and cancel(); a scan stops once it no longer has the current one
+    std::atomic<quint64> generation{0};
+    // Only touched on the worker thread
+    std::unique_ptr<LogDocument> document;
+};
+
+#endif // LOGFILTER_H
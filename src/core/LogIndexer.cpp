@@ -0,0 +1,138 @@
+#include "LogIndexer.h"
+
+LogIndexer& LogIndexer::instance()
+{
+    static LogIndexer instance;
+    return instance;
+}
+
+LogIndexer::LogIndexer()
+{
+    indexTimer = new QTimer(this);
+    indexTimer->setSingleShot(true);
+    indexTimer->setInterval(IndexDelayMs);
+    connect(indexTimer, &QTimer::timeout, this, &LogIndexer::indexPending);
+
+    workerThread = new QThread(this);
+    workerThread->setObjectName("LogIndexer");
+    worker = new QObject();
+    worker->moveToThread(workerThread);
+    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    workerThread->start();
+}
+
+LogIndexer::~LogIndexer()
+{
+    workerThread->quit();
+    workerThread->wait();
+}
+
+void LogIndexer::schedule(const QString& directoryPath)
+{
+    pending.insert(directoryPath);
+    if (!indexTimer->isActive())
+        indexTimer->start();
+}
+
+int LogIndexer::search(const QString& directoryPath, const QByteArray& query, int maxHits)
+{
+    const int searchId = nextSearchId++;
+    QMetaObject::invokeMethod(
+        worker,
+        [this, directoryPath, query, maxHits, searchId]()
+        {
+            LogSearchIndex& index = indexFor(directoryPath);
+            index.update();
+            const QList<qint64> offsets = index.search(query, maxHits);
+
+            QMetaObject::invokeMethod(
+                this, [this, searchId, offsets]() { emit searchFinished(searchId, offsets); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+    return searchId;
+}
+
+int LogIndexer::filter(const QString& directoryPath, LogLevel minimum)
+{
+    const int filterId = nextSearchId++;
+    QMetaObject::invokeMethod(
+        worker,
+        [this, directoryPath, minimum, filterId]()
+        {
+            LogRecordIndex& index = recordIndexFor(directoryPath);
+            index.update();
+            const QList<qint64> offsets = index.filter(minimum);
+
+            QMetaObject::invokeMethod(
+                this, [this, filterId, offsets]() { emit filterFinished(filterId, offsets); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+    return filterId;
+}
+
+int LogIndexer::findTime(const QString& directoryPath, qint64 msecs)
+{
+    const int requestId = nextSearchId++;
+    QMetaObject::invokeMethod(
+        worker,
+        [this, directoryPath, msecs, requestId]()
+        {
+            LogRecordIndex& index = recordIndexFor(directoryPath);
+            index.update();
+            const qint64 offset = index.findTime(msecs);
+
+            QMetaObject::invokeMethod(
+                this, [this, requestId, offset]() { emit timeFound(requestId, offset); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+    return requestId;
+}
+
+void LogIndexer::indexPending()
+{
+    // Logs scheduled while a batch runs wait for the next one
+    if (indexInFlight)
+    {
+        indexTimer->start();
+        return;
+    }
+    if (pending.isEmpty())
+        return;
+
+    const QSet<QString> batch = pending;
+    pending.clear();
+    indexInFlight = true;
+
+    QMetaObject::invokeMethod(
+        worker,
+        [this, batch]()
+        {
+            for (const QString& directoryPath : batch)
+            {
+                indexFor(directoryPath).update();
+                recordIndexFor(directoryPath).update();
+
+                // Indexed from the mapped files first, then compressed
+                SegmentedLog(directoryPath).archiveFinished();
+            }
+
+            QMetaObject::invokeMethod(this, [this]() { indexInFlight = false; }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+LogSearchIndex& LogIndexer::indexFor(const QString& directoryPath)
+{
+    std::unique_ptr<LogSearchIndex>& index = indexes[directoryPath];
+    if (!index)
+        index = std::make_unique<LogSearchIndex>(directoryPath);
+    return *index;
+}
+
+LogRecordIndex& LogIndexer::recordIndexFor(const QString& directoryPath)
+{
+    std::unique_ptr<LogRecordIndex>& index = recordIndexes[directoryPath];
+    if (!index)
+        index = std::make_unique<LogRecordIndex>(directoryPath);
+    return *index;
+}
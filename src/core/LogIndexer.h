@@ -0,0 +1,64 @@
+#ifndef LOGINDEXER_H
+#define LOGINDEXER_H
+
+#include "LogRecordIndex.h"
+#include "LogSearchIndex.h"
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <map>
+#include <memory>
+
+// Keeps the search and record indexes of process logs up to date on a worker thread. Writers schedule()
+// a log after writing to it and its new output is indexed IndexDelayMs later, in one batch with every
+// other log scheduled meanwhile, and segments the writer has finished with are archived after. A query
+// brings the indexes of its log up to date first, so logs written before there was an index are
+// indexed by their first query.
+class LogIndexer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static LogIndexer& instance();
+
+    void schedule(const QString& directoryPath);
+    // Returns an id; the line offsets found arrive through searchFinished() with it
+    int search(const QString& directoryPath, const QByteArray& query, int maxHits = LogSearchIndex::MaxHits);
+    // Returns an id; the offsets of lines at minimum or above arrive through filterFinished() with it
+    int filter(const QString& directoryPath, LogLevel minimum);
+    // Returns an id; the first line stamped msecs or later arrives through timeFound() with it, -1 if none is
+    int findTime(const QString& directoryPath, qint64 msecs);
+
+    static constexpr int IndexDelayMs = 1000;
+
+  signals:
+    void searchFinished(int searchId, const QList<qint64>& offsets);
+    void filterFinished(int filterId, const QList<qint64>& offsets);
+    void timeFound(int requestId, qint64 offset);
+
+  private:
+    LogIndexer();
+    ~LogIndexer();
+    LogIndexer(const LogIndexer&) = delete;
+    LogIndexer& operator=(const LogIndexer&) = delete;
+
+    void indexPending();
+    // Worker thread only
+    LogSearchIndex& indexFor(const QString& directoryPath);
+    LogRecordIndex& recordIndexFor(const QString& directoryPath);
+
+    QSet<QString> pending;
+    QTimer* indexTimer = nullptr;
+    QThread* workerThread = nullptr;
+    QObject* worker = nullptr;
+    bool indexInFlight = false;
+    int nextSearchId = 1;
+
+    // Only touched on the worker thread, keyed by log directory
+    std::map<QString, std::unique_ptr<LogSearchIndex>> indexes;
+    std::map<QString, std::unique_ptr<LogRecordIndex>> recordIndexes;
+};
+
+#endif // LOGINDEXER_H
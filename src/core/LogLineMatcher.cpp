@@ -0,0 +1,101 @@
+#include "LogLineMatcher.h"
+#include "AnsiParser.h"
+#include <cstring>
+
+LogLineMatcher::LogLineMatcher(const QString& query)
+{
+    const QString text = query.trimmed();
+    if (text.size() >= 2 && text.startsWith('/') && text.endsWith('/'))
+    {
+        useRegex = true;
+        regex = QRegularExpression(text.mid(1, text.size() - 2), QRegularExpression::CaseInsensitiveOption);
+        regex.optimize();
+        return;
+    }
+
+    for (qsizetype position = 0; position < text.size();)
+    {
+        if (text.at(position).isSpace())
+        {
+            ++position;
+            continue;
+        }
+
+        const bool exclude =
+            text.at(position) == '-' && position + 1 < text.size() && !text.at(position + 1).isSpace();
+        if (exclude || text.at(position) == '+')
+            ++position;
+
+        qsizetype end = 0;
+        QString term;
+        if (position < text.size() && text.at(position) == '"')
+        {
+            end = text.indexOf('"', position + 1);
+            if (end < 0)
+                end = text.size();
+            term = text.mid(position + 1, end - position - 1);
+            ++end;
+        }
+        else
+        {
+            end = position;
+            while (end < text.size() && !text.at(end).isSpace())
+                ++end;
+            term = text.mid(position, end - position);
+        }
+        position = end;
+
+        if (!term.isEmpty())
+            (exclude ? excludes : includes).append(QByteArrayMatcher(term.toUtf8().toLower()));
+    }
+}
+
+bool LogLineMatcher::isEmpty() const
+{
+    return useRegex ? regex.pattern().isEmpty() : includes.isEmpty() && excludes.isEmpty();
+}
+
+bool LogLineMatcher::isValid() const
+{
+    return !useRegex || regex.isValid();
+}
+
+QString LogLineMatcher::errorString() const
+{
+    return useRegex ? regex.errorString() : QString();
+}
+
+bool LogLineMatcher::matches(const char* line, qsizetype size) const
+{
+    // Lines with colors are matched on their text
+    if (std::memchr(line, '\x1b', size))
+    {
+        const QString plain = AnsiParser::plainText(QByteArray::fromRawData(line, size));
+        if (useRegex)
+            return regex.match(plain).hasMatch();
+
+        lowered = plain.toUtf8().toLower();
+    }
+    else
+    {
+        if (useRegex)
+            return regex.match(QString::fromUtf8(line, size)).hasMatch();
+
+        lowered.resize(size);
+        char* data = lowered.data();
+        for (qsizetype i = 0; i < size; ++i)
+            data[i] = line[i] >= 'A' && line[i] <= 'Z' ? char(line[i] + ('a' - 'A')) : line[i];
+    }
+
+    for (const QByteArrayMatcher& include : includes)
+    {
+        if (include.indexIn(lowered.constData(), lowered.size()) < 0)
+            return false;
+    }
+    for (const QByteArrayMatcher& exclude : excludes)
+    {
+        if (exclude.indexIn(lowered.constData(), lowered.size()) >= 0)
+            return false;
+    }
+    return true;
+}
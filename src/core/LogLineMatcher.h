@@ -0,0 +1,37 @@
+#ifndef LOGLINEMATCHER_H
+#define LOGLINEMATCHER_H
+
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+
+// Query of the log filter bar. "/expression/" is a regular expression; anything else is a list of
+// space separated terms, "quoted" ones may contain spaces, and a line matches if it contains every
+// term and none of the terms starting with '-'. Case is ignored, and so are colors, so escape
+// sequences do not break up words or anchors. Copies are independent; each thread matching lines
+// needs its own.
+class LogLineMatcher
+{
+  public:
+    LogLineMatcher() = default;
+    explicit LogLineMatcher(const QString& query);
+
+    bool isEmpty() const;
+    // False for a regular expression that does not compile
+    bool isValid() const;
+    QString errorString() const;
+
+    // line is without its line ending
+    bool matches(const char* line, qsizetype size) const;
+
+  private:
+    bool useRegex = false;
+    QRegularExpression regex;
+    QList<QByteArrayMatcher> includes;
+    QList<QByteArrayMatcher> excludes;
+    mutable QByteArray lowered;
+};
+
+#endif // LOGLINEMATCHER_H
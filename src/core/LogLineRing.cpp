@@ -0,0 +1,89 @@
+#include "LogLineRing.h"
+#include <cstring>
+
+LogLineRing::LogLineRing(int lineCapacity, int byteCapacity)
+    : lines(qMax(lineCapacity, 1)), bytesSize(qMax(byteCapacity, 4)), records(new Record[lines]),
+      bytes(new char[bytesSize])
+{
+}
+
+quint64 LogLineRing::append(const char* data, qsizetype length, qint64 fileOffset)
+{
+    const int stored = static_cast<int>(qMin<qsizetype>(length, bytesSize / 4));
+    const quint64 sequence = head.load(std::memory_order_relaxed);
+    const quint64 position = reservedBytes.load(std::memory_order_relaxed);
+    Record& record = records[sequence % lines];
+
+    // Invalidate the record and claim the bytes before touching either
+    record.sequence.store(0, std::memory_order_relaxed);
+    reservedBytes.store(position + stored, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const int offset = static_cast<int>(position % bytesSize);
+    const int firstPart = qMin(stored, bytesSize - offset);
+    std::memcpy(bytes.get() + offset, data, firstPart);
+    std::memcpy(bytes.get(), data + firstPart, stored - firstPart);
+
+    record.fileOffset.store(fileOffset, std::memory_order_relaxed);
+    record.bytePosition.store(position, std::memory_order_relaxed);
+    record.length.store(stored, std::memory_order_relaxed);
+    record.sequence.store(sequence, std::memory_order_release);
+    head.store(sequence + 1, std::memory_order_release);
+    return sequence;
+}
+
+quint64 LogLineRing::nextSequence() const
+{
+    return head.load(std::memory_order_acquire);
+}
+
+QList<LogLine> LogLineRing::readFrom(quint64 sequence, int maxLines) const
+{
+    QList<LogLine> result;
+    const quint64 end = head.load(std::memory_order_acquire);
+    const quint64 oldest = end > quint64(lines) ? end - lines : 1;
+
+    for (quint64 current = qMax(sequence, oldest); current < end && result.size() < maxLines; ++current)
+    {
+        const Record& record = records[current % lines];
+        if (record.sequence.load(std::memory_order_acquire) != current)
+            continue;
+
+        const quint64 position = record.bytePosition.load(std::memory_order_relaxed);
+        const int length = record.length.load(std::memory_order_relaxed);
+        const qint64 fileOffset = record.fileOffset.load(std::memory_order_relaxed);
+        if (reservedBytes.load(std::memory_order_relaxed) - position > quint64(bytesSize))
+            continue;
+
+        QByteArray text(length, Qt::Uninitialized);
+        copyBytes(position, text.data(), length);
+
+        // The copy only counts if neither the record nor its bytes were reused while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) != current ||
+            reservedBytes.load(std::memory_order_relaxed) - position > quint64(bytesSize))
+            continue;
+
+        result.append({current, fileOffset, text});
+    }
+
+    return result;
+}
+
+int LogLineRing::lineCapacity() const
+{
+    return lines;
+}
+
+int LogLineRing::byteCapacity() const
+{
+    return bytesSize;
+}
+
+void LogLineRing::copyBytes(quint64 position, char* target, int length) const
+{
+    const int offset = static_cast<int>(position % bytesSize);
+    const int firstPart = qMin(length, bytesSize - offset);
+    std::memcpy(target, bytes.get() + offset, firstPart);
+    std::memcpy(target + firstPart, bytes.get(), length - firstPart);
+}
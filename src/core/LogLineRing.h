@@ -0,0 +1,65 @@
+#ifndef LOGLINERING_H
+#define LOGLINERING_H
+
+#include <QByteArray>
+#include <QList>
+#include <atomic>
+#include <limits>
+#include <memory>
+
+// One line of process output together with where it starts in the process log file
+struct LogLine
+{
+    quint64 sequence = 0;
+    qint64 fileOffset = 0;
+    QByteArray text;
+};
+
+// Fixed-capacity ring of the most recent output lines of one process. A single producer appends
+// without locking and any number of readers on any thread copy lines out; like a seqlock, a reader
+// checks after copying that the producer has not reused the record or its bytes meanwhile. Lines
+// are numbered from 1; once the ring is full the oldest lines are overwritten and readers see a gap.
+class LogLineRing
+{
+  public:
+    explicit LogLineRing(int lineCapacity = LineCapacity, int byteCapacity = ByteCapacity);
+    LogLineRing(const LogLineRing&) = delete;
+    LogLineRing& operator=(const LogLineRing&) = delete;
+
+    // Producer only. Lines longer than a quarter of the byte capacity are truncated.
+    quint64 append(const char* data, qsizetype length, qint64 fileOffset);
+
+    // Sequence the next appended line will get
+    quint64 nextSequence() const;
+
+    // Lines from sequence onwards that are still in the ring, oldest first
+    QList<LogLine> readFrom(quint64 sequence, int maxLines = std::numeric_limits<int>::max()) const;
+
+    int lineCapacity() const;
+    int byteCapacity() const;
+
+    static constexpr int LineCapacity = 4096;
+    static constexpr int ByteCapacity = 1024 * 1024;
+
+  private:
+    struct Record
+    {
+        // The sequence stored in the record, 0 while it is being rewritten
+        std::atomic<quint64> sequence{0};
+        std::atomic<qint64> fileOffset{0};
+        std::atomic<quint64> bytePosition{0};
+        std::atomic<int> length{0};
+    };
+
+    void copyBytes(quint64 position, char* target, int length) const;
+
+    const int lines;
+    const int bytesSize;
+    std::unique_ptr<Record[]> records;
+    std::unique_ptr<char[]> bytes;
+    std::atomic<quint64> head{1};
+    // Total bytes ever claimed; a byte range is reused once this passes its position plus the capacity
+    std::atomic<quint64> reservedBytes{0};
+};
+
+#endif // LOGLINERING_H
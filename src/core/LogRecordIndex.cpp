@@ -0,0 +1,281 @@
+#include "LogRecordIndex.h"
+#include "Logger.h"
+#include "SegmentReader.h"
+#include <QDataStream>
+#include <QSaveFile>
+#include <cstring>
+
+namespace
+{
+    const QString IndexExtension = "rec";
+    constexpr quint32 IndexMagic = 0x4C524543; // "LREC"
+    constexpr quint32 IndexVersion = 1;
+
+    void appendVarint(QByteArray& column, quint64 value)
+    {
+        while (value >= 0x80)
+        {
+            column.append(char(value | 0x80));
+            value >>= 7;
+        }
+        column.append(char(value));
+    }
+
+    quint64 readVarint(const char* column, qsizetype& position)
+    {
+        quint64 value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            const uchar byte = static_cast<uchar>(column[position++]);
+            value |= quint64(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+    }
+
+    // Small negative deltas, out of order lines, stay small
+    quint64 zigzag(qint64 value)
+    {
+        return (quint64(value) << 1) ^ quint64(value >> 63);
+    }
+
+    qint64 unzigzag(quint64 value)
+    {
+        return qint64(value >> 1) ^ -qint64(value & 1);
+    }
+}
+
+LogRecordIndex::LogRecordIndex(const QString& directoryPath)
+    : SidecarIndex(directoryPath, IndexExtension, SaveIntervalLines)
+{
+}
+
+LogRecordIndex::~LogRecordIndex()
+{
+    saveAll();
+}
+
+qint64 LogRecordIndex::update()
+{
+    return updateSegments();
+}
+
+QList<qint64> LogRecordIndex::filter(LogLevel minimum, const QByteArray& logger, int maxLines) const
+{
+    QList<qint64> offsets;
+    if (maxLines <= 0)
+        return offsets;
+
+    const qint64 floor = log.startOffset();
+    for (const SegmentRecords& records : segmentIndexes)
+    {
+        if (records.segment.startOffset + records.indexedSize <= floor)
+            continue;
+
+        quint32 loggerId = 0;
+        if (!logger.isEmpty() && !(loggerId = records.loggerIds.value(logger)))
+            continue;
+
+        const char* levels = records.levels.constData();
+        const char* lengths = records.lineLengths.constData();
+        const char* loggers = records.lineLoggers.constData();
+        qsizetype lengthPosition = 0;
+        qsizetype loggerPosition = 0;
+        qint64 offset = records.segment.startOffset;
+        for (qint64 line = 0; line < records.lineCount; ++line)
+        {
+            const qint64 length = qint64(readVarint(lengths, lengthPosition));
+            const quint32 lineLogger = loggerId ? quint32(readVarint(loggers, loggerPosition)) : 0;
+            if (static_cast<uchar>(levels[line]) >= static_cast<uchar>(minimum) && lineLogger == loggerId &&
+                offset >= floor)
+            {
+                offsets.append(offset);
+            }
+            offset += length;
+        }
+
+        // Only the newest maxLines are kept; trimming per segment bounds memory on a noisy log
+        if (offsets.size() > 2 * qsizetype(maxLines))
+            offsets.remove(0, offsets.size() - maxLines);
+    }
+
+    if (offsets.size() > maxLines)
+        offsets.remove(0, offsets.size() - maxLines);
+    return offsets;
+}
+
+qint64 LogRecordIndex::findTime(qint64 msecs) const
+{
+    const qint64 floor = log.startOffset();
+    for (const SegmentRecords& records : segmentIndexes)
+    {
+        if (records.maxTimestamp < msecs || records.segment.startOffset + records.indexedSize <= floor)
+            continue;
+
+        const char* lengths = records.lineLengths.constData();
+        const char* deltas = records.timestampDeltas.constData();
+        qsizetype lengthPosition = 0;
+        qsizetype deltaPosition = 0;
+        qint64 timestamp = 0;
+        qint64 offset = records.segment.startOffset;
+        for (qint64 line = 0; line < records.lineCount; ++line)
+        {
+            timestamp += unzigzag(readVarint(deltas, deltaPosition));
+            if (timestamp != 0 && timestamp >= msecs && offset >= floor)
+                return offset;
+            offset += qint64(readVarint(lengths, lengthPosition));
+        }
+    }
+    return -1;
+}
+
+qint64 LogRecordIndex::lineCount() const
+{
+    qint64 lines = 0;
+    for (const SegmentRecords& records : segmentIndexes)
+        lines += records.lineCount;
+    return lines;
+}
+
+qint64 LogRecordIndex::indexSegment(SegmentRecords& records, const SegmentRecords* previous, bool finished)
+{
+    // A stack trace may continue in the next segment
+    if (records.lineCount == 0 && previous)
+    {
+        records.lastLevel = previous->lastLevel;
+        records.lastTimestamp = previous->lastTimestamp;
+    }
+
+    if (records.indexedSize >= records.segment.size)
+        return 0;
+
+    // Only the bytes not parsed yet are read
+    const qint64 base = records.indexedSize;
+    SegmentReader reader(log, records.segment, finished, records.segment.size);
+    const QByteArray text = reader.open() ? reader.read(base, records.segment.size - base) : QByteArray();
+    const char* data = text.constData();
+
+    // A line still being written is parsed once it is complete or its segment is finished
+    const qint64 end = finished ? text.size() : text.lastIndexOf('\n') + 1;
+
+    const qint64 firstLine = records.lineCount;
+    qint64 position = 0;
+    while (position < end)
+    {
+        const void* newline = std::memchr(data + position, '\n', end - position);
+        const qint64 lineEnd = newline ? static_cast<const char*>(newline) - data + 1 : end;
+        qint64 textEnd = newline ? lineEnd - 1 : lineEnd;
+        if (textEnd > position && data[textEnd - 1] == '\r')
+            --textEnd;
+
+        const LogRecord record = parser.parse(data + position, textEnd - position);
+        const bool continuation = record.level == LogLevel::Unknown && record.timestamp == 0;
+        const LogLevel level = continuation ? records.lastLevel : record.level;
+        const qint64 timestamp = record.timestamp != 0 ? record.timestamp : records.lastTimestamp;
+
+        quint32 loggerId = continuation ? records.lastLoggerId : 0;
+        if (!record.logger.isEmpty())
+        {
+            auto known = records.loggerIds.constFind(record.logger);
+            if (known == records.loggerIds.constEnd())
+            {
+                records.loggers.append(record.logger);
+                loggerId = quint32(records.loggers.size());
+                records.loggerIds.insert(record.logger, loggerId);
+            }
+            else
+            {
+                loggerId = *known;
+            }
+        }
+
+        // Deltas restart from 0 in every segment so each decodes on its own
+        const qint64 previousTimestamp = records.lineCount > 0 ? records.lastTimestamp : 0;
+        records.levels.append(char(level));
+        appendVarint(records.lineLengths, quint64(lineEnd - position));
+        appendVarint(records.timestampDeltas, zigzag(timestamp - previousTimestamp));
+        appendVarint(records.lineLoggers, loggerId);
+
+        records.lastLevel = level;
+        records.lastTimestamp = timestamp;
+        records.lastLoggerId = loggerId;
+        records.maxTimestamp = qMax(records.maxTimestamp, timestamp);
+        ++records.lineCount;
+        position = lineEnd;
+    }
+
+    records.indexedSize = base + end;
+    return records.lineCount - firstLine;
+}
+
+qint64 LogRecordIndex::unsaved(const SegmentRecords& records) const
+{
+    return records.lineCount - records.savedLineCount;
+}
+
+bool LogRecordIndex::load(SegmentRecords& records) const
+{
+    QFile file(sidecarPath(records));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString fileName;
+    quint64 fileId = 0;
+    qint64 indexedSize = 0;
+    quint8 lastLevel = 0;
+    stream >> magic >> version;
+    if (magic != IndexMagic || version != IndexVersion)
+        return false;
+    stream >> fileName >> fileId >> indexedSize >> records.lineCount >> lastLevel >> records.lastTimestamp >>
+        records.lastLoggerId >> records.maxTimestamp >> records.levels >> records.lineLengths >>
+        records.timestampDeltas >> records.loggers >> records.lineLoggers;
+
+    // A damaged index, or one of another file with the same name, is rebuilt
+    if (stream.status() != QDataStream::Ok || fileName != records.segment.fileName ||
+        fileId != records.segment.fileId || indexedSize > records.segment.size ||
+        records.levels.size() != records.lineCount)
+    {
+        const LogSegment segment = records.segment;
+        records = SegmentRecords();
+        records.segment = segment;
+        return false;
+    }
+
+    records.indexedSize = indexedSize;
+    records.savedLineCount = records.lineCount;
+    records.lastLevel = static_cast<LogLevel>(lastLevel);
+    for (qsizetype i = 0; i < records.loggers.size(); ++i)
+        records.loggerIds.insert(records.loggers.at(i), quint32(i + 1));
+    return true;
+}
+
+bool LogRecordIndex::save(SegmentRecords& records) const
+{
+    QSaveFile file(sidecarPath(records));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING_IN(Logs, "Failed to write record index " + file.fileName() + ": " + file.errorString());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << IndexMagic << IndexVersion << records.segment.fileName << records.segment.fileId
+           << records.indexedSize << records.lineCount << quint8(records.lastLevel) << records.lastTimestamp
+           << records.lastLoggerId << records.maxTimestamp << records.levels << records.lineLengths
+           << records.timestampDeltas << records.loggers << records.lineLoggers;
+
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        LOG_WARNING_IN(Logs, "Failed to write record index " + file.fileName() + ": " + file.errorString());
+        return false;
+    }
+
+    records.savedLineCount = records.lineCount;
+    return true;
+}
@@ -0,0 +1,70 @@
+#ifndef LOGRECORDINDEX_H
+#define LOGRECORDINDEX_H
+
+#include "LogRecordParser.h"
+#include "SidecarIndex.h"
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+// What LogRecordIndex keeps of one segment
+struct LogRecordSegment
+{
+    LogSegment segment;
+    qint64 indexedSize = 0;
+    qint64 lineCount = 0;
+    qint64 savedLineCount = 0;
+    // Carried into the next line that has none of its own
+    LogLevel lastLevel = LogLevel::Unknown;
+    qint64 lastTimestamp = 0;
+    quint32 lastLoggerId = 0;
+    qint64 maxTimestamp = 0;
+    QByteArray levels;
+    QByteArray lineLengths;
+    QByteArray timestampDeltas;
+    // Id 0 is no logger, id n is loggers[n - 1]
+    QList<QByteArray> loggers;
+    QHash<QByteArray, quint32> loggerIds;
+    QByteArray lineLoggers;
+};
+
+// Columnar side index of what LogRecordParser finds in every line of a SegmentedLog, so filtering by
+// level or jumping to a time never reads the log itself. Per segment it keeps one level byte per line,
+// line lengths as varints, timestamps as zigzag varint deltas and logger names as varint ids into a
+// dictionary: a few bytes per line. Lines a parser finds nothing in, like the rest of a stack trace,
+// take the level and timestamp of the line before. Like LogSearchIndex it is saved next to each
+// segment, as a .rec sidecar, and update() extends it with new output. Not thread-safe; LogIndexer
+// keeps these on its worker.
+class LogRecordIndex : public SidecarIndex<LogRecordSegment>
+{
+  public:
+    explicit LogRecordIndex(const QString& directoryPath);
+    // Saves what was indexed since the last save
+    ~LogRecordIndex();
+
+    // Parses the new output of every segment; returns the number of lines indexed
+    qint64 update();
+
+    // Start offsets of the last maxLines indexed lines at minimum or above, and of logger unless it is
+    // empty, oldest first
+    QList<qint64> filter(LogLevel minimum, const QByteArray& logger = QByteArray(), int maxLines = MaxLines) const;
+    // Start of the first indexed line stamped msecs or later, or -1
+    qint64 findTime(qint64 msecs) const;
+
+    qint64 lineCount() const;
+
+    static constexpr qint64 SaveIntervalLines = 10000;
+    static constexpr int MaxLines = 1000000;
+
+  private:
+    using SegmentRecords = LogRecordSegment;
+
+    qint64 indexSegment(SegmentRecords& records, const SegmentRecords* previous, bool finished) override;
+    qint64 unsaved(const SegmentRecords& records) const override;
+    bool load(SegmentRecords& records) const override;
+    bool save(SegmentRecords& records) const override;
+
+    LogRecordParser parser;
+};
+
+#endif // LOGRECORDINDEX_H
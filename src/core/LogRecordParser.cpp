@@ -0,0 +1,425 @@
+#include "LogRecordParser.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    // Level, timestamp and logger of a text line are expected this close to its start
+    constexpr qsizetype HeadBytes = 256;
+    constexpr int LevelTokens = 4;
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    bool isLetter(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    char lower(char c)
+    {
+        return c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
+    }
+
+    bool readNumber(const char* text, int digits, int& value)
+    {
+        value = 0;
+        for (int i = 0; i < digits; ++i)
+        {
+            if (!isDigit(text[i]))
+                return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
+    // Days from 1970-01-01 to a date of the proleptic Gregorian calendar
+    qint64 daysFromCivil(int year, int month, int day)
+    {
+        year -= month <= 2;
+        const qint64 era = (year >= 0 ? year : year - 399) / 400;
+        const qint64 yearOfEra = year - era * 400;
+        const qint64 dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const qint64 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // Copies the start of a line without its ANSI escape sequences
+    qsizetype stripEscapes(const char* line, qsizetype size, char* head, qsizetype capacity)
+    {
+        qsizetype length = 0;
+        for (qsizetype i = 0; i < size && length < capacity; ++i)
+        {
+            if (line[i] == '\x1b' && i + 1 < size && line[i + 1] == '[')
+            {
+                for (i += 2; i < size && !(line[i] >= 0x40 && line[i] <= 0x7e); ++i)
+                {
+                }
+                continue;
+            }
+            head[length++] = line[i];
+        }
+        return length;
+    }
+
+    const char* find(const char* text, const char* end, const char* pattern, qsizetype patternSize)
+    {
+        const char* found = std::search(text, end, pattern, pattern + patternSize);
+        return found == end ? nullptr : found;
+    }
+
+    // Value of "key" anywhere in a JSON line, strings without their quotes
+    bool jsonValue(const char* line, qsizetype size, const char* key, const char*& value, qsizetype& length)
+    {
+        char pattern[32];
+        const int patternSize = std::snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+        const char* end = line + size;
+
+        for (const char* found = find(line, end, pattern, patternSize); found;
+             found = find(found + patternSize, end, pattern, patternSize))
+        {
+            const char* position = found + patternSize;
+            while (position < end && *position == ' ')
+                ++position;
+            // The key appeared as a value
+            if (position == end || *position != ':')
+                continue;
+            ++position;
+            while (position < end && *position == ' ')
+                ++position;
+
+            if (position < end && *position == '"')
+            {
+                const char* close = position + 1;
+                while (close < end && *close != '"')
+                    close += *close == '\\' ? 2 : 1;
+                if (close >= end)
+                    return false;
+                value = position + 1;
+                length = close - value;
+                return true;
+            }
+
+            const char* close = position;
+            while (close < end && *close != ',' && *close != '}' && *close != ' ')
+                ++close;
+            value = position;
+            length = close - position;
+            return length > 0;
+        }
+        return false;
+    }
+
+    // Value of key=value at the start of a line or after a space, quotes removed
+    bool logfmtValue(const char* line, qsizetype size, const char* key, const char*& value, qsizetype& length)
+    {
+        char pattern[32];
+        const int patternSize = std::snprintf(pattern, sizeof(pattern), "%s=", key);
+        const char* end = line + size;
+
+        for (const char* found = find(line, end, pattern, patternSize); found;
+             found = find(found + patternSize, end, pattern, patternSize))
+        {
+            if (found != line && found[-1] != ' ')
+                continue;
+
+            const char* position = found + patternSize;
+            const char quote = position < end && *position == '"' ? '"' : ' ';
+            if (quote == '"')
+                ++position;
+            const char* close = position;
+            while (close < end && *close != quote)
+                ++close;
+            value = position;
+            length = close - position;
+            return length > 0;
+        }
+        return false;
+    }
+}
+
+LogRecord LogRecordParser::parse(const char* line, qsizetype size)
+{
+    LogRecord record;
+
+    qsizetype start = 0;
+    while (start < size && (line[start] == ' ' || line[start] == '\t'))
+        ++start;
+    if (start < size && line[start] == '{' && parseJson(line, size, record))
+        return record;
+
+    char head[HeadBytes];
+    const qsizetype length = stripEscapes(line, size, head, HeadBytes);
+    if (parseLogfmt(head, length, record))
+        return record;
+
+    qsizetype textStart = 0;
+    while (textStart < length && (head[textStart] == ' ' || head[textStart] == '\t'))
+        ++textStart;
+    parseText(head + textStart, length - textStart, record);
+    return record;
+}
+
+LogLevel LogRecordParser::levelFromName(const char* name, qsizetype size)
+{
+    static const struct
+    {
+        const char* name;
+        LogLevel level;
+    } names[] = {{"trace", LogLevel::Trace},    {"debug", LogLevel::Debug},   {"dbg", LogLevel::Debug},
+                 {"verbose", LogLevel::Debug},  {"info", LogLevel::Info},     {"inf", LogLevel::Info},
+                 {"information", LogLevel::Info}, {"notice", LogLevel::Info}, {"warn", LogLevel::Warning},
+                 {"warning", LogLevel::Warning}, {"wrn", LogLevel::Warning},  {"error", LogLevel::Error},
+                 {"err", LogLevel::Error},      {"fatal", LogLevel::Fatal},   {"critical", LogLevel::Fatal},
+                 {"crit", LogLevel::Fatal},     {"panic", LogLevel::Fatal},   {"emerg", LogLevel::Fatal}};
+
+    char word[16];
+    if (size <= 0 || size >= qsizetype(sizeof(word)))
+        return LogLevel::Unknown;
+
+    bool numeric = true;
+    for (qsizetype i = 0; i < size; ++i)
+    {
+        word[i] = lower(name[i]);
+        numeric = numeric && isDigit(name[i]);
+    }
+    word[size] = '\0';
+
+    // pino and bunyan write levels as numbers
+    if (numeric)
+    {
+        const int value = std::atoi(word);
+        if (value >= 60)
+            return LogLevel::Fatal;
+        if (value >= 50)
+            return LogLevel::Error;
+        if (value >= 40)
+            return LogLevel::Warning;
+        if (value >= 30)
+            return LogLevel::Info;
+        if (value >= 20)
+            return LogLevel::Debug;
+        return value >= 10 ? LogLevel::Trace : LogLevel::Unknown;
+    }
+
+    for (const auto& entry : names)
+    {
+        if (std::strcmp(word, entry.name) == 0)
+            return entry.level;
+    }
+    return LogLevel::Unknown;
+}
+
+QString LogRecordParser::levelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace:
+        return "TRACE";
+    case LogLevel::Debug:
+        return "DEBUG";
+    case LogLevel::Info:
+        return "INFO";
+    case LogLevel::Warning:
+        return "WARN";
+    case LogLevel::Error:
+        return "ERROR";
+    case LogLevel::Fatal:
+        return "FATAL";
+    case LogLevel::Unknown:
+        break;
+    }
+    return QString();
+}
+
+qint64 LogRecordParser::parseDateTime(const char* text, qsizetype size)
+{
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (size < 19 || !readNumber(text, 4, year) || (text[4] != '-' && text[4] != '/') ||
+        !readNumber(text + 5, 2, month) || text[7] != text[4] || !readNumber(text + 8, 2, day) ||
+        (text[10] != 'T' && text[10] != ' ') || !readNumber(text + 11, 2, hour) || text[13] != ':' ||
+        !readNumber(text + 14, 2, minute) || text[16] != ':' || !readNumber(text + 17, 2, second))
+    {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60)
+        return 0;
+
+    qsizetype position = 19;
+    int milliseconds = 0;
+    if (position < size && (text[position] == '.' || text[position] == ','))
+    {
+        int scale = 100;
+        for (++position; position < size && isDigit(text[position]); ++position)
+        {
+            milliseconds += (text[position] - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    // Z, +02:00 or +0200; without one the time is local
+    int zoneMinutes = 0;
+    bool zoned = false;
+    if (position < size && text[position] == 'Z')
+    {
+        zoned = true;
+    }
+    else if (position + 5 <= size && (text[position] == '+' || text[position] == '-'))
+    {
+        int zoneHours = 0;
+        const qsizetype minutesAt = position + (text[position + 3] == ':' ? 4 : 3);
+        if (readNumber(text + position + 1, 2, zoneHours) && minutesAt + 2 <= size &&
+            readNumber(text + minutesAt, 2, zoneMinutes))
+        {
+            zoneMinutes = (text[position] == '-' ? -1 : 1) * (zoneHours * 60 + zoneMinutes);
+            zoned = true;
+        }
+    }
+
+    const qint64 withinHour = (qint64(minute) * 60 + second) * 1000 + milliseconds;
+    if (zoned)
+        return (daysFromCivil(year, month, day) * 24 + hour) * 3600000 + withinHour - zoneMinutes * 60000LL;
+
+    // Local time goes through QDateTime once per hour of log, not once per line
+    const qint64 hourKey = ((qint64(year) * 13 + month) * 32 + day) * 24 + hour;
+    if (hourKey != cachedHour)
+    {
+        cachedHour = hourKey;
+        cachedHourStart = QDateTime(QDate(year, month, day), QTime(hour, 0)).toMSecsSinceEpoch();
+    }
+    return cachedHourStart + withinHour;
+}
+
+bool LogRecordParser::parseJson(const char* line, qsizetype size, LogRecord& record)
+{
+    const char* value = nullptr;
+    qsizetype length = 0;
+
+    for (const char* key : {"level", "lvl", "severity", "levelname"})
+    {
+        if (jsonValue(line, size, key, value, length))
+        {
+            record.level = levelFromName(value, length);
+            break;
+        }
+    }
+    for (const char* key : {"time", "timestamp", "ts", "@timestamp"})
+    {
+        if (jsonValue(line, size, key, value, length) && (record.timestamp = parseTimeValue(value, length)))
+            break;
+    }
+    for (const char* key : {"logger", "logger_name", "loggerName", "context", "name"})
+    {
+        if (jsonValue(line, size, key, value, length))
+        {
+            record.logger = QByteArray(value, length);
+            break;
+        }
+    }
+    return record.level != LogLevel::Unknown || record.timestamp != 0;
+}
+
+bool LogRecordParser::parseLogfmt(const char* line, qsizetype size, LogRecord& record)
+{
+    const char* value = nullptr;
+    qsizetype length = 0;
+    if (!logfmtValue(line, size, "level", value, length) && !logfmtValue(line, size, "lvl", value, length))
+        return false;
+    record.level = levelFromName(value, length);
+
+    for (const char* key : {"time", "ts", "timestamp"})
+    {
+        if (logfmtValue(line, size, key, value, length) && (record.timestamp = parseTimeValue(value, length)))
+            break;
+    }
+    for (const char* key : {"logger", "module", "component"})
+    {
+        if (logfmtValue(line, size, key, value, length))
+        {
+            record.logger = QByteArray(value, length);
+            break;
+        }
+    }
+    return true;
+}
+
+void LogRecordParser::parseText(const char* line, qsizetype size, LogRecord& record)
+{
+    qsizetype position = 0;
+    if (position < size && line[position] == '[')
+        ++position;
+    if ((record.timestamp = parseDateTime(line + position, size - position)))
+    {
+        // Past the fraction and zone too
+        position += 19;
+        while (position < size && line[position] != ' ' && line[position] != ']')
+            ++position;
+    }
+
+    // The level is one of the first words: [warn], WARN, or a label like "Error:" starting the message
+    for (int tokens = 0; tokens < LevelTokens && position < size; ++tokens)
+    {
+        while (position < size && !isLetter(line[position]))
+            ++position;
+        const qsizetype begin = position;
+        while (position < size && isLetter(line[position]))
+            ++position;
+        if (begin == position)
+            break;
+
+        const LogLevel level = levelFromName(line + begin, position - begin);
+        if (level == LogLevel::Unknown)
+            continue;
+
+        const bool bracketed = begin > 0 && (line[begin - 1] == '[' || line[begin - 1] == '<') && position < size &&
+                               (line[position] == ']' || line[position] == '>');
+        const bool uppercase = std::all_of(line + begin, line + position, [](char c) { return c >= 'A' && c <= 'Z'; });
+        const bool label = tokens == 0 && position < size && line[position] == ':';
+        if (!bracketed && !(uppercase && position - begin >= 3) && !label)
+            continue;
+
+        record.level = level;
+
+        // python's LEVEL:logger:message
+        if (position < size && line[position] == ':')
+        {
+            const char* loggerStart = line + position + 1;
+            const char* loggerEnd = loggerStart;
+            while (loggerEnd < line + size && *loggerEnd != ':' && *loggerEnd != ' ')
+                ++loggerEnd;
+            if (loggerEnd < line + size && *loggerEnd == ':' && loggerEnd > loggerStart)
+                record.logger = QByteArray(loggerStart, loggerEnd - loggerStart);
+            return;
+        }
+
+        // log4j's LEVEL logger - message
+        qsizetype loggerStart = position + (bracketed ? 1 : 0);
+        while (loggerStart < size && line[loggerStart] == ' ')
+            ++loggerStart;
+        qsizetype loggerEnd = loggerStart;
+        while (loggerEnd < size && line[loggerEnd] != ' ')
+            ++loggerEnd;
+        if (loggerEnd > loggerStart && loggerEnd + 2 < size && line[loggerEnd + 1] == '-' && line[loggerEnd + 2] == ' ')
+            record.logger = QByteArray(line + loggerStart, loggerEnd - loggerStart);
+        return;
+    }
+}
+
+qint64 LogRecordParser::parseTimeValue(const char* value, qsizetype size)
+{
+    // Epoch seconds, fractional or not, or epoch milliseconds
+    qsizetype digits = 0;
+    while (digits < size && isDigit(value[digits]))
+        ++digits;
+    if (digits >= 9 && (digits == size || value[digits] == '.'))
+    {
+        const double number = QByteArray(value, size).toDouble();
+        return qint64(digits >= 12 ? number : number * 1000);
+    }
+    return parseDateTime(value, size);
+}
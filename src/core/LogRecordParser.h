@@ -0,0 +1,51 @@
+#ifndef LOGRECORDPARSER_H
+#define LOGRECORDPARSER_H
+
+#include <QByteArray>
+#include <QString>
+
+enum class LogLevel : quint8
+{
+    Unknown = 0,
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Fatal
+};
+
+// What a log line says about itself
+struct LogRecord
+{
+    LogLevel level = LogLevel::Unknown;
+    qint64 timestamp = 0; // ms since epoch, 0 if the line has none
+    QByteArray logger;
+};
+
+// Recognises the formats our services write: JSON lines (level, time and logger keys, pino's numeric
+// levels), logfmt (level=, time=, logger=) and text lines starting with an ISO 8601 timestamp and
+// carrying a [level], an uppercase LEVEL or a leading "Error:"-style word, with python's LEVEL:logger:
+// and log4j's LEVEL logger - message for the logger. Colors are ignored. Timestamps without a zone are
+// local time. Not thread-safe: it caches the start of the last local hour it converted.
+class LogRecordParser
+{
+  public:
+    LogRecord parse(const char* line, qsizetype size);
+
+    static LogLevel levelFromName(const char* name, qsizetype size);
+    static QString levelName(LogLevel level);
+    // "2024-05-01 12:00:00", "2024-05-01T12:00:00.123Z", "2024/05/01 12:00:00,123+02:00"; 0 if there is none
+    qint64 parseDateTime(const char* text, qsizetype size);
+
+  private:
+    bool parseJson(const char* line, qsizetype size, LogRecord& record);
+    bool parseLogfmt(const char* line, qsizetype size, LogRecord& record);
+    void parseText(const char* line, qsizetype size, LogRecord& record);
+    qint64 parseTimeValue(const char* value, qsizetype size);
+
+    qint64 cachedHour = -1;
+    qint64 cachedHourStart = 0;
+};
+
+#endif // LOGRECORDPARSER_H
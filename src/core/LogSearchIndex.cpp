@@ -0,0 +1,234 @@
+#include "LogSearchIndex.h"
+#include "Logger.h"
+#include "SegmentReader.h"
+#include <QByteArrayMatcher>
+#include <QDataStream>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const QString IndexExtension = "tri";
+    constexpr quint32 IndexMagic = 0x4C545249; // "LTRI"
+    constexpr quint32 IndexVersion = 2;
+
+    uchar folded(char c)
+    {
+        const uchar byte = static_cast<uchar>(c);
+        return byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte;
+    }
+
+    // Trigrams with control characters, newlines and escapes among them, are not indexed; a query
+    // containing one is narrowed down by its other trigrams
+    bool trigramAt(const char* data, quint32& key)
+    {
+        const uchar first = folded(data[0]);
+        const uchar second = folded(data[1]);
+        const uchar third = folded(data[2]);
+        if (first < 0x20 || second < 0x20 || third < 0x20)
+            return false;
+
+        key = (quint32(first) << 16) | (quint32(second) << 8) | third;
+        return true;
+    }
+}
+
+LogSearchIndex::LogSearchIndex(const QString& directoryPath)
+    : SidecarIndex(directoryPath, IndexExtension, SaveIntervalBytes)
+{
+}
+
+LogSearchIndex::~LogSearchIndex()
+{
+    saveAll();
+}
+
+qint64 LogSearchIndex::update()
+{
+    return updateSegments();
+}
+
+QList<qint64> LogSearchIndex::search(const QByteArray& query, int maxHits) const
+{
+    QList<qint64> hits;
+    const QByteArray needle = query.toLower();
+    if (needle.isEmpty() || maxHits <= 0)
+        return hits;
+
+    QList<quint32> trigrams;
+    for (qsizetype i = 0; i + 2 < needle.size(); ++i)
+    {
+        quint32 key = 0;
+        if (trigramAt(needle.constData() + i, key))
+            trigrams.append(key);
+    }
+
+    // Newest first, so hitting maxHits drops the oldest matches
+    const QByteArrayMatcher matcher(needle);
+    const qint64 floor = log.startOffset();
+    for (auto index = segmentIndexes.rbegin(); index != segmentIndexes.rend() && hits.size() < maxHits; ++index)
+    {
+        if (index->blockStarts.isEmpty() || index->segment.startOffset + index->indexedSize <= floor)
+            continue;
+
+        QByteArray candidates((index->blockStarts.size() + 7) / 8, '\xff');
+        for (quint32 key : trigrams)
+        {
+            const QByteArray blocks = index->blocksByTrigram.value(key);
+            for (qsizetype i = 0; i < candidates.size(); ++i)
+                candidates[i] = char(candidates.at(i) & (i < blocks.size() ? blocks.at(i) : 0));
+        }
+
+        // Mapped or opened only once a block is worth reading; archives decompress just the blocks read
+        SegmentReader reader(log, index->segment, index != segmentIndexes.rbegin(), index->indexedSize);
+        for (qsizetype block = index->blockStarts.size() - 1; block >= 0 && hits.size() < maxHits; --block)
+        {
+            if (!(candidates.at(block / 8) & (1 << (block % 8))))
+                continue;
+            if (!reader.open())
+                break;
+
+            const bool lastBlock = block + 1 == index->blockStarts.size();
+            const qint64 from = index->blockStarts.at(block);
+            const qint64 to = lastBlock ? index->indexedSize : index->blockStarts.at(block + 1);
+            const QByteArray text = reader.read(from, to - from).toLower();
+
+            // One hit per line; the search goes on after the end of a matching line
+            QList<qint64> blockHits;
+            for (qsizetype position = matcher.indexIn(text, 0); position >= 0;)
+            {
+                const qint64 offset = index->segment.startOffset + from + text.lastIndexOf('\n', position) + 1;
+                if (offset >= floor)
+                    blockHits.append(offset);
+
+                const qsizetype lineEnd = text.indexOf('\n', position);
+                position = lineEnd < 0 ? -1 : matcher.indexIn(text, lineEnd + 1);
+            }
+
+            for (qsizetype i = blockHits.size() - 1; i >= 0 && hits.size() < maxHits; --i)
+                hits.append(blockHits.at(i));
+        }
+    }
+
+    std::reverse(hits.begin(), hits.end());
+    return hits;
+}
+
+qint64 LogSearchIndex::indexSegment(SegmentIndex& index, const SegmentIndex* previous, bool finished)
+{
+    Q_UNUSED(previous)
+
+    if (index.indexedSize >= index.segment.size)
+        return 0;
+
+    // Only the bytes not indexed yet are read
+    const qint64 base = index.indexedSize;
+    SegmentReader reader(log, index.segment, finished, index.segment.size);
+    const QByteArray text = reader.open() ? reader.read(base, index.segment.size - base) : QByteArray();
+    const char* data = text.constData();
+
+    // A line still being written is indexed once it is complete or its segment is finished
+    const qint64 end = finished ? text.size() : text.lastIndexOf('\n') + 1;
+
+    // Trigrams already recorded for the current block, so repeats skip the hash lookup
+    std::vector<quint64> seen((1 << 24) / 64);
+    QList<quint32> seenKeys;
+
+    qint64 position = 0;
+    while (position < end)
+    {
+        if (index.blockStarts.isEmpty() || base + position - index.blockStarts.last() >= BlockBytes)
+        {
+            index.blockStarts.append(base + position);
+            for (quint32 key : seenKeys)
+                seen[key / 64] &= ~(quint64(1) << (key % 64));
+            seenKeys.clear();
+        }
+
+        const qsizetype block = index.blockStarts.size() - 1;
+        const void* newline = std::memchr(data + position, '\n', end - position);
+        const qint64 lineEnd = newline ? static_cast<const char*>(newline) - data + 1 : end;
+
+        for (qint64 i = position; i + 2 < lineEnd; ++i)
+        {
+            quint32 key = 0;
+            if (!trigramAt(data + i, key) || (seen[key / 64] & (quint64(1) << (key % 64))))
+                continue;
+
+            seen[key / 64] |= quint64(1) << (key % 64);
+            seenKeys.append(key);
+
+            QByteArray& blocks = index.blocksByTrigram[key];
+            if (blocks.size() <= block / 8)
+                blocks.append(block / 8 + 1 - blocks.size(), '\0');
+            blocks[block / 8] = char(blocks.at(block / 8) | (1 << (block % 8)));
+        }
+        position = lineEnd;
+    }
+
+    index.indexedSize = base + end;
+    return end;
+}
+
+qint64 LogSearchIndex::unsaved(const SegmentIndex& index) const
+{
+    return index.indexedSize - index.savedSize;
+}
+
+bool LogSearchIndex::load(SegmentIndex& index) const
+{
+    QFile file(sidecarPath(index));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString fileName;
+    quint64 fileId = 0;
+    qint64 indexedSize = 0;
+    stream >> magic >> version;
+    if (magic != IndexMagic || version != IndexVersion)
+        return false;
+    stream >> fileName >> fileId >> indexedSize >> index.blockStarts >> index.blocksByTrigram;
+
+    // A damaged index, or one of another file with the same name, is rebuilt
+    if (stream.status() != QDataStream::Ok || fileName != index.segment.fileName ||
+        fileId != index.segment.fileId || indexedSize > index.segment.size)
+    {
+        index.blockStarts.clear();
+        index.blocksByTrigram.clear();
+        return false;
+    }
+
+    index.indexedSize = indexedSize;
+    index.savedSize = indexedSize;
+    return true;
+}
+
+bool LogSearchIndex::save(SegmentIndex& index) const
+{
+    QSaveFile file(sidecarPath(index));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG_WARNING_IN(Logs, "Failed to write search index " + file.fileName() + ": " + file.errorString());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << IndexMagic << IndexVersion << index.segment.fileName << index.segment.fileId << index.indexedSize
+           << index.blockStarts << index.blocksByTrigram;
+
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        LOG_WARNING_IN(Logs, "Failed to write search index " + file.fileName() + ": " + file.errorString());
+        return false;
+    }
+
+    index.savedSize = index.indexedSize;
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef LOGSEARCHINDEX_H
+#define LOGSEARCHINDEX_H
+
+#include "SidecarIndex.h"
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+// What LogSearchIndex keeps of one segment
+struct LogSearchSegment
+{
+    LogSegment segment;
+    qint64 indexedSize = 0;
+    qint64 savedSize = 0;
+    // Relative to the segment start
+    QList<qint64> blockStarts;
+    // One bit per block; bits past the end of a bitmap are 0
+    QHash<quint32, QByteArray> blocksByTrigram;
+};
+
+// Trigram index over the segments of a SegmentedLog for substring search without reading the whole
+// log. Each segment is cut into blocks of about BlockBytes that end at a newline, and every trigram
+// of a segment maps to a bitmap of the blocks containing it. A search ANDs the bitmaps of the query
+// trigrams and scans only the blocks left. The index of a segment is kept next to it as a .tri
+// sidecar; update() extends it with output appended since, and indexes segments without one, written
+// before there was an index, from scratch. Not thread-safe; LogIndexer keeps these on its worker.
+class LogSearchIndex : public SidecarIndex<LogSearchSegment>
+{
+  public:
+    explicit LogSearchIndex(const QString& directoryPath);
+    // Saves what was indexed since the last save
+    ~LogSearchIndex();
+
+    // Indexes the new output of every segment; returns the number of bytes indexed
+    qint64 update();
+
+    // Start offsets of the last maxHits indexed lines containing query, ignoring ASCII case, oldest first
+    QList<qint64> search(const QByteArray& query, int maxHits = MaxHits) const;
+
+    static constexpr qint64 BlockBytes = 64 * 1024;
+    // The index of the segment being written is saved after this much new output, and when it is finished
+    static constexpr qint64 SaveIntervalBytes = 1024 * 1024;
+    static constexpr int MaxHits = 10000;
+
+  private:
+    using SegmentIndex = LogSearchSegment;
+
+    qint64 indexSegment(SegmentIndex& index, const SegmentIndex* previous, bool finished) override;
+    qint64 unsaved(const SegmentIndex& index) const override;
+    bool load(SegmentIndex& index) const override;
+    bool save(SegmentIndex& index) const override;
+};
+
+#endif // LOGSEARCHINDEX_H
@@ -0,0 +1,107 @@
+#include "LogStream.h"
+#include <QCoreApplication>
+#include <cstring>
+
+LogStream::LogStream(QObject* parent) : QObject(parent)
+{
+    partialLineTimer = new QTimer(this);
+    partialLineTimer->setSingleShot(true);
+    partialLineTimer->setInterval(PartialLineDelayMs);
+    connect(partialLineTimer, &QTimer::timeout, this, &LogStream::flushPartialLine);
+}
+
+void LogStream::write(const QByteArray& data, qint64 fileOffset)
+{
+    const char* begin = data.constData();
+    const qsizetype size = data.size();
+    qsizetype start = 0;
+    bool appended = false;
+
+    while (start < size)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(begin + start, '\n', size - start));
+        if (!newline)
+            break;
+
+        const qsizetype end = newline - begin + 1;
+        if (partialLine.isEmpty())
+        {
+            ring.append(begin + start, end - start, fileOffset + start);
+        }
+        else
+        {
+            partialLine.append(begin + start, end - start);
+            ring.append(partialLine.constData(), partialLine.size(), partialLineOffset);
+            partialLine.clear();
+        }
+        start = end;
+        appended = true;
+    }
+
+    if (start < size)
+    {
+        if (partialLine.isEmpty())
+            partialLineOffset = fileOffset + start;
+        partialLine.append(begin + start, size - start);
+        partialLineTimer->start();
+    }
+    else
+    {
+        partialLineTimer->stop();
+    }
+
+    if (appended)
+        emit linesAppended(ring.nextSequence());
+}
+
+void LogStream::flushPartialLine()
+{
+    partialLineTimer->stop();
+    if (partialLine.isEmpty())
+        return;
+
+    ring.append(partialLine.constData(), partialLine.size(), partialLineOffset);
+    partialLine.clear();
+    emit linesAppended(ring.nextSequence());
+}
+
+void LogStream::markCleared()
+{
+    flushPartialLine();
+    firstVisibleSequence = ring.nextSequence();
+}
+
+QList<LogLine> LogStream::readFrom(quint64 sequence) const
+{
+    return ring.readFrom(qMax(sequence, firstVisibleSequence));
+}
+
+quint64 LogStream::nextSequence() const
+{
+    return ring.nextSequence();
+}
+
+LogStreamHub& LogStreamHub::instance()
+{
+    static LogStreamHub hub;
+    return hub;
+}
+
+LogStream& LogStreamHub::acquire(int processId)
+{
+    Holders& holders = streams[processId];
+    if (!holders.stream)
+        holders.stream = new LogStream(QCoreApplication::instance());
+    ++holders.count;
+    return *holders.stream;
+}
+
+void LogStreamHub::release(int processId)
+{
+    auto it = streams.find(processId);
+    if (it == streams.end() || --it->count > 0)
+        return;
+
+    it->stream->deleteLater();
+    streams.erase(it);
+}
@@ -0,0 +1,66 @@
+#ifndef LOGSTREAM_H
+#define LOGSTREAM_H
+
+#include "LogLineRing.h"
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+// Live output of one process. The launcher writes raw output into it; it is split into lines and
+// published to a LogLineRing, and viewers are told right away through linesAppended(). Lines keep
+// their newline and their offset in the log file, so a viewer can read anything older from the file.
+class LogStream : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit LogStream(QObject* parent = nullptr);
+
+    // fileOffset is where data starts in the process log file
+    void write(const QByteArray& data, qint64 fileOffset);
+
+    // Publishes an unterminated line, e.g. a prompt; called PartialLineDelayMs after the last write
+    void flushPartialLine();
+
+    // Hides everything written so far from later reads, after the log was cleared
+    void markCleared();
+
+    QList<LogLine> readFrom(quint64 sequence) const;
+    quint64 nextSequence() const;
+
+    static constexpr int PartialLineDelayMs = 50;
+
+  signals:
+    void linesAppended(quint64 nextSequence);
+
+  private:
+    LogLineRing ring;
+    quint64 firstVisibleSequence = 1;
+    QByteArray partialLine;
+    qint64 partialLineOffset = 0;
+    QTimer* partialLineTimer = nullptr;
+};
+
+// Hands out the LogStream of a process to its launcher and its viewers. Every acquire() is matched by
+// a release(); the stream and its ring go away once nobody holds it, a deleted process's included.
+class LogStreamHub
+{
+  public:
+    static LogStreamHub& instance();
+
+    LogStream& acquire(int processId);
+    void release(int processId);
+
+  private:
+    LogStreamHub() = default;
+
+    struct Holders
+    {
+        LogStream* stream = nullptr;
+        int count = 0;
+    };
+
+    QHash<int, Holders> streams;
+};
+
+#endif // LOGSTREAM_H
@@ -0,0 +1,93 @@
+#include "LogTimeline.h"
+#include "Logger.h"
+#include <QDataStream>
+#include <QFile>
+#include <algorithm>
+
+namespace
+{
+    const QString StampExtension = "ts";
+    constexpr qint64 StampBytes = 16;
+}
+
+LogTimeline::LogTimeline(const QString& directoryPath) : log(directoryPath)
+{
+}
+
+void LogTimeline::refresh()
+{
+    log.load();
+
+    // Stamps read before stay with their segment; deleted segments drop out
+    std::vector<SegmentStamps> current;
+    current.reserve(log.segments().size());
+    for (const LogSegment& segment : log.segments())
+    {
+        auto known = std::find_if(segmentStamps.begin(), segmentStamps.end(),
+                                  [&](const SegmentStamps& stamps)
+                                  {
+                                      return stamps.segment.fileName == segment.fileName &&
+                                             stamps.segment.fileId == segment.fileId;
+                                  });
+        SegmentStamps stamps;
+        if (known != segmentStamps.end())
+            stamps = std::move(*known);
+        stamps.segment = segment;
+        current.push_back(std::move(stamps));
+    }
+    segmentStamps = std::move(current);
+
+    for (SegmentStamps& stamps : segmentStamps)
+    {
+        QFile file(log.sidecarPath(stamps.segment, StampExtension));
+        if (file.size() - stamps.readBytes < StampBytes || !file.open(QIODevice::ReadOnly) ||
+            !file.seek(stamps.readBytes))
+            continue;
+
+        // The writer may be halfway through a stamp; it is read next time
+        QDataStream stream(&file);
+        const qint64 count = (file.size() - stamps.readBytes) / StampBytes;
+        for (qint64 i = 0; i < count; ++i)
+        {
+            LogStamp stamp;
+            stream >> stamp.offset >> stamp.time;
+            stamps.stamps.append(stamp);
+        }
+        stamps.readBytes += count * StampBytes;
+    }
+}
+
+qint64 LogTimeline::timeAt(qint64 offset) const
+{
+    auto segment = std::upper_bound(segmentStamps.begin(), segmentStamps.end(), offset,
+                                    [](qint64 value, const SegmentStamps& stamps)
+                                    { return value < stamps.segment.startOffset; });
+    if (segment == segmentStamps.begin())
+        return 0;
+    --segment;
+
+    const QList<LogStamp>& stamps = segment->stamps;
+    auto stamp = std::upper_bound(stamps.begin(), stamps.end(), offset,
+                                  [](qint64 value, const LogStamp& candidate) { return value < candidate.offset; });
+    if (stamp == stamps.begin())
+        return segment->segment.startedAt;
+    return (stamp - 1)->time;
+}
+
+bool LogTimeline::append(const SegmentedLog& log, const QList<LogStamp>& stamps)
+{
+    if (stamps.isEmpty() || log.segments().isEmpty())
+        return true;
+
+    QFile file(log.sidecarPath(log.segments().last(), StampExtension));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        LOG_WARNING_IN(Logs, "Failed to write log stamps " + file.fileName() + ": " + file.errorString());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    for (const LogStamp& stamp : stamps)
+        stream << stamp.offset << stamp.time;
+    return stream.status() == QDataStream::Ok;
+}
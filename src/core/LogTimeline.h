@@ -0,0 +1,46 @@
+#ifndef LOGTIMELINE_H
+#define LOGTIMELINE_H
+
+#include "SegmentedLog.h"
+#include <QList>
+#include <QString>
+#include <vector>
+
+// Time a chunk of output starting at offset was received, in ms since epoch
+struct LogStamp
+{
+    qint64 offset = 0;
+    qint64 time = 0;
+};
+
+// When the output of a SegmentedLog was received. The writer stamps output as it arrives and appends
+// the stamps of a segment to a .ts sidecar, sixteen bytes each, so they go away with the segment.
+// A line takes the time of the last stamp at or before its start; output written without stamps
+// takes the time its segment was started. Readers pick up new stamps with refresh().
+class LogTimeline
+{
+  public:
+    explicit LogTimeline(const QString& directoryPath);
+
+    // Loads the segments and reads the stamps written since the last refresh
+    void refresh();
+
+    // Time of the output at offset, or 0 if no segment holds it
+    qint64 timeAt(qint64 offset) const;
+
+    // Writer side: appends stamps to the sidecar of the newest segment of log
+    static bool append(const SegmentedLog& log, const QList<LogStamp>& stamps);
+
+  private:
+    struct SegmentStamps
+    {
+        LogSegment segment;
+        QList<LogStamp> stamps;
+        qint64 readBytes = 0;
+    };
+
+    SegmentedLog log;
+    std::vector<SegmentStamps> segmentStamps;
+};
+
+#endif // LOGTIMELINE_H
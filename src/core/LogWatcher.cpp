@@ -0,0 +1,119 @@
+#include "LogWatcher.h"
+#include "Logger.h"
+#include <QDir>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Search indexes and other sidecars change without new output
+    bool isLogFile(const QString& fileName)
+    {
+        return fileName.endsWith(".log") || fileName == "index.json";
+    }
+}
+
+LogWatcher::LogWatcher(const QString& directoryPath, QObject* parent) : QObject(parent), directory(directoryPath)
+{
+    QDir().mkpath(directory);
+
+#if defined(Q_OS_LINUX)
+    inotifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0)
+    {
+        // IN_MODIFY covers appends and truncation, the others new, renamed and deleted segments and index.json
+        const uint32_t mask = IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM;
+        if (::inotify_add_watch(inotifyFd, QFile::encodeName(directory).constData(), mask) >= 0)
+        {
+            notifier = new QSocketNotifier(inotifyFd, QSocketNotifier::Read, this);
+            connect(notifier, &QSocketNotifier::activated, this, &LogWatcher::readEvents);
+            return;
+        }
+
+        const QString error = QString::fromLocal8Bit(std::strerror(errno));
+        LOG_WARNING_IN(Logs, "Failed to watch log directory " + directory + ": " + error);
+        ::close(inotifyFd);
+        inotifyFd = -1;
+    }
+#endif
+
+    fileSystemWatcher = new QFileSystemWatcher(this);
+    connect(fileSystemWatcher, &QFileSystemWatcher::directoryChanged, this,
+            [this]()
+            {
+                watchFiles();
+                emit changed();
+            });
+    connect(fileSystemWatcher, &QFileSystemWatcher::fileChanged, this,
+            [this]()
+            {
+                // A replaced file drops out of the watcher
+                watchFiles();
+                emit changed();
+            });
+    fileSystemWatcher->addPath(directory);
+    watchFiles();
+}
+
+LogWatcher::~LogWatcher()
+{
+#if defined(Q_OS_LINUX)
+    if (notifier)
+    {
+        notifier->setEnabled(false);
+    }
+
+    if (inotifyFd >= 0)
+    {
+        ::close(inotifyFd);
+    }
+#endif
+}
+
+bool LogWatcher::isWatching() const
+{
+    return inotifyFd >= 0 || (fileSystemWatcher && !fileSystemWatcher->directories().isEmpty());
+}
+
+void LogWatcher::readEvents()
+{
+#if defined(Q_OS_LINUX)
+    // Everything queued is read in one go; a burst of writes ends up as a single changed()
+    bool relevant = false;
+    alignas(inotify_event) char buffer[4096];
+    for (;;)
+    {
+        const ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (ssize_t position = 0; position < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + position);
+            if (event->mask & IN_Q_OVERFLOW || (event->len > 0 && isLogFile(QFile::decodeName(event->name))))
+                relevant = true;
+            position += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    if (relevant)
+        emit changed();
+#endif
+}
+
+void LogWatcher::watchFiles()
+{
+    const QStringList watched = fileSystemWatcher->files();
+    const QDir dir(directory);
+    for (const QString& fileName : dir.entryList({"*.log", "index.json"}, QDir::Files))
+    {
+        const QString path = dir.filePath(fileName);
+        if (!watched.contains(path))
+            fileSystemWatcher->addPath(path);
+    }
+}
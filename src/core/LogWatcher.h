@@ -0,0 +1,37 @@
+#ifndef LOGWATCHER_H
+#define LOGWATCHER_H
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QSocketNotifier>
+
+// Emits changed() when the segments or the index of a log directory change on disk: output was
+// appended, a segment was added, truncated, replaced or deleted. On Linux an inotify watch on the
+// directory wakes only when a file in it is written, created, moved or deleted, so an idle log costs
+// no wakeups; elsewhere QFileSystemWatcher watches the directory and its files. Telling truncation
+// from rotation is up to the reader, see LogSegment::fileId.
+class LogWatcher : public QObject
+{
+    Q_OBJECT
+
+  public:
+    // Creates the directory if needed, so output of a first run is seen too
+    explicit LogWatcher(const QString& directoryPath, QObject* parent = nullptr);
+    ~LogWatcher();
+
+    bool isWatching() const;
+
+  signals:
+    void changed();
+
+  private:
+    void readEvents();
+    void watchFiles();
+
+    QString directory;
+    int inotifyFd = -1;
+    QSocketNotifier* notifier = nullptr;
+    QFileSystemWatcher* fileSystemWatcher = nullptr;
+};
+
+#endif // LOGWATCHER_H
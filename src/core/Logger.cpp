@@ -1,68 +1,300 @@
 #include "Logger.h"
+#include "MpscQueue.h"
 
+#include <QDateTime>
 #include <QDir>
-#include <QFileInfo>
+#include <QFile>
+#include <QSemaphore>
 #include <QStandardPaths>
-#include <QTextStream>
+#include <QStringList>
+#include <QThread>
+#include <atomic>
 
-QString Logger::logFilePath;
+namespace
+{
+    const char* const LevelNames[] = {"DEBUG", "INFO", "WARN", "ERROR", "CRIT"};
+    const char* const CategoryNames[] = {"general", "db", "process", "logs", "ui"};
+
+    // A message to write, or a flush waiting for everything queued before it when done is set. The
+    // writer formats it; the caller only takes the time.
+    struct LogMessage
+    {
+        Logger::Level level = Logger::Level::Info;
+        Logger::Category category = Logger::Category::General;
+        qint64 time = 0;
+        QString text;
+        const char* file = nullptr;
+        const char* function = nullptr;
+        int line = -1;
+        QSemaphore* done = nullptr;
+    };
+
+    class LogWriter
+    {
+      public:
+        ~LogWriter()
+        {
+            stop();
+        }
+
+        bool start(const QString& filePath)
+        {
+            // Left over from racing the last stop; a flush among them has given up waiting
+            LogMessage stale;
+            while (queue.pop(stale))
+            {
+            }
+
+            file.setFileName(filePath);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+                return false;
+
+            file.write("\n\n=== Logging started at " +
+                       QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz").toUtf8() + " ===\n");
+            file.flush();
+
+            thread = QThread::create([this]() { run(); });
+            thread->setObjectName("Logger");
+            thread->start();
+            running = true;
+            return true;
+        }
+
+        void stop()
+        {
+            if (!thread)
+                return;
+
+            // Messages logged from here on are dropped; those already queued are written
+            running = false;
+            stopping = true;
+            wakeup.release();
+            thread->wait();
+            delete thread;
+            thread = nullptr;
+            stopping = false;
+            file.close();
+        }
+
+        bool isRunning() const
+        {
+            return running;
+        }
+
+        void push(LogMessage message)
+        {
+            queue.push(std::move(message));
+
+            // Pairs with the fence in run(): either the writer sees the message or this sees it waiting
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed))
+                wakeup.release();
+        }
+
+      private:
+        // [time] [LEVEL] [category] [file:line@function] text
+        void append(QByteArray& batch, const LogMessage& message)
+        {
+            // Messages come in bursts; the date and time to the second are formatted once for each
+            const qint64 second = message.time / 1000;
+            if (second != stampSecond || stampPrefix.isEmpty())
+            {
+                stampSecond = second;
+                stampPrefix = QDateTime::fromMSecsSinceEpoch(second * 1000).toString("yyyy-MM-dd hh:mm:ss.").toUtf8();
+            }
+            const int millis = int(message.time - second * 1000);
+
+            const char* file = message.file ? message.file : "";
+            for (const char* each = file; *each; ++each)
+            {
+                if (*each == '/' || *each == '\\')
+                    file = each + 1;
+            }
+
+            batch += '[';
+            batch += stampPrefix;
+            batch += char('0' + millis / 100);
+            batch += char('0' + millis / 10 % 10);
+            batch += char('0' + millis % 10);
+            batch += "] [";
+            batch += LevelNames[int(message.level)];
+            batch += "] [";
+            batch += CategoryNames[int(message.category)];
+            batch += "] [";
+            batch += file;
+            batch += ':';
+            batch += QByteArray::number(message.line);
+            batch += '@';
+            batch += message.function ? message.function : "unknown";
+            batch += "] ";
+            batch += message.text.toUtf8();
+            batch += '\n';
+        }
+
+        void run()
+        {
+            QByteArray batch;
+            QList<QSemaphore*> flushes;
+            for (;;)
+            {
+                LogMessage message;
+                int taken = 0;
+                for (; taken < Logger::BatchMessages && queue.pop(message); ++taken)
+                {
+                    if (message.done)
+                        flushes.append(message.done);
+                    else
+                        append(batch, message);
+                }
+
+                if (!batch.isEmpty())
+                {
+                    file.write(batch);
+                    file.flush();
+                    batch.resize(0);
+                }
+                for (QSemaphore* done : flushes)
+                    done->release();
+                flushes.clear();
+
+                if (taken == Logger::BatchMessages)
+                    continue;
+                if (stopping)
+                {
+                    if (queue.isEmpty())
+                        return;
+                    continue;
+                }
+
+                waiting.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (queue.isEmpty())
+                    wakeup.tryAcquire(1, Logger::IdleWakeMs);
+                waiting.store(false, std::memory_order_relaxed);
+                // Producers that saw it waiting may have woken it more than once
+                wakeup.tryAcquire(wakeup.available());
+            }
+        }
+
+        QFile file;
+        qint64 stampSecond = 0;
+        QByteArray stampPrefix;
+        MpscQueue<LogMessage> queue;
+        QSemaphore wakeup;
+        std::atomic<bool> waiting{false};
+        std::atomic<bool> stopping{false};
+        std::atomic<bool> running{false};
+        QThread* thread = nullptr;
+    };
+
+    LogWriter& writer()
+    {
+        static LogWriter instance;
+        return instance;
+    }
+}
+
+std::atomic<int> Logger::minimumLevels[CategoryCount] = {int(Level::Info), int(Level::Warning), int(Level::Info),
+                                                         int(Level::Info), int(Level::Info)};
 
 void Logger::initialize(const QString& appName)
 {
     QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(logDir);
 
-    logFilePath = logDir + "/" + appName + ".log";
+    open(logDir + "/" + appName + ".log");
 
-    QFile file(logFilePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Append))
-    {
-        QTextStream stream(&file);
-        stream << "\n\n=== Logging started at " << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz")
-               << " ===\n";
-    }
+    const QString levels = qEnvironmentVariable("DEVPILOT_LOG");
+    if (!levels.isEmpty() && !configure(levels))
+        LOG_WARNING("Unknown entries in DEVPILOT_LOG: " + levels);
+}
+
+bool Logger::open(const QString& filePath)
+{
+    writer().stop();
+    return writer().start(filePath);
 }
 
-void Logger::log(Level level, const QString& message, const char* file, const char* function, int line)
+void Logger::flush()
 {
-    QFile logFile(logFilePath);
-    if (logFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    if (!writer().isRunning())
+        return;
+
+    QSemaphore done;
+    LogMessage message;
+    message.done = &done;
+    writer().push(std::move(message));
+    // A shutdown meanwhile writes the queue before it returns, the flush included
+    while (!done.tryAcquire(1, IdleWakeMs))
     {
-        QTextStream stream(&logFile);
-        stream << formatMessage(level, message, file, function, line) << "\n";
-        logFile.close();
+        if (!writer().isRunning())
+            return;
     }
 }
 
-QString Logger::formatMessage(Level level, const QString& message, const char* file, const char* function, int line)
+void Logger::shutdown()
+{
+    writer().stop();
+}
+
+void Logger::setMinimumLevel(Category category, Level level)
 {
-    QString levelStr;
-    switch (level)
+    minimumLevels[int(category)].store(int(level), std::memory_order_relaxed);
+}
+
+Logger::Level Logger::minimumLevel(Category category)
+{
+    return Level(minimumLevels[int(category)].load(std::memory_order_relaxed));
+}
+
+bool Logger::configure(const QString& levels)
+{
+    auto find = [](const char* const* names, int count, const QString& name)
     {
-    case Level::Debug:
-        levelStr = "DEBUG";
-        break;
-    case Level::Info:
-        levelStr = "INFO";
-        break;
-    case Level::Warning:
-        levelStr = "WARN";
-        break;
-    case Level::Error:
-        levelStr = "ERROR";
-        break;
-    case Level::Critical:
-        levelStr = "CRIT";
-        break;
+        for (int i = 0; i < count; ++i)
+        {
+            if (name.compare(QLatin1String(names[i]), Qt::CaseInsensitive) == 0)
+                return i;
+        }
+        return -1;
+    };
+    // Full level names, where the log writes them short
+    const char* const levelNames[] = {"debug", "info", "warning", "error", "critical"};
+
+    bool known = true;
+    for (const QString& entry : levels.split(',', Qt::SkipEmptyParts))
+    {
+        const QStringList parts = entry.trimmed().split('=');
+        const int level = find(levelNames, 5, parts.last().trimmed());
+        const int category = parts.size() == 2 ? find(CategoryNames, CategoryCount, parts.first().trimmed()) : -2;
+        if (level < 0 || parts.size() > 2 || category == -1)
+        {
+            known = false;
+            continue;
+        }
+
+        for (int i = 0; i < CategoryCount; ++i)
+        {
+            if (category < 0 || category == i)
+                setMinimumLevel(Category(i), Level(level));
+        }
     }
+    return known;
+}
 
-    QString shortFile = QFileInfo(file ? file : "").fileName();
+void Logger::log(Level level, Category category, const QString& message, const char* file, const char* function,
+                 int line)
+{
+    if (!writer().isRunning())
+        return;
 
-    return QString("[%1] [%2] [%3:%4@%5] %7")
-        .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz"))
-        .arg(levelStr)
-        .arg(shortFile)
-        .arg(line)
-        .arg(function ? function : "unknown")
-        .arg(message);
+    LogMessage entry;
+    entry.level = level;
+    entry.category = category;
+    entry.time = QDateTime::currentMSecsSinceEpoch();
+    entry.text = message;
+    entry.file = file;
+    entry.function = function;
+    entry.line = line;
+    writer().push(std::move(entry));
 }
@@ -1,10 +1,23 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
-#include <QDateTime>
-#include <QMutex>
 #include <QString>
+#include <atomic>
 
+// Levels below this are compiled out of the LOG_ macros, arguments and all: DEBUG and INFO in release
+// builds. Define it to the number of a Logger::Level to keep or drop more.
+#ifndef LOGGER_MIN_LEVEL
+#ifdef NDEBUG
+#define LOGGER_MIN_LEVEL 2
+#else
+#define LOGGER_MIN_LEVEL 0
+#endif
+#endif
+
+// Application log. Any thread may log: the caller pushes the message to a lock-free queue and a writer
+// thread formats whatever piled up and writes it in one go to the file it keeps open. The LOG_ macros
+// check the level of their category before they build the message, so a disabled call costs a load
+// and a compare. Messages logged before initialize() or after shutdown() are dropped.
 class Logger
 {
   public:
@@ -17,20 +30,70 @@ class Logger
         Critical
     };
 
+    // Parts of the application with a minimum level of their own
+    enum class Category
+    {
+        General,
+        Database,
+        Process,
+        Logs,
+        Ui
+    };
+    static constexpr int CategoryCount = int(Category::Ui) + 1;
+
+    // Logs to <app data>/<appName>.log, with the levels in DEVPILOT_LOG if it is set
     static void initialize(const QString& appName);
+    // Logs to filePath, after shutting down the log open before
+    static bool open(const QString& filePath);
+    // Returns once every message logged before the call is written
+    static void flush();
+    // Writes what is queued and stops the writer thread
+    static void shutdown();
+
+    // Everything is logged from Info up, but for Database from Warning up
+    static void setMinimumLevel(Category category, Level level);
+    static Level minimumLevel(Category category);
+    // Sets levels from a list like "info,db=debug,ui=warning"; a level without a category sets all of
+    // them. Categories are general, db, process, logs and ui. Returns false if any entry is unknown.
+    static bool configure(const QString& levels);
+
+    static bool isEnabled(Level level, Category category)
+    {
+        return int(level) >= minimumLevels[int(category)].load(std::memory_order_relaxed);
+    }
+
+    // file and function must outlive the writer, as __FILE__ and __func__ do
+    static void log(Level level, Category category, const QString& message, const char* file = nullptr,
+                    const char* function = nullptr, int line = -1);
+
+    // Messages the writer takes off the queue before writing them out
+    static constexpr int BatchMessages = 256;
+    // The writer looks at the queue at least this often
+    static constexpr int IdleWakeMs = 200;
+
+#define LOGGER_LOG(level, category, msg)                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (int(Logger::Level::level) >= LOGGER_MIN_LEVEL &&                                                           \
+            Logger::isEnabled(Logger::Level::level, Logger::Category::category))                                       \
+            Logger::log(Logger::Level::level, Logger::Category::category, msg, __FILE__, __func__, __LINE__);          \
+    } while (0)
 
-    static void log(Level level, const QString& message, const char* file = nullptr, const char* function = nullptr,
-                    int line = -1);
+#define LOG_DEBUG(msg) LOGGER_LOG(Debug, General, msg)
+#define LOG_INFO(msg) LOGGER_LOG(Info, General, msg)
+#define LOG_WARNING(msg) LOGGER_LOG(Warning, General, msg)
+#define LOG_ERROR(msg) LOGGER_LOG(Error, General, msg)
+#define LOG_CRITICAL(msg) LOGGER_LOG(Critical, General, msg)
 
-#define LOG_DEBUG(msg) Logger::log(Logger::Level::Debug, msg, __FILE__, __func__, __LINE__)
-#define LOG_INFO(msg) Logger::log(Logger::Level::Info, msg, __FILE__, __func__, __LINE__)
-#define LOG_WARNING(msg) Logger::log(Logger::Level::Warning, msg, __FILE__, __func__, __LINE__)
-#define LOG_ERROR(msg) Logger::log(Logger::Level::Error, msg, __FILE__, __func__, __LINE__)
-#define LOG_CRITICAL(msg) Logger::log(Logger::Level::Critical, msg, __FILE__, __func__, __LINE__)
+// Same in a category, e.g. LOG_INFO_IN(Database, "...")
+#define LOG_DEBUG_IN(category, msg) LOGGER_LOG(Debug, category, msg)
+#define LOG_INFO_IN(category, msg) LOGGER_LOG(Info, category, msg)
+#define LOG_WARNING_IN(category, msg) LOGGER_LOG(Warning, category, msg)
+#define LOG_ERROR_IN(category, msg) LOGGER_LOG(Error, category, msg)
+#define LOG_CRITICAL_IN(category, msg) LOGGER_LOG(Critical, category, msg)
 
   private:
-    static QString logFilePath;
-    static QString formatMessage(Level level, const QString& message, const char* file, const char* function, int line);
+    static std::atomic<int> minimumLevels[CategoryCount];
 };
 
 #endif // LOGGER_H
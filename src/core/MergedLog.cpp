@@ -0,0 +1,203 @@
+#include "MergedLog.h"
+#include <iterator>
+
+void MergedLog::addSource(const QString& directoryPath, const QString& tag, const QColor& color)
+{
+    auto source = std::make_unique<Source>(directoryPath);
+    source->tag = tag.toUtf8();
+    source->color = color;
+    sources.push_back(std::move(source));
+
+    // Tags are padded to the longest one, so the lines start in one column
+    qsizetype width = 0;
+    for (const auto& each : sources)
+        width = qMax(width, each->tag.size());
+    for (const auto& each : sources)
+    {
+        each->prefix = "\x1b[1;38;2;" + QByteArray::number(each->color.red()) + ";" +
+                       QByteArray::number(each->color.green()) + ";" + QByteArray::number(each->color.blue()) +
+                       "m" + each->tag.leftJustified(width) + "\x1b[0m ";
+    }
+    reset();
+}
+
+int MergedLog::sourceCount() const
+{
+    return static_cast<int>(sources.size());
+}
+
+bool MergedLog::refresh(int maxLines)
+{
+    bool deleted = false;
+    for (const auto& source : sources)
+    {
+        source->document->refresh();
+        source->timeline.refresh();
+        if (source->oldest >= 0 && (source->oldest < source->document->logStartOffset() ||
+                                    source->newest > source->document->endOffset()))
+            deleted = true;
+    }
+    if (deleted)
+        reset();
+
+    // Every source contributes its new lines in order; the earliest next line of any of them goes next
+    std::vector<std::vector<MergedRow>> added(sources.size());
+    bool more = false;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        Source& source = *sources[i];
+        if (source.newest < 0)
+            findTail(source);
+
+        qint64 position = source.newest;
+        for (qint64 next = source.document->nextLineStart(position); next >= 0;
+             next = source.document->nextLineStart(position))
+        {
+            if (added[i].size() == size_t(maxLines))
+            {
+                more = true;
+                break;
+            }
+            added[i].push_back({position, source.timeline.timeAt(position), int(i)});
+            position = next;
+        }
+        source.newest = position;
+    }
+
+    // A handful of sources; looking at each of them is cheaper than keeping a heap
+    std::vector<size_t> next(sources.size(), 0);
+    for (;;)
+    {
+        int earliest = -1;
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            if (next[i] < added[i].size() &&
+                (earliest < 0 || added[i][next[i]].time < added[earliest][next[earliest]].time))
+                earliest = int(i);
+        }
+        if (earliest < 0)
+            break;
+        insert(added[earliest][next[earliest]++]);
+    }
+    return more;
+}
+
+qint64 MergedLog::mergeOlder(int maxRows)
+{
+    // The line before the oldest merged one of every source, or -1; the latest of them goes in front
+    std::vector<MergedRow> previous(sources.size());
+    auto findPrevious = [this, &previous](size_t i)
+    {
+        const Source& source = *sources[i];
+        previous[i].source = int(i);
+        previous[i].offset = source.oldest > source.document->logStartOffset()
+                                 ? source.document->previousLineStart(source.oldest)
+                                 : -1;
+        if (previous[i].offset >= 0)
+            previous[i].time = source.timeline.timeAt(previous[i].offset);
+    };
+    for (size_t i = 0; i < sources.size(); ++i)
+        findPrevious(i);
+
+    qint64 added = 0;
+    while (added < maxRows)
+    {
+        int latest = -1;
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            if (previous[i].offset >= 0 && (latest < 0 || previous[i].time >= previous[latest].time))
+                latest = int(i);
+        }
+        if (latest < 0)
+            break;
+
+        rows.push_front(previous[latest]);
+        sources[latest]->oldest = previous[latest].offset;
+        findPrevious(latest);
+        ++added;
+    }
+    return added;
+}
+
+bool MergedLog::hasOlder() const
+{
+    for (const auto& source : sources)
+    {
+        if (source->oldest > source->document->logStartOffset())
+            return true;
+    }
+    return false;
+}
+
+qint64 MergedLog::dropOldest(qint64 maxRows)
+{
+    const qint64 dropped = static_cast<qint64>(rows.size()) - maxRows;
+    if (dropped <= 0)
+        return 0;
+    rows.erase(rows.begin(), rows.begin() + dropped);
+
+    // The rows of a source stay in order, so its first one left is its oldest; a source without any
+    // starts over at its newest line
+    std::vector<bool> found(sources.size(), false);
+    for (const auto& source : sources)
+        source->oldest = source->newest;
+    size_t remaining = sources.size();
+    for (auto row = rows.begin(); row != rows.end() && remaining > 0; ++row)
+    {
+        if (found[row->source])
+            continue;
+        found[row->source] = true;
+        sources[row->source]->oldest = row->offset;
+        --remaining;
+    }
+    return dropped;
+}
+
+qint64 MergedLog::rowCount() const
+{
+    return static_cast<qint64>(rows.size());
+}
+
+MergedRow MergedLog::row(qint64 index) const
+{
+    return rows.at(index);
+}
+
+QByteArray MergedLog::rowText(qint64 index) const
+{
+    const MergedRow& merged = rows.at(index);
+    const Source& source = *sources.at(merged.source);
+    return source.prefix + source.document->lineFrom(merged.offset);
+}
+
+void MergedLog::reset()
+{
+    rows.clear();
+    for (const auto& source : sources)
+        source->oldest = source->newest = -1;
+}
+
+void MergedLog::findTail(Source& source)
+{
+    // From the start of the unterminated line, if there is one, back by TailLines lines
+    const LogDocument& document = *source.document;
+    const qint64 lastLine = document.previousLineStart(document.endOffset());
+    qint64 position = lastLine < 0 ? document.logStartOffset() : document.nextLineStart(lastLine);
+    for (int i = 0; i < TailLines; ++i)
+    {
+        const qint64 previous = document.previousLineStart(position);
+        if (previous < 0)
+            break;
+        position = previous;
+    }
+    source.oldest = source.newest = position;
+}
+
+void MergedLog::insert(const MergedRow& row)
+{
+    // A line received before the last rows goes in after the last one not newer than it
+    auto position = rows.end();
+    for (int i = 0; i < ReorderRows && position != rows.begin() && std::prev(position)->time > row.time; ++i)
+        --position;
+    rows.insert(position, row);
+}
@@ -0,0 +1,85 @@
+#ifndef MERGEDLOG_H
+#define MERGEDLOG_H
+
+#include "LogDocument.h"
+#include "LogTimeline.h"
+#include <QByteArray>
+#include <QColor>
+#include <QString>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// One line of a MergedLog: which source it comes from, where it starts and when it was received
+struct MergedRow
+{
+    qint64 offset = 0;
+    qint64 time = 0;
+    int source = 0;
+};
+
+// Output of several processes interleaved by the time each line was received, see LogTimeline. Only
+// the merged window is ever read: opening starts with the last TailLines lines of every source,
+// refresh() merges what was written since after them and mergeOlder() extends the window backward in
+// slices, like LogDocument does for one log. New lines received before the last rows, because their
+// process flushed later, are moved in among the last ReorderRows rows. dropOldest() keeps the window at
+// MaxRows, scrolling back up merges the dropped rows again. Rows start over from the tail when output of
+// a source was deleted or cleared. Rows are shown behind the colored tag of their source.
+class MergedLog
+{
+  public:
+    MergedLog() = default;
+    MergedLog(const MergedLog&) = delete;
+    MergedLog& operator=(const MergedLog&) = delete;
+
+    void addSource(const QString& directoryPath, const QString& tag, const QColor& color);
+    int sourceCount() const;
+
+    // Merges up to maxLines new lines of every source; returns true while more is left
+    bool refresh(int maxLines = RefreshLines);
+    // Merges up to maxRows older rows in front; returns how many, which shifts every row by as much
+    qint64 mergeOlder(int maxRows = OlderRows);
+    bool hasOlder() const;
+    // Drops the oldest rows beyond maxRows, which mergeOlder() merges again; returns how many, which
+    // shifts every row back by as much
+    qint64 dropOldest(qint64 maxRows = MaxRows);
+
+    qint64 rowCount() const;
+    MergedRow row(qint64 index) const;
+    // The line with the tag of its source in front, colored with ANSI escapes
+    QByteArray rowText(qint64 index) const;
+
+    static constexpr int TailLines = 500;
+    static constexpr int RefreshLines = 10000;
+    static constexpr int OlderRows = 1000;
+    static constexpr int ReorderRows = 1000;
+    static constexpr int MaxRows = 100000;
+
+  private:
+    struct Source
+    {
+        explicit Source(const QString& directoryPath)
+            : document(std::make_unique<LogDocument>(directoryPath)), timeline(directoryPath)
+        {
+        }
+
+        std::unique_ptr<LogDocument> document;
+        LogTimeline timeline;
+        QByteArray tag;
+        QColor color;
+        // Tag padded to the longest one and colored
+        QByteArray prefix;
+        // Merged lines are those in [oldest, newest); -1 until the tail was found
+        qint64 oldest = -1;
+        qint64 newest = -1;
+    };
+
+    void reset();
+    void findTail(Source& source);
+    void insert(const MergedRow& row);
+
+    std::vector<std::unique_ptr<Source>> sources;
+    std::deque<MergedRow> rows;
+};
+
+#endif // MERGEDLOG_H
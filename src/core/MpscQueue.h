@@ -0,0 +1,69 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Unbounded queue any number of threads push to without locking and one thread pops from. Producers
+// swap their node in as the new head with a single atomic exchange and then link the old head to it;
+// the consumer follows the links from a dummy node, so it never touches what producers swap. A push
+// that has swapped but not linked yet is not visible until it has. T needs a default constructor.
+template <typename T> class MpscQueue
+{
+  public:
+    MpscQueue() : head(new Node()), tail(head.load())
+    {
+    }
+
+    ~MpscQueue()
+    {
+        T value;
+        while (pop(value))
+        {
+        }
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value)
+    {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only; false if nothing is linked yet
+    bool pop(T& value)
+    {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+
+        // The popped node is the dummy from now on
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    // Consumer only
+    bool isEmpty() const
+    {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    std::atomic<Node*> head;
+    Node* tail;
+};
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,57 @@
+#include "PidWatcher.h"
+
+#if defined(Q_OS_LINUX)
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#endif
+
+PidWatcher::PidWatcher(int pid, QObject* parent) : QObject(parent), pid(pid)
+{
+#if defined(Q_OS_LINUX)
+    if (pid <= 0)
+        return;
+
+    // Fails with ENOSYS before Linux 5.3 and ESRCH if the process is already gone
+    pidfd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+    if (pidfd < 0)
+        return;
+
+    // A pidfd becomes readable once the process exits, whether or not it has been reaped
+    notifier = new QSocketNotifier(pidfd, QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this,
+            [this]()
+            {
+                notifier->setEnabled(false);
+                emit exited(this->pid);
+            });
+#endif
+}
+
+PidWatcher::~PidWatcher()
+{
+#if defined(Q_OS_LINUX)
+    if (notifier)
+    {
+        notifier->setEnabled(false);
+    }
+
+    if (pidfd >= 0)
+    {
+        ::close(pidfd);
+    }
+#endif
+}
+
+bool PidWatcher::isValid() const
+{
+    return pidfd >= 0;
+}
+
+int PidWatcher::getPid() const
+{
+    return pid;
+}
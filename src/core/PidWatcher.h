@@ -0,0 +1,29 @@
+#ifndef PIDWATCHER_H
+#define PIDWATCHER_H
+
+#include <QObject>
+#include <QSocketNotifier>
+
+// Emits exited() as soon as a PID terminates, using a pidfd on Linux. Works for processes that are
+// not our children. isValid() is false where pidfds are unavailable and the caller has to poll.
+class PidWatcher : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit PidWatcher(int pid, QObject* parent = nullptr);
+    ~PidWatcher();
+
+    bool isValid() const;
+    int getPid() const;
+
+  signals:
+    void exited(int pid);
+
+  private:
+    int pid = 0;
+    int pidfd = -1;
+    QSocketNotifier* notifier = nullptr;
+};
+
+#endif // PIDWATCHER_H
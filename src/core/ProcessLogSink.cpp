@@ -0,0 +1,126 @@
+#include "ProcessLogSink.h"
+#include "LogIndexer.h"
+#include "Logger.h"
+#include <QDateTime>
+
+ProcessLogSink::ProcessLogSink(const QString& directoryPath, int bufferLimit, int flushIntervalMs, QObject* parent)
+    : QObject(parent), log(directoryPath), bufferLimit(bufferLimit)
+{
+    buffer.reserve(bufferLimit);
+
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(flushIntervalMs);
+    connect(flushTimer, &QTimer::timeout, this, &ProcessLogSink::flush);
+}
+
+ProcessLogSink::~ProcessLogSink()
+{
+    close();
+}
+
+bool ProcessLogSink::open()
+{
+    return log.openForAppend();
+}
+
+bool ProcessLogSink::isOpen() const
+{
+    return log.isOpen();
+}
+
+QString ProcessLogSink::directoryPath() const
+{
+    return log.directoryPath();
+}
+
+qint64 ProcessLogSink::position() const
+{
+    return log.isOpen() ? log.endOffset() + buffer.size() : 0;
+}
+
+void ProcessLogSink::write(const QByteArray& data)
+{
+    if (data.isEmpty() || !log.isOpen())
+        return;
+
+    // A chunk that would not fit goes straight to the log behind whatever is buffered
+    if (buffer.size() + data.size() > bufferLimit)
+    {
+        flush();
+        if (data.size() >= bufferLimit)
+        {
+            stamp(log.endOffset());
+            if (log.append(data))
+                writeStamps();
+            else
+                pendingStamps.clear();
+            return;
+        }
+    }
+
+    stamp(position());
+    buffer.append(data);
+
+    if (!flushTimer->isActive())
+    {
+        flushTimer->start();
+    }
+}
+
+bool ProcessLogSink::flush()
+{
+    flushTimer->stop();
+
+    if (buffer.isEmpty() || !log.isOpen())
+        return true;
+
+    // The log hands the bytes to the OS right away, so viewers reading the segments see them
+    const bool written = log.append(buffer);
+    buffer.resize(0); // keeps the reserved capacity, unlike clear()
+
+    if (!written)
+    {
+        pendingStamps.clear();
+        LOG_WARNING_IN(Logs, "Failed to write to the log in " + log.directoryPath());
+    }
+    else
+    {
+        writeStamps();
+        LogIndexer::instance().schedule(log.directoryPath());
+    }
+    return written;
+}
+
+void ProcessLogSink::close()
+{
+    if (!log.isOpen())
+        return;
+
+    flush();
+    log.close();
+}
+
+int ProcessLogSink::pendingBytes() const
+{
+    return buffer.size();
+}
+
+void ProcessLogSink::stamp(qint64 offset)
+{
+    // Chunks received within the same millisecond share a stamp
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now == lastStampTime)
+        return;
+
+    lastStampTime = now;
+    pendingStamps.append({offset, now});
+}
+
+bool ProcessLogSink::writeStamps()
+{
+    // The log never splits one append across segments, so all of them belong to the newest one
+    const bool written = LogTimeline::append(log, pendingStamps);
+    pendingStamps.clear();
+    return written;
+}
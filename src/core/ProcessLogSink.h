@@ -0,0 +1,51 @@
+#ifndef PROCESSLOGSINK_H
+#define PROCESSLOGSINK_H
+
+#include "LogTimeline.h"
+#include "SegmentedLog.h"
+#include <QByteArray>
+#include <QObject>
+#include <QTimer>
+
+// Append-only log of one running process. The segmented log stays open for the lifetime of the sink and
+// output is written as raw bytes: chunks collect in a bounded buffer that is written out once it holds
+// BufferLimit bytes or FlushIntervalMs after the first unwritten chunk, whichever comes first. Every
+// chunk is stamped with the time it was received; the stamps are written with it, see LogTimeline.
+class ProcessLogSink : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ProcessLogSink(const QString& directoryPath, int bufferLimit = BufferLimit,
+                            int flushIntervalMs = FlushIntervalMs, QObject* parent = nullptr);
+    ~ProcessLogSink();
+
+    bool open();
+    bool isOpen() const;
+    QString directoryPath() const;
+
+    // Log offset at which the next written byte will land
+    qint64 position() const;
+
+    void write(const QByteArray& data);
+    bool flush();
+    void close();
+
+    int pendingBytes() const;
+
+    static constexpr int BufferLimit = 64 * 1024;
+    static constexpr int FlushIntervalMs = 100;
+
+  private:
+    void stamp(qint64 offset);
+    bool writeStamps();
+
+    SegmentedLog log;
+    QByteArray buffer;
+    QList<LogStamp> pendingStamps;
+    qint64 lastStampTime = 0;
+    int bufferLimit;
+    QTimer* flushTimer = nullptr;
+};
+
+#endif // PROCESSLOGSINK_H
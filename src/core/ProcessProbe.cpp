@@ -0,0 +1,641 @@
+#include "ProcessProbe.h"
+#include "Logger.h"
+#include <QFile>
+#include <QList>
+
+#if defined(Q_OS_WIN)
+#include <QProcess>
+#include <QRegularExpression>
+#else
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <arpa/inet.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+namespace
+{
+    // TCP_LISTEN as written in the "st" column of /proc/net/tcp
+    constexpr char ListenState[] = "0A";
+
+    QList<QByteArray> splitFields(const QByteArray& line, int maxFields)
+    {
+        QList<QByteArray> fields;
+        const char* data = line.constData();
+        const int size = line.size();
+        int i = 0;
+
+        while (i < size && fields.size() < maxFields)
+        {
+            while (i < size && (data[i] == ' ' || data[i] == '\t'))
+                ++i;
+
+            int start = i;
+            while (i < size && data[i] != ' ' && data[i] != '\t')
+                ++i;
+
+            if (i > start)
+                fields.append(QByteArray(data + start, i - start));
+        }
+
+        return fields;
+    }
+} // namespace
+
+QHash<int, quint64> ProcessProbe::parseListenSockets(const QByteArray& table)
+{
+    QHash<int, quint64> sockets;
+    const QList<QByteArray> lines = table.split('\n');
+
+    // First line is the column header
+    for (int i = 1; i < lines.size(); ++i)
+    {
+        // sl local_address rem_address st tx:rx tr:when retrnsmt uid timeout inode
+        const QList<QByteArray> fields = splitFields(lines[i], 10);
+        if (fields.size() < 10 || fields[3] != ListenState)
+            continue;
+
+        const QByteArray& local = fields[1];
+        int colon = local.lastIndexOf(':');
+        if (colon < 0)
+            continue;
+
+        bool portOk = false;
+        bool inodeOk = false;
+        int port = local.mid(colon + 1).toInt(&portOk, 16);
+        quint64 inode = fields[9].toULongLong(&inodeOk);
+
+        if (portOk && inodeOk && port > 0 && inode > 0)
+            sockets.insert(port, inode);
+    }
+
+    return sockets;
+}
+
+bool ProcessProbe::parseProcessStat(const QByteArray& stat, ProcessEntry& entry)
+{
+    // "pid (comm) state ppid pgrp session ..."; comm may itself contain spaces and parentheses
+    int commStart = stat.indexOf('(');
+    int commEnd = stat.lastIndexOf(')');
+    if (commStart <= 0 || commEnd < commStart)
+        return false;
+
+    const QList<QByteArray> fields = splitFields(stat.mid(commEnd + 1), 4);
+    if (fields.size() < 4 || fields[0].isEmpty())
+        return false;
+
+    bool pidOk = false;
+    bool parentOk = false;
+    bool groupOk = false;
+    bool sessionOk = false;
+    entry.pid = stat.left(commStart).trimmed().toInt(&pidOk);
+    entry.state = fields[0].at(0);
+    entry.parentPid = fields[1].toInt(&parentOk);
+    entry.processGroupId = fields[2].toInt(&groupOk);
+    entry.sessionId = fields[3].toInt(&sessionOk);
+
+    return pidOk && parentOk && groupOk && sessionOk;
+}
+
+QList<int> ProcessProbe::findProcessGroupMembers(int processGroupId)
+{
+    QList<int> members;
+    if (processGroupId <= 0)
+        return members;
+
+    for (const ProcessEntry& entry : processTable())
+    {
+        if (entry.processGroupId == processGroupId && entry.state != 'Z')
+            members.append(entry.pid);
+    }
+
+    return members;
+}
+
+#if defined(Q_OS_WIN)
+
+QList<ProcessProbe::ProcessEntry> ProcessProbe::processTable()
+{
+    return {};
+}
+
+QList<ProcessProbe::ProcessEntry> ProcessProbe::findChildren(int pid)
+{
+    Q_UNUSED(pid)
+    return {};
+}
+
+QList<int> ProcessProbe::findDescendants(int pid)
+{
+    Q_UNUSED(pid)
+    return {};
+}
+
+QList<int> ProcessProbe::readChildPids(int pid)
+{
+    Q_UNUSED(pid)
+    return {};
+}
+
+QSet<int> ProcessProbe::livePids()
+{
+    QSet<int> pids;
+
+    QProcess tasklist;
+    tasklist.start("tasklist", {"/FO", "CSV", "/NH"});
+    tasklist.waitForFinished();
+
+    // "image.exe","1234","Console","1","12,345 K"
+    for (const QByteArray& line : tasklist.readAllStandardOutput().split('\n'))
+    {
+        const QList<QByteArray> fields = line.split(',');
+        if (fields.size() < 2)
+            continue;
+
+        bool ok = false;
+        int pid = QByteArray(fields[1]).replace('"', "").toInt(&ok);
+        if (ok && pid > 0)
+            pids.insert(pid);
+    }
+
+    return pids;
+}
+
+bool ProcessProbe::isProcessRunning(int pid)
+{
+    if (pid <= 0)
+        return false;
+
+    QProcess process;
+    process.start("tasklist", {"/FI", QString("PID eq %1").arg(pid)});
+    process.waitForFinished();
+
+    QString output = process.readAllStandardOutput();
+    return output.contains(QString::number(pid));
+}
+
+int ProcessProbe::findPidByPort(int port)
+{
+    if (port <= 0)
+        return 0;
+
+    return listeningPorts().value(port, 0);
+}
+
+QHash<int, int> ProcessProbe::listeningPorts()
+{
+    QHash<int, int> ports;
+
+    QProcess netstat;
+    netstat.start("netstat", {"-ano", "-p", "TCP"});
+    netstat.waitForFinished();
+
+    QString output = netstat.readAllStandardOutput();
+    QRegularExpression re(R"(^\s*TCP\s+\S+:(\d+)\s+\S+\s+LISTENING\s+(\d+)\s*$)");
+
+    for (const QString& line : output.split('\n', Qt::SkipEmptyParts))
+    {
+        QRegularExpressionMatch match = re.match(line);
+        if (match.hasMatch())
+        {
+            int pid = match.captured(2).toInt();
+            if (pid != 0)
+                ports.insert(match.captured(1).toInt(), pid);
+        }
+    }
+
+    return ports;
+}
+
+QSet<int> ProcessProbe::findListeningPorts(const QSet<int>& ports)
+{
+    QSet<int> listening;
+    QHash<int, int> owners = listeningPorts();
+    for (int port : ports)
+    {
+        if (owners.contains(port))
+            listening.insert(port);
+    }
+    return listening;
+}
+
+QHash<int, quint64> ProcessProbe::readListenSockets()
+{
+    return {};
+}
+
+bool ProcessProbe::queryListenSockets(int family, const QSet<int>& ports, QSet<int>& listening)
+{
+    Q_UNUSED(family)
+    Q_UNUSED(ports)
+    Q_UNUSED(listening)
+    return false;
+}
+
+QHash<quint64, int> ProcessProbe::findSocketOwners(const QSet<quint64>& inodes)
+{
+    Q_UNUSED(inodes)
+    return {};
+}
+
+#else
+
+QList<ProcessProbe::ProcessEntry> ProcessProbe::processTable()
+{
+    QList<ProcessEntry> table;
+
+    DIR* proc = ::opendir("/proc");
+    if (!proc)
+        return table;
+
+    while (dirent* entry = ::readdir(proc))
+    {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+
+        char statPath[64];
+        std::snprintf(statPath, sizeof(statPath), "/proc/%s/stat", entry->d_name);
+
+        QFile stat(statPath);
+        if (!stat.open(QIODevice::ReadOnly))
+            continue;
+
+        ProcessEntry process;
+        if (parseProcessStat(stat.read(512), process))
+            table.append(process);
+    }
+
+    ::closedir(proc);
+    return table;
+}
+
+QList<int> ProcessProbe::readChildPids(int pid)
+{
+    QList<int> childPids;
+
+    char taskDirPath[64];
+    std::snprintf(taskDirPath, sizeof(taskDirPath), "/proc/%d/task", pid);
+
+    DIR* taskDir = ::opendir(taskDirPath);
+    if (!taskDir)
+        return childPids;
+
+    // Children are listed per thread that forked them
+    while (dirent* task = ::readdir(taskDir))
+    {
+        if (task->d_name[0] < '0' || task->d_name[0] > '9')
+            continue;
+
+        QFile childrenFile(QString("%1/%2/children").arg(taskDirPath, task->d_name));
+        if (!childrenFile.open(QIODevice::ReadOnly))
+            continue;
+
+        for (const QByteArray& childPid : childrenFile.readAll().split(' '))
+        {
+            bool ok = false;
+            int child = childPid.trimmed().toInt(&ok);
+            if (ok && child > 0)
+                childPids.append(child);
+        }
+    }
+
+    ::closedir(taskDir);
+    return childPids;
+}
+
+QSet<int> ProcessProbe::livePids()
+{
+    QSet<int> pids;
+    for (const ProcessEntry& entry : processTable())
+    {
+        if (entry.state != 'Z')
+            pids.insert(entry.pid);
+    }
+    return pids;
+}
+
+QList<ProcessProbe::ProcessEntry> ProcessProbe::findChildren(int pid)
+{
+    QList<ProcessEntry> children;
+
+    for (int childPid : readChildPids(pid))
+    {
+        char statPath[64];
+        std::snprintf(statPath, sizeof(statPath), "/proc/%d/stat", childPid);
+
+        QFile stat(statPath);
+        ProcessEntry child;
+        if (stat.open(QIODevice::ReadOnly) && parseProcessStat(stat.read(512), child))
+            children.append(child);
+    }
+
+    return children;
+}
+
+QList<int> ProcessProbe::findDescendants(int pid)
+{
+    QList<int> descendants;
+    if (pid <= 0)
+        return descendants;
+
+    // Breadth first; the list doubles as the queue
+    descendants.append(pid);
+    for (int i = 0; i < descendants.size(); ++i)
+    {
+        for (int child : readChildPids(descendants[i]))
+        {
+            if (!descendants.contains(child))
+                descendants.append(child);
+        }
+    }
+
+    descendants.removeFirst();
+    return descendants;
+}
+
+bool ProcessProbe::isProcessRunning(int pid)
+{
+    if (pid <= 0)
+        return false;
+
+    // Signal 0 only performs the existence and permission checks
+    if (::kill(pid, 0) != 0 && errno != EPERM)
+        return false;
+
+#if defined(Q_OS_LINUX)
+    // A zombie still accepts signals until its parent reaps it, but it is no longer running
+    char statPath[32];
+    std::snprintf(statPath, sizeof(statPath), "/proc/%d/stat", pid);
+
+    QFile stat(statPath);
+    if (stat.open(QIODevice::ReadOnly))
+    {
+        QByteArray content = stat.read(512);
+        int commEnd = content.lastIndexOf(')');
+        if (commEnd > 0 && commEnd + 2 < content.size() && content.at(commEnd + 2) == 'Z')
+            return false;
+    }
+#endif
+
+    return true;
+}
+
+int ProcessProbe::findPidByPort(int port)
+{
+    if (port <= 0)
+        return 0;
+
+    QHash<int, quint64> sockets = readListenSockets();
+    auto it = sockets.constFind(port);
+    if (it == sockets.constEnd())
+        return 0;
+
+    return findSocketOwners({it.value()}).value(it.value(), 0);
+}
+
+QHash<int, int> ProcessProbe::listeningPorts()
+{
+    QHash<int, int> ports;
+    QHash<int, quint64> sockets = readListenSockets();
+    if (sockets.isEmpty())
+        return ports;
+
+    QSet<quint64> inodes;
+    for (auto it = sockets.constBegin(); it != sockets.constEnd(); ++it)
+        inodes.insert(it.value());
+
+    QHash<quint64, int> owners = findSocketOwners(inodes);
+    for (auto it = sockets.constBegin(); it != sockets.constEnd(); ++it)
+    {
+        int pid = owners.value(it.value(), 0);
+        if (pid > 0)
+            ports.insert(it.key(), pid);
+    }
+
+    return ports;
+}
+
+QSet<int> ProcessProbe::findListeningPorts(const QSet<int>& ports)
+{
+    QSet<int> listening;
+    if (ports.isEmpty())
+        return listening;
+
+#if defined(Q_OS_LINUX)
+    if (queryListenSockets(AF_INET, ports, listening) && queryListenSockets(AF_INET6, ports, listening))
+        return listening;
+
+    listening.clear();
+#endif
+
+    QHash<int, quint64> sockets = readListenSockets();
+    for (int port : ports)
+    {
+        if (sockets.contains(port))
+            listening.insert(port);
+    }
+    return listening;
+}
+
+#if defined(Q_OS_LINUX)
+
+namespace
+{
+    constexpr quint32 TcpListenState = 10;
+
+    // Bytecode accepting sockets whose source port equals any of the ports, compiled as
+    // "a || (b || (...))" the way ss does it so every jump target passes the kernel audit
+    QByteArray compilePortFilter(const QList<int>& ports, int index = 0)
+    {
+        QByteArray bytecode;
+
+        inet_diag_bc_op condition[2] = {{INET_DIAG_BC_S_EQ, 8, 12}, {0, 0, static_cast<quint16>(ports[index])}};
+        bytecode.append(reinterpret_cast<const char*>(condition), sizeof(condition));
+
+        if (index + 1 < ports.size())
+        {
+            QByteArray rest = compilePortFilter(ports, index + 1);
+            inet_diag_bc_op jump = {INET_DIAG_BC_JMP, 4, static_cast<quint16>(rest.size() + 4)};
+            bytecode.append(reinterpret_cast<const char*>(&jump), sizeof(jump));
+            bytecode.append(rest);
+        }
+
+        return bytecode;
+    }
+} // namespace
+
+#endif
+
+bool ProcessProbe::queryListenSockets(int family, const QSet<int>& ports, QSet<int>& listening)
+{
+#if defined(Q_OS_LINUX)
+    int fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0)
+        return false;
+
+    QList<int> portList = ports.values();
+    QByteArray bytecode = compilePortFilter(portList);
+
+    struct
+    {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message = {};
+
+    const int attributeOffset = NLMSG_ALIGN(sizeof(message));
+    QByteArray packet(attributeOffset + NLA_ALIGN(NLA_HDRLEN + bytecode.size()), '\0');
+
+    message.header.nlmsg_len = packet.size();
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = family;
+    message.request.sdiag_protocol = IPPROTO_TCP;
+    message.request.idiag_states = 1u << TcpListenState;
+    std::memcpy(packet.data(), &message, sizeof(message));
+
+    auto* attribute = reinterpret_cast<nlattr*>(packet.data() + attributeOffset);
+    attribute->nla_type = INET_DIAG_REQ_BYTECODE;
+    attribute->nla_len = NLA_HDRLEN + bytecode.size();
+    std::memcpy(packet.data() + attributeOffset + NLA_HDRLEN, bytecode.constData(), bytecode.size());
+
+    sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+
+    if (::sendto(fd, packet.constData(), packet.size(), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    bool ok = true;
+    bool done = false;
+    char buffer[16384];
+
+    while (!done)
+    {
+        ssize_t length = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (length <= 0)
+        {
+            ok = false;
+            break;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (auto* header = reinterpret_cast<nlmsghdr*>(buffer); NLMSG_OK(header, remaining);
+             header = NLMSG_NEXT(header, remaining))
+        {
+            if (header->nlmsg_type == NLMSG_DONE)
+            {
+                done = true;
+                break;
+            }
+
+            if (header->nlmsg_type == NLMSG_ERROR)
+            {
+                // Kernels without INET_DIAG_BC_S_EQ reject the filter; the caller falls back to procfs
+                ok = false;
+                done = true;
+                break;
+            }
+
+            auto* socketInfo = static_cast<inet_diag_msg*>(NLMSG_DATA(header));
+            listening.insert(ntohs(socketInfo->id.idiag_sport));
+        }
+    }
+
+    ::close(fd);
+    return ok;
+#else
+    Q_UNUSED(family)
+    Q_UNUSED(ports)
+    Q_UNUSED(listening)
+    return false;
+#endif
+}
+
+QHash<int, quint64> ProcessProbe::readListenSockets()
+{
+    QHash<int, quint64> sockets;
+
+    for (const char* path : {"/proc/net/tcp", "/proc/net/tcp6"})
+    {
+        QFile table(path);
+        if (!table.open(QIODevice::ReadOnly))
+            continue;
+
+        // procfs reports a size of 0, so read until EOF instead of trusting size()
+        sockets.insert(parseListenSockets(table.readAll()));
+    }
+
+    return sockets;
+}
+
+QHash<quint64, int> ProcessProbe::findSocketOwners(const QSet<quint64>& inodes)
+{
+    QHash<quint64, int> owners;
+    if (inodes.isEmpty())
+        return owners;
+
+    DIR* proc = ::opendir("/proc");
+    if (!proc)
+    {
+        LOG_WARNING_IN(Process, "Failed to open /proc: " + QString::fromLocal8Bit(std::strerror(errno)));
+        return owners;
+    }
+
+    constexpr char SocketPrefix[] = "socket:[";
+    constexpr int SocketPrefixLength = sizeof(SocketPrefix) - 1;
+
+    while (dirent* entry = ::readdir(proc))
+    {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+
+        char fdDirPath[64];
+        std::snprintf(fdDirPath, sizeof(fdDirPath), "/proc/%s/fd", entry->d_name);
+
+        // Fails with EACCES for processes owned by other users, which we could not manage anyway
+        DIR* fdDir = ::opendir(fdDirPath);
+        if (!fdDir)
+            continue;
+
+        int fdDirFd = ::dirfd(fdDir);
+        while (dirent* fdEntry = ::readdir(fdDir))
+        {
+            if (fdEntry->d_name[0] == '.')
+                continue;
+
+            char target[64];
+            ssize_t length = ::readlinkat(fdDirFd, fdEntry->d_name, target, sizeof(target) - 1);
+            if (length <= SocketPrefixLength || std::strncmp(target, SocketPrefix, SocketPrefixLength) != 0)
+                continue;
+
+            target[length] = '\0';
+            quint64 inode = std::strtoull(target + SocketPrefixLength, nullptr, 10);
+            if (inodes.contains(inode) && !owners.contains(inode))
+                owners.insert(inode, std::atoi(entry->d_name));
+        }
+
+        ::closedir(fdDir);
+
+        if (owners.size() == inodes.size())
+            break;
+    }
+
+    ::closedir(proc);
+    return owners;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef PROCESSPROBE_H
+#define PROCESSPROBE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+
+class ProcessProbe
+{
+  public:
+    struct ProcessEntry
+    {
+        int pid = 0;
+        int parentPid = 0;
+        int processGroupId = 0;
+        int sessionId = 0;
+        char state = '?';
+    };
+
+    // Returns true if a process with the given PID is alive
+    static bool isProcessRunning(int pid);
+
+    // Every live (non-zombie) PID on the system, from one scan of the process table
+    static QSet<int> livePids();
+
+    // Returns the PID owning a listening TCP socket on the given port, or 0 if none
+    static int findPidByPort(int port);
+
+    // Maps every listening TCP port to the PID that owns it
+    static QHash<int, int> listeningPorts();
+
+    // Returns which of the given ports have a LISTEN socket, without resolving owners.
+    // Uses a filtered NETLINK_SOCK_DIAG dump on Linux, so the cost does not grow with the socket table.
+    static QSet<int> findListeningPorts(const QSet<int>& ports);
+
+    // Snapshot of every process visible in /proc with its parent, process group and session. Empty elsewhere.
+    static QList<ProcessEntry> processTable();
+
+    // Direct children of a process, read from /proc/<pid>/task/*/children
+    static QList<ProcessEntry> findChildren(int pid);
+
+    // Every PID below the given one in the process tree, breadth first, without reading their stat
+    static QList<int> findDescendants(int pid);
+
+    // Returns the live (non-zombie) members of a process group
+    static QList<int> findProcessGroupMembers(int processGroupId);
+
+    // Parses the contents of /proc/<pid>/stat; returns false for malformed input
+    static bool parseProcessStat(const QByteArray& stat, ProcessEntry& entry);
+
+    // Parses a /proc/net/tcp or /proc/net/tcp6 table into port -> socket inode for LISTEN sockets
+    static QHash<int, quint64> parseListenSockets(const QByteArray& table);
+
+  private:
+    static QList<int> readChildPids(int pid);
+    static QHash<int, quint64> readListenSockets();
+    static bool queryListenSockets(int family, const QSet<int>& ports, QSet<int>& listening);
+    static QHash<quint64, int> findSocketOwners(const QSet<quint64>& inodes);
+};
+
+#endif // PROCESSPROBE_H
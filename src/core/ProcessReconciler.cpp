@@ -0,0 +1,159 @@
+#include "ProcessReconciler.h"
+#include "Logger.h"
+#include "ProcessProbe.h"
+#include "ProcessSupervisor.h"
+#include <QDateTime>
+#include <QPointer>
+
+int ProcessReconciler::run(IProcessRepository& processRepository)
+{
+    QList<Process> processes = unsupervised(processRepository.findActive());
+    if (processes.isEmpty())
+        return 0;
+
+    return apply(processRepository, processes, takeSnapshot(processes));
+}
+
+void ProcessReconciler::runAsync(IProcessRepository& processRepository, QObject* context,
+                                 std::function<void(int changed)> done)
+{
+    QList<Process> processes = unsupervised(processRepository.findActive());
+    if (processes.isEmpty())
+    {
+        QMetaObject::invokeMethod(context, [done]() { done(0); }, Qt::QueuedConnection);
+        return;
+    }
+
+    // The result is posted through the supervisor, which outlives its worker, and only checked against
+    // context on the GUI thread; context itself may be destroyed while the snapshot is taken
+    QPointer<QObject> guard(context);
+    ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+
+    // Listing the process and socket tables forks tasklist and netstat on Windows
+    supervisor.runOnWorker(
+        [&processRepository, &supervisor, guard, done, processes]()
+        {
+            Snapshot snapshot = takeSnapshot(processes);
+            QMetaObject::invokeMethod(
+                &supervisor,
+                [&processRepository, guard, done, processes, snapshot]()
+                {
+                    if (!guard)
+                        return;
+                    // Started meanwhile; the supervisor keeps those up to date now
+                    done(apply(processRepository, unsupervised(processes), snapshot));
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+QList<Process> ProcessReconciler::unsupervised(const QList<Process>& processes)
+{
+    // Processes the supervisor already follows are kept up to date by it
+    QList<Process> result;
+    for (const Process& process : processes)
+    {
+        if (!ProcessSupervisor::instance().isSupervised(process.getId()))
+            result.append(process);
+    }
+    return result;
+}
+
+int ProcessReconciler::apply(IProcessRepository& processRepository, const QList<Process>& processes,
+                             const Snapshot& snapshot)
+{
+    QList<Process> corrected = reconcile(processes, snapshot);
+    if (!corrected.isEmpty() && !processRepository.updateRuntimeStates(corrected))
+    {
+        LOG_ERROR_IN(Process, "Failed to persist reconciled process states");
+        return 0;
+    }
+
+    LOG_INFO_IN(Process, "Reconciled " + QString::number(processes.size()) + " active processes, " +
+                QString::number(corrected.size()) + " changed");
+    return corrected.size();
+}
+
+ProcessReconciler::Snapshot ProcessReconciler::takeSnapshot(const QList<Process>& processes)
+{
+    Snapshot snapshot;
+
+#if defined(Q_OS_WIN) || defined(Q_OS_LINUX)
+    snapshot.livePids = ProcessProbe::livePids();
+#else
+    // No process table to list; signalling each PID is just as cheap
+    for (const Process& process : processes)
+    {
+        if (ProcessProbe::isProcessRunning(process.getPID()))
+            snapshot.livePids.insert(process.getPID());
+    }
+#endif
+
+    if (needsPortOwners(processes, snapshot.livePids))
+    {
+        snapshot.portOwners = ProcessProbe::listeningPorts();
+    }
+
+    return snapshot;
+}
+
+bool ProcessReconciler::needsPortOwners(const QList<Process>& processes, const QSet<int>& livePids)
+{
+    // The socket table is only read when a PID is gone or a start never completed
+    for (const Process& process : processes)
+    {
+        if (process.getPort() <= 0)
+            continue;
+
+        const bool alive = process.getPID() > 0 && livePids.contains(process.getPID());
+        if (!alive || process.getStatus() == Process::Status::Starting)
+            return true;
+    }
+    return false;
+}
+
+QList<Process> ProcessReconciler::reconcile(const QList<Process>& processes, const Snapshot& snapshot)
+{
+    QList<Process> corrected;
+
+    for (Process process : processes)
+    {
+        const int pid = process.getPID();
+        const bool alive = pid > 0 && snapshot.livePids.contains(pid);
+        const int portOwner = process.getPort() > 0 ? snapshot.portOwners.value(process.getPort(), 0) : 0;
+
+        if (alive && process.getStatus() == Process::Status::Running)
+            continue;
+
+        // A Starting row outlived the QProcess that was launching it; only a bound port makes it
+        // Running. While its PID lives without the port it stays Starting for the supervisor to await.
+        if (alive && process.getStatus() == Process::Status::Starting && portOwner <= 0)
+            continue;
+
+        if (alive && process.getStatus() != Process::Status::Starting)
+        {
+            process.setStatus(Process::Status::Running);
+        }
+        else if (portOwner > 0)
+        {
+            process.setStatus(Process::Status::Running);
+            process.setPID(portOwner);
+        }
+        else if (process.getStatus() == Process::Status::Error)
+        {
+            // Nothing left running; keep the error visible but drop the dead PID
+            if (pid == 0)
+                continue;
+            process.setPID(0);
+        }
+        else
+        {
+            process.setStatus(Process::Status::Stopped);
+            process.setPID(0);
+        }
+
+        corrected.append(process);
+    }
+
+    return corrected;
+}
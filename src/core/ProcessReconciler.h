@@ -0,0 +1,48 @@
+#ifndef PROCESSRECONCILER_H
+#define PROCESSRECONCILER_H
+
+#include "../repositories/interfaces/IProcessRepository.h"
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <functional>
+
+// Brings persisted process state in line with the system in one pass: loads every process that is
+// not stopped, checks all of them against a single snapshot of the process and socket tables and
+// writes the corrections in one transaction. Runs at startup and when a project is opened.
+class ProcessReconciler
+{
+  public:
+    struct Snapshot
+    {
+        QSet<int> livePids;
+        QHash<int, int> portOwners;
+    };
+
+    // Reconciles every active process not already tracked by the supervisor; returns how many changed
+    static int run(IProcessRepository& processRepository);
+
+    // Same without blocking the GUI thread: the snapshot is taken on the supervisor's worker, the
+    // corrections are written on the thread of context and done gets how many changed. Nothing is
+    // written if context is gone by then.
+    static void runAsync(IProcessRepository& processRepository, QObject* context,
+                         std::function<void(int changed)> done);
+
+    // Liveness of the processes' PIDs, plus port owners only if some process needs them
+    static Snapshot takeSnapshot(const QList<Process>& processes);
+
+    // Whether reconcile() needs the port owners: a process with a port whose PID is gone, or one
+    // that was still starting and is only Running once its port is bound
+    static bool needsPortOwners(const QList<Process>& processes, const QSet<int>& livePids);
+
+    // Returns the processes whose state does not match the snapshot, already corrected
+    static QList<Process> reconcile(const QList<Process>& processes, const Snapshot& snapshot);
+
+  private:
+    static QList<Process> unsupervised(const QList<Process>& processes);
+    static int apply(IProcessRepository& processRepository, const QList<Process>& processes,
+                     const Snapshot& snapshot);
+};
+
+#endif // PROCESSRECONCILER_H
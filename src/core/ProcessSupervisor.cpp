@@ -0,0 +1,631 @@
+#include "ProcessSupervisor.h"
+#include "Logger.h"
+#include "ProcessProbe.h"
+#include <QMutex>
+#include <QProcess>
+#include <QSet>
+#include <algorithm>
+#include <memory>
+
+#if !defined(Q_OS_WIN)
+#include <cerrno>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+#include <sys/prctl.h>
+#endif
+
+namespace
+{
+    // Commands launched through trackLaunch(), shared with the worker thread
+    struct Launches
+    {
+        QMutex mutex;
+        // PIDs whose exit status belongs to a QProcess
+        QSet<int> children;
+        // Started but not reported their PID yet; any zombie might be one of them
+        int pending = 0;
+        // Process groups led by a launched command, until no member is left
+        QSet<int> groups;
+    };
+
+    Launches& launches()
+    {
+        static Launches instance;
+        return instance;
+    }
+}
+
+ProcessSupervisor& ProcessSupervisor::instance()
+{
+    static ProcessSupervisor instance;
+    return instance;
+}
+
+ProcessSupervisor::ProcessSupervisor()
+{
+    sweepTimer = new QTimer(this);
+    connect(sweepTimer, &QTimer::timeout, this, &ProcessSupervisor::sweep);
+
+    workerThread = new QThread(this);
+    workerThread->setObjectName("ProcessSupervisor");
+    worker = new QObject();
+    worker->moveToThread(workerThread);
+    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    workerThread->start();
+
+#if defined(Q_OS_LINUX)
+    // Descendants whose parent dies (npm exiting before node) are re-parented to us instead of
+    // init, so they stay in reach of stop() and never linger as unmanaged orphans holding ports
+    if (::prctl(PR_SET_CHILD_SUBREAPER, 1) != 0)
+    {
+        LOG_WARNING_IN(Process, "Failed to register as child subreaper");
+    }
+#endif
+}
+
+ProcessSupervisor::~ProcessSupervisor()
+{
+    workerThread->quit();
+    workerThread->wait();
+}
+
+void ProcessSupervisor::awaitPort(int processId, int port, int timeoutMs)
+{
+    Target target;
+    target.port = port;
+    target.starting = true;
+    target.deadline = QDeadlineTimer(timeoutMs);
+    track(processId, target);
+}
+
+void ProcessSupervisor::awaitRunning(int processId, int pid, int graceMs)
+{
+    Target target;
+    target.pid = pid;
+    target.starting = true;
+    target.deadline = QDeadlineTimer(graceMs);
+    track(processId, target);
+}
+
+void ProcessSupervisor::monitor(int processId, int pid, int port)
+{
+    Target target;
+    target.pid = pid;
+    target.port = port;
+    track(processId, target);
+}
+
+void ProcessSupervisor::track(int processId, Target target)
+{
+    // Results of a sweep that was already in flight belong to the previous registration
+    target.generation = nextGeneration++;
+    targets.insert(processId, target);
+
+    if (target.starting)
+    {
+        // Restart the backoff so a quick bind() is noticed within milliseconds
+        readinessIntervalMs = ReadinessMinIntervalMs;
+        unwatchExit(processId);
+    }
+    else
+    {
+        watchExit(processId, target.pid);
+    }
+
+    reschedule();
+}
+
+void ProcessSupervisor::watchExit(int processId, int pid)
+{
+    PidWatcher* existing = exitWatchers.value(processId, nullptr);
+    if (existing && existing->getPid() == pid)
+        return;
+
+    unwatchExit(processId);
+
+    auto* watcher = new PidWatcher(pid, this);
+    if (!watcher->isValid())
+    {
+        // No pidfd for this PID; the periodic sweep covers it
+        delete watcher;
+        return;
+    }
+
+    connect(watcher, &PidWatcher::exited, this,
+            [this, processId]()
+            {
+                // Falls back to polling in the unlikely case the sweep still finds the PID alive
+                unwatchExit(processId);
+                requestSweep();
+            });
+    exitWatchers.insert(processId, watcher);
+}
+
+void ProcessSupervisor::trackLaunch(QProcess* process)
+{
+    {
+        QMutexLocker locker(&launches().mutex);
+        ++launches().pending;
+    }
+
+    // 0 while pending, then the PID, and -1 once it is no longer ours to leave alone. The guard is a
+    // child of the QProcess, so it goes after the QProcess destructor collected the exit status;
+    // it also stays connected when the owner disconnects every signal of the QProcess.
+    auto pid = std::make_shared<int>(0);
+    auto forget = [pid]()
+    {
+        QMutexLocker locker(&launches().mutex);
+        if (*pid == 0)
+            --launches().pending;
+        else if (*pid > 0)
+            launches().children.remove(*pid);
+        *pid = -1;
+    };
+    auto* guard = new QObject(process);
+
+    connect(process, &QProcess::started, guard,
+            [process, pid]()
+            {
+                QMutexLocker locker(&launches().mutex);
+                if (*pid != 0)
+                    return;
+                --launches().pending;
+                *pid = static_cast<int>(process->processId());
+                launches().children.insert(*pid);
+#if !defined(Q_OS_WIN)
+                // The child process modifier ran before the command was executed
+                if (::getpgid(*pid) == *pid)
+                    launches().groups.insert(*pid);
+#endif
+            });
+    connect(process, &QProcess::errorOccurred, guard,
+            [forget, pid](QProcess::ProcessError error)
+            {
+                if (error == QProcess::FailedToStart && *pid == 0)
+                    forget();
+            });
+    // Whatever the command left behind was adopted when it exited
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this, forget]()
+            {
+                forget();
+                requestReap();
+            });
+    connect(guard, &QObject::destroyed, this, [forget]() { forget(); });
+}
+
+void ProcessSupervisor::requestReap()
+{
+    QMetaObject::invokeMethod(
+        worker,
+        [this]()
+        {
+            QList<int> orphans = reapOrphans();
+            QMetaObject::invokeMethod(this, [this, orphans]() { watchOrphans(orphans); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+void ProcessSupervisor::watchOrphans(const QList<int>& pids)
+{
+    for (int pid : pids)
+    {
+        if (orphanWatchers.contains(pid))
+            continue;
+
+        auto* watcher = new PidWatcher(pid, this);
+        if (!watcher->isValid())
+        {
+            // Reaped with the next sweep or stop instead
+            delete watcher;
+            continue;
+        }
+
+        connect(watcher, &PidWatcher::exited, this,
+                [this, pid]()
+                {
+                    if (PidWatcher* exited = orphanWatchers.take(pid))
+                        exited->deleteLater();
+                    requestReap();
+                });
+        orphanWatchers.insert(pid, watcher);
+    }
+}
+
+void ProcessSupervisor::unwatchExit(int processId)
+{
+    if (PidWatcher* watcher = exitWatchers.take(processId))
+    {
+        watcher->deleteLater();
+    }
+}
+
+void ProcessSupervisor::stop(int processId, const QList<int>& pids, int port)
+{
+    release(processId);
+
+    QMetaObject::invokeMethod(
+        worker,
+        [this, processId, pids, port]()
+        {
+            terminate(pids, port);
+            QList<int> orphans = reapOrphans();
+            QMetaObject::invokeMethod(
+                this,
+                [this, processId, orphans]()
+                {
+                    watchOrphans(orphans);
+                    emit stopFinished(processId);
+                },
+                Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+void ProcessSupervisor::release(int processId)
+{
+    targets.remove(processId);
+    unwatchExit(processId);
+    reschedule();
+}
+
+bool ProcessSupervisor::isSupervised(int processId) const
+{
+    return targets.contains(processId);
+}
+
+void ProcessSupervisor::runOnWorker(std::function<void()> task)
+{
+    QMetaObject::invokeMethod(worker, std::move(task), Qt::QueuedConnection);
+}
+
+void ProcessSupervisor::requestSweep()
+{
+    if (sweepInFlight)
+    {
+        sweepRequested = true;
+        return;
+    }
+
+    QTimer::singleShot(0, this, &ProcessSupervisor::sweep);
+}
+
+void ProcessSupervisor::reschedule()
+{
+    if (targets.isEmpty())
+    {
+        sweepTimer->stop();
+        return;
+    }
+
+    bool anyStarting = std::any_of(targets.cbegin(), targets.cend(), [](const Target& t) { return t.starting; });
+    bool anyUnwatched = false;
+    for (auto it = targets.cbegin(); it != targets.cend() && !anyUnwatched; ++it)
+    {
+        anyUnwatched = !it->starting && !exitWatchers.contains(it.key());
+    }
+
+    // Everything is covered by pidfds, so nothing needs to wake up until a process exits
+    if (!anyStarting && !anyUnwatched)
+    {
+        sweepTimer->stop();
+        return;
+    }
+
+    int interval = anyStarting ? readinessIntervalMs : MonitorIntervalMs;
+
+    if (!sweepTimer->isActive() || sweepTimer->interval() != interval)
+    {
+        sweepTimer->start(interval);
+    }
+}
+
+void ProcessSupervisor::sweep()
+{
+    if (sweepInFlight || targets.isEmpty())
+        return;
+
+    QList<ProbeRequest> requests;
+    requests.reserve(targets.size());
+    for (auto it = targets.cbegin(); it != targets.cend(); ++it)
+    {
+        requests.append({it.key(), it->pid, it->port, it->starting, it->generation});
+    }
+
+    sweepInFlight = true;
+    QMetaObject::invokeMethod(
+        worker,
+        [this, requests]()
+        {
+            QList<int> orphans = reapOrphans();
+            QList<ProbeResult> results = probe(requests);
+            QMetaObject::invokeMethod(
+                this,
+                [this, results, orphans]()
+                {
+                    watchOrphans(orphans);
+                    applySweep(results);
+                },
+                Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+QList<ProcessSupervisor::ProbeResult> ProcessSupervisor::probe(const QList<ProbeRequest>& requests)
+{
+    QList<ProbeResult> results;
+    results.reserve(requests.size());
+
+    // Starting ports are checked with a cheap filtered socket query first
+    QSet<int> startingPorts;
+    for (const ProbeRequest& request : requests)
+    {
+        if (request.starting && request.port > 0)
+            startingPorts.insert(request.port);
+    }
+    QSet<int> boundPorts = ProcessProbe::findListeningPorts(startingPorts);
+
+    // Liveness by PID is cheap; resolving owners from the socket table is only needed for
+    // starting processes that just bound their port and running processes whose PID died
+    bool needsOwners = false;
+    for (const ProbeRequest& request : requests)
+    {
+        ProbeResult result;
+        result.processId = request.processId;
+        result.generation = request.generation;
+        // A starting process without a port is followed by its PID, like a running one
+        const bool byPid = !request.starting || request.port <= 0;
+        result.alive = byPid && ProcessProbe::isProcessRunning(request.pid);
+        needsOwners = needsOwners || (request.starting ? boundPorts.contains(request.port)
+                                                       : request.port > 0 && !result.alive);
+        results.append(result);
+    }
+
+    if (needsOwners)
+    {
+        QHash<int, int> ports = ProcessProbe::listeningPorts();
+        for (int i = 0; i < requests.size(); ++i)
+        {
+            if (!results[i].alive && requests[i].port > 0)
+                results[i].pidFromPort = ports.value(requests[i].port, 0);
+        }
+    }
+
+    return results;
+}
+
+void ProcessSupervisor::applySweep(const QList<ProbeResult>& results)
+{
+    sweepInFlight = false;
+
+    // Collect transitions first: listeners may call back into monitor() or release()
+    QList<QPair<int, int>> ready;
+    QList<QPair<int, int>> moved;
+    QList<int> timedOut;
+    QList<int> stopped;
+
+    for (const ProbeResult& result : results)
+    {
+        auto it = targets.find(result.processId);
+        if (it == targets.end() || it->generation != result.generation)
+            continue;
+
+        Target& target = it.value();
+
+        if (target.starting && target.port <= 0)
+        {
+            if (!result.alive)
+            {
+                stopped.append(result.processId);
+            }
+            else if (target.deadline.hasExpired())
+            {
+                target.starting = false;
+                ready.append({result.processId, target.pid});
+            }
+        }
+        else if (target.starting)
+        {
+            if (result.pidFromPort > 0)
+            {
+                target.starting = false;
+                target.pid = result.pidFromPort;
+                ready.append({result.processId, result.pidFromPort});
+            }
+            else if (target.deadline.hasExpired())
+            {
+                LOG_INFO_IN(Process, "Timeout: Could not find PID for port " + QString::number(target.port));
+                timedOut.append(result.processId);
+            }
+        }
+        else if (!result.alive)
+        {
+            if (result.pidFromPort > 0)
+            {
+                target.pid = result.pidFromPort;
+                moved.append({result.processId, result.pidFromPort});
+            }
+            else
+            {
+                stopped.append(result.processId);
+            }
+        }
+    }
+
+    // Back off while nothing binds; a ready process means others may follow soon
+    readinessIntervalMs = ready.isEmpty() ? std::min(readinessIntervalMs * 2, ReadinessMaxIntervalMs)
+                                          : ReadinessMinIntervalMs;
+
+    for (int processId : timedOut)
+        release(processId);
+    for (int processId : stopped)
+        release(processId);
+    for (const auto& [processId, pid] : ready)
+        watchExit(processId, pid);
+    for (const auto& [processId, pid] : moved)
+        watchExit(processId, pid);
+
+    reschedule();
+
+    if (sweepRequested)
+    {
+        sweepRequested = false;
+        requestSweep();
+    }
+
+    for (const auto& [processId, pid] : ready)
+        emit processReady(processId, pid);
+    for (const auto& [processId, pid] : moved)
+        emit pidChanged(processId, pid);
+    for (int processId : timedOut)
+        emit startupTimedOut(processId);
+    for (int processId : stopped)
+        emit processStopped(processId);
+}
+
+#if defined(Q_OS_WIN)
+
+void ProcessSupervisor::terminate(const QList<int>& pids, int port)
+{
+    QList<int> targetPids = pids;
+    targetPids.append(ProcessProbe::findPidByPort(port));
+
+    QSet<int> killed;
+    for (int pid : targetPids)
+    {
+        if (pid > 0 && !killed.contains(pid))
+        {
+            QProcess::execute("taskkill", {"/PID", QString::number(pid), "/T", "/F"});
+            killed.insert(pid);
+        }
+    }
+}
+
+QList<int> ProcessSupervisor::reapOrphans()
+{
+    return {};
+}
+
+#else
+
+void ProcessSupervisor::terminate(const QList<int>& pids, int port)
+{
+    QList<int> targetPids = pids;
+    targetPids.append(ProcessProbe::findPidByPort(port));
+
+    // Launched commands lead their own process group, so one signal reaches the whole tree. Any
+    // other PID, a port owner that is not ours or a stale PID taken by someone else, is signalled
+    // on its own rather than taking its group, a terminal job maybe, with it.
+    QSet<int> launchedGroups;
+    {
+        QMutexLocker locker(&launches().mutex);
+        launchedGroups = launches().groups;
+    }
+    QSet<int> groups;
+    QSet<int> singles;
+
+    for (int pid : targetPids)
+    {
+        if (!ProcessProbe::isProcessRunning(pid))
+            continue;
+
+        pid_t group = ::getpgid(pid);
+        if (group > 0 && launchedGroups.contains(group))
+            groups.insert(group);
+        else
+            singles.insert(pid);
+    }
+
+    if (groups.isEmpty() && singles.isEmpty())
+        return;
+
+    auto signalAll = [&](int signal)
+    {
+        for (int group : groups)
+            ::kill(-group, signal);
+        for (int pid : singles)
+            ::kill(pid, signal);
+    };
+
+    auto anyAlive = [&]()
+    {
+        reapOrphans();
+
+#if defined(Q_OS_LINUX)
+        // kill(-group, 0) also succeeds for zombies, so look for live members instead
+        for (const ProcessProbe::ProcessEntry& entry : ProcessProbe::processTable())
+        {
+            if (entry.state != 'Z' && groups.contains(entry.processGroupId))
+                return true;
+        }
+#else
+        for (int group : groups)
+        {
+            if (::kill(-group, 0) == 0)
+                return true;
+        }
+#endif
+
+        return std::any_of(singles.cbegin(), singles.cend(),
+                           [](int pid) { return ProcessProbe::isProcessRunning(pid); });
+    };
+
+    signalAll(SIGTERM);
+
+    QDeadlineTimer deadline(StopTimeoutMs);
+    while (anyAlive() && !deadline.hasExpired())
+    {
+        QThread::msleep(20);
+    }
+
+    if (anyAlive())
+    {
+        LOG_WARNING_IN(Process, "Processes ignored SIGTERM for " + QString::number(StopTimeoutMs) +
+                       " ms, sending SIGKILL");
+        signalAll(SIGKILL);
+    }
+
+    reapOrphans();
+}
+
+QList<int> ProcessSupervisor::reapOrphans()
+{
+    QList<int> orphans;
+    QMutexLocker locker(&launches().mutex);
+
+    // An empty group's ID may be taken by someone else's group; zombies still hold it
+    for (auto it = launches().groups.begin(); it != launches().groups.end();)
+    {
+        if (::kill(-*it, 0) != 0 && errno == ESRCH)
+            it = launches().groups.erase(it);
+        else
+            ++it;
+    }
+
+#if defined(Q_OS_LINUX)
+    const int self = static_cast<int>(::getpid());
+    const int session = static_cast<int>(::getsid(0));
+
+    for (const ProcessProbe::ProcessEntry& child : ProcessProbe::findChildren(self))
+    {
+        // Commands we launched belong to their QProcess, which has to collect the exit status itself.
+        // A child still in our session was forked by us, not adopted: launched commands and whatever
+        // they leave behind run in sessions of their own, daemons that called setsid() again too.
+        if (launches().children.contains(child.pid) || child.sessionId == session)
+            continue;
+
+        if (child.state != 'Z')
+            orphans.append(child.pid);
+        else if (launches().pending == 0)
+            ::waitpid(child.pid, nullptr, WNOHANG);
+    }
+#endif
+
+    return orphans;
+}
+
+#endif
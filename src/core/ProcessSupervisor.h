@@ -0,0 +1,135 @@
+#ifndef PROCESSSUPERVISOR_H
+#define PROCESSSUPERVISOR_H
+
+#include "PidWatcher.h"
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <functional>
+
+class QProcess;
+
+// Owns every monitored process and probes all of them in one batched sweep per tick.
+// Probing and stopping run on a worker thread; results arrive on the GUI thread as signals.
+// Running processes with a pidfd are not polled at all: their exit triggers an immediate sweep.
+class ProcessSupervisor : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static ProcessSupervisor& instance();
+
+    // Waits for a starting process to listen on its port. Readiness is checked every
+    // ReadinessMinIntervalMs at first, backing off to ReadinessMaxIntervalMs while nothing binds.
+    void awaitPort(int processId, int port, int timeoutMs = StartupTimeoutMs);
+
+    // For a starting process without a port, workers and watchers: it is ready once its PID has
+    // survived graceMs, and stopped if the PID dies before that
+    void awaitRunning(int processId, int pid, int graceMs = StartupGraceMs);
+
+    // Watches a running process until neither its PID nor its port is alive
+    void monitor(int processId, int pid, int port);
+
+    // Terminates the given PIDs and whatever owns the port, then emits stopFinished. On Unix a PID in a
+    // process group led by a command from trackLaunch() takes the whole group with it; any other PID
+    // is signalled on its own. SIGTERM comes first, and SIGKILL after StopTimeoutMs.
+    void stop(int processId, const QList<int>& pids, int port);
+
+    // Probes all supervised processes as soon as possible instead of waiting for the next tick
+    void requestSweep();
+
+    // Call before starting a QProcess that launches a command. Its PID is left for the QProcess to
+    // collect; every other child that exits outside our own session, an orphan adopted as subreaper,
+    // is reaped here. A QProcess that starts its command in a session of its own must be tracked, or
+    // its exit status may be reaped from under it; children left in our session are never reaped.
+    // If the command leads a process group of its own, stop() may signal that group as a whole.
+    void trackLaunch(QProcess* process);
+
+    void release(int processId);
+    bool isSupervised(int processId) const;
+
+    // Runs task on the worker thread, after the probes and stops queued before it
+    void runOnWorker(std::function<void()> task);
+
+    static constexpr int StartupTimeoutMs = 15000;
+    static constexpr int StartupGraceMs = 1000;
+#if defined(Q_OS_WIN)
+    // Every readiness check forks netstat on Windows
+    static constexpr int ReadinessMinIntervalMs = 250;
+#else
+    static constexpr int ReadinessMinIntervalMs = 10;
+#endif
+    static constexpr int ReadinessMaxIntervalMs = 500;
+    static constexpr int MonitorIntervalMs = 5000;
+    static constexpr int StopTimeoutMs = 3000;
+
+  signals:
+    void processReady(int processId, int pid);
+    void startupTimedOut(int processId);
+    void pidChanged(int processId, int pid);
+    void processStopped(int processId);
+    void stopFinished(int processId);
+
+  private:
+    ProcessSupervisor();
+    ~ProcessSupervisor();
+    ProcessSupervisor(const ProcessSupervisor&) = delete;
+    ProcessSupervisor& operator=(const ProcessSupervisor&) = delete;
+
+    struct Target
+    {
+        int pid = 0;
+        int port = 0;
+        bool starting = false;
+        QDeadlineTimer deadline;
+        quint64 generation = 0;
+    };
+
+    struct ProbeRequest
+    {
+        int processId = 0;
+        int pid = 0;
+        int port = 0;
+        bool starting = false;
+        quint64 generation = 0;
+    };
+
+    struct ProbeResult
+    {
+        int processId = 0;
+        quint64 generation = 0;
+        bool alive = false;
+        int pidFromPort = 0;
+    };
+
+    void sweep();
+    void applySweep(const QList<ProbeResult>& results);
+    void reschedule();
+    void track(int processId, Target target);
+    void watchExit(int processId, int pid);
+    void unwatchExit(int processId);
+    void requestReap();
+    void watchOrphans(const QList<int>& pids);
+
+    static QList<ProbeResult> probe(const QList<ProbeRequest>& requests);
+    static void terminate(const QList<int>& pids, int port);
+    // Reaps exited orphans, untracked children outside our session, and returns the PIDs of the live ones
+    static QList<int> reapOrphans();
+
+    QHash<int, Target> targets;
+    QHash<int, PidWatcher*> exitWatchers;
+    // Live orphans; their exit triggers a reap, so they never linger as zombies
+    QHash<int, PidWatcher*> orphanWatchers;
+    QTimer* sweepTimer = nullptr;
+    QThread* workerThread = nullptr;
+    QObject* worker = nullptr;
+    bool sweepInFlight = false;
+    bool sweepRequested = false;
+    int readinessIntervalMs = ReadinessMinIntervalMs;
+    quint64 nextGeneration = 1;
+};
+
+#endif // PROCESSSUPERVISOR_H
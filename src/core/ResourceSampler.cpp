@@ -0,0 +1,355 @@
+#include "ResourceSampler.h"
+#include "ProcessProbe.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+
+#if !defined(Q_OS_WIN)
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    qint64 pageSize()
+    {
+#if defined(Q_OS_WIN)
+        return 4096;
+#else
+        static const qint64 size = ::sysconf(_SC_PAGESIZE);
+        return size;
+#endif
+    }
+
+    double ticksPerSecond()
+    {
+#if defined(Q_OS_WIN)
+        return 100.0;
+#else
+        static const double ticks = static_cast<double>(::sysconf(_SC_CLK_TCK));
+        return ticks;
+#endif
+    }
+
+    qint64 monotonicMs()
+    {
+        static QElapsedTimer clock = []()
+        {
+            QElapsedTimer timer;
+            timer.start();
+            return timer;
+        }();
+        return clock.elapsed();
+    }
+
+#if defined(Q_OS_LINUX)
+    // /proc files are tiny and read once per second per process, so skip QFile and its stat() calls
+    QByteArray readProcFile(int pid, const char* name)
+    {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/%d/%s", pid, name);
+
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return {};
+
+        char buffer[1024];
+        ssize_t size = ::read(fd, buffer, sizeof(buffer));
+        ::close(fd);
+
+        return size > 0 ? QByteArray(buffer, static_cast<int>(size)) : QByteArray();
+    }
+
+    int countOpenFiles(int pid)
+    {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/%d/fd", pid);
+
+        DIR* dir = ::opendir(path);
+        if (!dir)
+            return 0;
+
+        int count = 0;
+        while (dirent* entry = ::readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+                ++count;
+        }
+
+        ::closedir(dir);
+        return count;
+    }
+#endif
+} // namespace
+
+ResourceSampler& ResourceSampler::instance()
+{
+    static ResourceSampler instance;
+    return instance;
+}
+
+ResourceSampler::ResourceSampler()
+{
+    sampleTimer = new QTimer(this);
+    sampleTimer->setInterval(SampleIntervalMs);
+    connect(sampleTimer, &QTimer::timeout, this, &ResourceSampler::sample);
+
+    workerThread = new QThread(this);
+    workerThread->setObjectName("ResourceSampler");
+    worker = new QObject();
+    worker->moveToThread(workerThread);
+    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    workerThread->start();
+}
+
+ResourceSampler::~ResourceSampler()
+{
+    workerThread->quit();
+    workerThread->wait();
+}
+
+void ResourceSampler::watch(int processId, int pid)
+{
+    Watch& watch = watches[processId];
+    watch.pid = pid;
+    ++watch.references;
+
+    if (!sampleTimer->isActive())
+    {
+        sampleTimer->start();
+    }
+
+    // The first sample only establishes the baseline for CPU and I/O rates
+    QTimer::singleShot(0, this, &ResourceSampler::sample);
+}
+
+void ResourceSampler::unwatch(int processId)
+{
+    auto it = watches.find(processId);
+    if (it == watches.end())
+        return;
+
+    if (--it->references <= 0)
+    {
+        watches.erase(it);
+    }
+
+    if (watches.isEmpty())
+    {
+        sampleTimer->stop();
+    }
+}
+
+QList<ResourceSample> ResourceSampler::history(int processId) const
+{
+    auto it = watches.constFind(processId);
+    return it != watches.constEnd() ? it->history.toList() : QList<ResourceSample>();
+}
+
+void ResourceSampler::sample()
+{
+    if (sampleInFlight || watches.isEmpty())
+        return;
+
+    QHash<int, int> requests;
+    for (auto it = watches.cbegin(); it != watches.cend(); ++it)
+    {
+        if (it->pid > 0)
+            requests.insert(it.key(), it->pid);
+    }
+
+    if (requests.isEmpty())
+        return;
+
+    sampleInFlight = true;
+    QMetaObject::invokeMethod(
+        worker,
+        [this, requests]()
+        {
+            QHash<int, ResourceSample> samples;
+            for (auto it = requests.cbegin(); it != requests.cend(); ++it)
+            {
+                samples.insert(it.key(), sampleTree(it.value(), previousCounters[it.key()]));
+            }
+
+            // Baselines of processes no longer watched
+            for (auto it = previousCounters.begin(); it != previousCounters.end();)
+            {
+                if (requests.contains(it.key()))
+                    ++it;
+                else
+                    it = previousCounters.erase(it);
+            }
+
+            QMetaObject::invokeMethod(this, [this, samples]() { applySamples(samples); }, Qt::QueuedConnection);
+        },
+        Qt::QueuedConnection);
+}
+
+void ResourceSampler::applySamples(const QHash<int, ResourceSample>& samples)
+{
+    sampleInFlight = false;
+
+    for (auto it = samples.cbegin(); it != samples.cend(); ++it)
+    {
+        auto watch = watches.find(it.key());
+        if (watch == watches.end())
+            continue;
+
+        watch->history.push(it.value());
+        emit sampled(it.key(), it.value());
+    }
+}
+
+ResourceSample ResourceSampler::sampleTree(int rootPid, QHash<int, Counters>& previous)
+{
+    ResourceSample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    if (rootPid <= 0)
+    {
+        previous.clear();
+        return sample;
+    }
+
+    QList<int> pids = ProcessProbe::findDescendants(rootPid);
+    pids.prepend(rootPid);
+
+    QHash<int, Counters> current;
+    current.reserve(pids.size());
+
+    double cpuSeconds = 0.0;
+    double readBytesPerSecond = 0.0;
+    double writeBytesPerSecond = 0.0;
+
+    for (int pid : pids)
+    {
+        Counters counters;
+        if (!readCounters(pid, counters))
+            continue;
+
+        counters.sampledAt = monotonicMs();
+        sample.processCount++;
+        sample.residentBytes += counters.residentBytes;
+        sample.threads += counters.threads;
+        sample.openFiles += counters.openFiles;
+
+        // Processes seen for the first time contribute to rates from the next sample on.
+        // Counters going backwards mean the PID was reused.
+        auto before = previous.constFind(pid);
+        if (before != previous.constEnd() && counters.sampledAt > before->sampledAt &&
+            counters.cpuTicks >= before->cpuTicks)
+        {
+            double seconds = (counters.sampledAt - before->sampledAt) / 1000.0;
+            cpuSeconds += (counters.cpuTicks - before->cpuTicks) / ticksPerSecond() / seconds;
+
+            if (counters.readBytes >= before->readBytes)
+                readBytesPerSecond += (counters.readBytes - before->readBytes) / seconds;
+            if (counters.writeBytes >= before->writeBytes)
+                writeBytesPerSecond += (counters.writeBytes - before->writeBytes) / seconds;
+        }
+
+        current.insert(pid, counters);
+    }
+
+    sample.cpuPercent = cpuSeconds * 100.0;
+    sample.readBytesPerSecond = static_cast<qint64>(readBytesPerSecond);
+    sample.writeBytesPerSecond = static_cast<qint64>(writeBytesPerSecond);
+
+    previous.swap(current);
+    return sample;
+}
+
+bool ResourceSampler::readCounters(int pid, Counters& counters)
+{
+#if defined(Q_OS_LINUX)
+    if (pid <= 0 || !parseStat(readProcFile(pid, "stat"), counters))
+        return false;
+
+    // statm and fd are always readable for our own processes; io needs ptrace access and may be missing
+    parseStatm(readProcFile(pid, "statm"), counters);
+    parseIo(readProcFile(pid, "io"), counters);
+    counters.openFiles = countOpenFiles(pid);
+    return true;
+#else
+    Q_UNUSED(pid)
+    Q_UNUSED(counters)
+    return false;
+#endif
+}
+
+bool ResourceSampler::parseStat(const QByteArray& stat, Counters& counters)
+{
+    // Fields after "pid (comm) ": state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt
+    // cmajflt utime stime cutime cstime priority nice num_threads ...
+    int commEnd = stat.lastIndexOf(')');
+    if (commEnd < 0)
+        return false;
+
+    const QList<QByteArray> fields = stat.mid(commEnd + 1).simplified().split(' ');
+    if (fields.size() < 18)
+        return false;
+
+    bool utimeOk = false;
+    bool stimeOk = false;
+    bool threadsOk = false;
+    quint64 utime = fields[11].toULongLong(&utimeOk);
+    quint64 stime = fields[12].toULongLong(&stimeOk);
+    int threads = fields[17].toInt(&threadsOk);
+
+    if (!utimeOk || !stimeOk || !threadsOk)
+        return false;
+
+    counters.cpuTicks = utime + stime;
+    counters.threads = threads;
+    return true;
+}
+
+bool ResourceSampler::parseStatm(const QByteArray& statm, Counters& counters)
+{
+    // size resident shared text lib data dt, in pages
+    const QList<QByteArray> fields = statm.simplified().split(' ');
+    if (fields.size() < 2)
+        return false;
+
+    bool ok = false;
+    qint64 residentPages = fields[1].toLongLong(&ok);
+    if (!ok)
+        return false;
+
+    counters.residentBytes = residentPages * pageSize();
+    return true;
+}
+
+bool ResourceSampler::parseIo(const QByteArray& io, Counters& counters)
+{
+    bool found = false;
+
+    for (const QByteArray& line : io.split('\n'))
+    {
+        int colon = line.indexOf(':');
+        if (colon < 0)
+            continue;
+
+        QByteArray key = line.left(colon);
+        bool ok = false;
+        quint64 value = line.mid(colon + 1).trimmed().toULongLong(&ok);
+        if (!ok)
+            continue;
+
+        // Bytes that actually hit storage; rchar/wchar would also count pipes and sockets
+        if (key == "read_bytes")
+        {
+            counters.readBytes = value;
+            found = true;
+        }
+        else if (key == "write_bytes")
+        {
+            counters.writeBytes = value;
+            found = true;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,93 @@
+#ifndef RESOURCESAMPLER_H
+#define RESOURCESAMPLER_H
+
+#include "RingBuffer.h"
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+
+// Resource usage of a process tree at one point in time, summed over the root and its descendants
+struct ResourceSample
+{
+    qint64 timestamp = 0;
+    int processCount = 0;
+    double cpuPercent = 0.0;
+    qint64 residentBytes = 0;
+    int threads = 0;
+    int openFiles = 0;
+    qint64 readBytesPerSecond = 0;
+    qint64 writeBytesPerSecond = 0;
+};
+
+// Samples /proc/<pid>/stat, statm, io and fd for the whole tree of every watched process once per
+// SampleIntervalMs and keeps the last HistorySize samples per process. Reading runs on a worker
+// thread; samples arrive on the GUI thread through sampled(). Nothing is sampled outside Linux.
+class ResourceSampler : public QObject
+{
+    Q_OBJECT
+
+  public:
+    // Cumulative per-PID counters; rates and CPU% are deltas between two of these
+    struct Counters
+    {
+        qint64 sampledAt = 0;
+        quint64 cpuTicks = 0;
+        qint64 residentBytes = 0;
+        int threads = 0;
+        int openFiles = 0;
+        quint64 readBytes = 0;
+        quint64 writeBytes = 0;
+    };
+
+    static ResourceSampler& instance();
+
+    // Starts sampling the tree rooted at pid. Watching the same process again only moves it to the new PID;
+    // every watch() needs a matching unwatch().
+    void watch(int processId, int pid);
+    void unwatch(int processId);
+    QList<ResourceSample> history(int processId) const;
+
+    // Reads one tree and updates previous with the new counters. PIDs that disappeared are dropped from it.
+    static ResourceSample sampleTree(int rootPid, QHash<int, Counters>& previous);
+
+    static bool readCounters(int pid, Counters& counters);
+    static bool parseStat(const QByteArray& stat, Counters& counters);
+    static bool parseStatm(const QByteArray& statm, Counters& counters);
+    static bool parseIo(const QByteArray& io, Counters& counters);
+
+    static constexpr int SampleIntervalMs = 1000;
+    static constexpr int HistorySize = 120;
+
+  signals:
+    void sampled(int processId, const ResourceSample& sample);
+
+  private:
+    ResourceSampler();
+    ~ResourceSampler();
+    ResourceSampler(const ResourceSampler&) = delete;
+    ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+    struct Watch
+    {
+        int pid = 0;
+        int references = 0;
+        RingBuffer<ResourceSample> history{HistorySize};
+    };
+
+    void sample();
+    void applySamples(const QHash<int, ResourceSample>& samples);
+
+    QHash<int, Watch> watches;
+    QTimer* sampleTimer = nullptr;
+    QThread* workerThread = nullptr;
+    QObject* worker = nullptr;
+    bool sampleInFlight = false;
+
+    // Only touched on the worker thread, keyed by processId
+    QHash<int, QHash<int, Counters>> previousCounters;
+};
+
+#endif // RESOURCESAMPLER_H
@@ -0,0 +1,72 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <QList>
+
+// Fixed-capacity history that overwrites its oldest entry once full. Index 0 is the oldest value.
+template <typename T> class RingBuffer
+{
+  public:
+    explicit RingBuffer(int capacity = 0) : items(capacity > 0 ? capacity : 0)
+    {
+    }
+
+    void push(const T& value)
+    {
+        if (items.isEmpty())
+            return;
+
+        items[(head + count) % items.size()] = value;
+        if (count < items.size())
+            ++count;
+        else
+            head = (head + 1) % items.size();
+    }
+
+    const T& at(int index) const
+    {
+        return items.at((head + index) % items.size());
+    }
+
+    const T& last() const
+    {
+        return at(count - 1);
+    }
+
+    QList<T> toList() const
+    {
+        QList<T> values;
+        values.reserve(count);
+        for (int i = 0; i < count; ++i)
+            values.append(at(i));
+        return values;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    int capacity() const
+    {
+        return items.size();
+    }
+
+    bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+  private:
+    QList<T> items;
+    int head = 0;
+    int count = 0;
+};
+
+#endif // RINGBUFFER_H
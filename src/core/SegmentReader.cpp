@@ -0,0 +1,120 @@
+#include "SegmentReader.h"
+#include "Logger.h"
+
+SegmentReader::SegmentReader(const SegmentedLog& log, const LogSegment& segment, bool finished, qint64 size)
+    : segment(segment), finished(finished || segment.archived), limit(qMin(size, segment.size)),
+      file(log.filePath(segment))
+{
+}
+
+SegmentReader::~SegmentReader()
+{
+    if (mapped)
+        file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(mapped)));
+}
+
+bool SegmentReader::open()
+{
+    if (opened)
+        return true;
+    if (limit <= 0)
+        return false;
+
+    if (segment.archived)
+    {
+        archive = std::make_unique<LogArchive>(file.fileName());
+        if (!archive->open() || archive->size() != segment.size)
+        {
+            archive.reset();
+            return false;
+        }
+        opened = true;
+        return true;
+    }
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    if (finished)
+    {
+        uchar* data = file.map(0, limit);
+        if (!data)
+        {
+            LOG_WARNING_IN(Logs, "Failed to map log segment " + file.fileName() + ": " + file.errorString());
+            file.close();
+            return false;
+        }
+        mapped = reinterpret_cast<const char*>(data);
+    }
+    opened = true;
+    return true;
+}
+
+bool SegmentReader::isOpen() const
+{
+    return opened;
+}
+
+bool SegmentReader::isFinished() const
+{
+    return finished;
+}
+
+qint64 SegmentReader::size() const
+{
+    return limit;
+}
+
+qint64 SegmentReader::blockBytes() const
+{
+    if (archive)
+        return archive->blockBytes();
+    return mapped ? limit : ReadBytes;
+}
+
+const char* SegmentReader::dataAt(qint64 position, qint64& available)
+{
+    available = 0;
+    if (!opened || position < 0 || position >= limit)
+        return nullptr;
+
+    if (archive)
+        return archive->dataAt(position, available);
+
+    if (mapped)
+    {
+        available = limit - position;
+        return mapped + position;
+    }
+
+    // A block read short, because the file was still growing, is read again
+    if (position < bufferStart || position >= bufferStart + buffer.size())
+    {
+        bufferStart = position / ReadBytes * ReadBytes;
+        buffer.resize(qMin(ReadBytes, limit - bufferStart));
+        const qint64 length = file.seek(bufferStart) ? file.read(buffer.data(), buffer.size()) : -1;
+        buffer.resize(qMax<qint64>(length, 0));
+        if (position >= bufferStart + buffer.size())
+            return nullptr;
+    }
+
+    available = bufferStart + buffer.size() - position;
+    return buffer.constData() + (position - bufferStart);
+}
+
+QByteArray SegmentReader::read(qint64 position, qint64 maxBytes)
+{
+    const qint64 end = qMin(limit, position + maxBytes);
+    if (!opened || position < 0 || position >= end)
+        return QByteArray();
+
+    if (archive)
+        return archive->read(position, end - position);
+    if (mapped)
+        return QByteArray::fromRawData(mapped + position, end - position);
+
+    QByteArray result(end - position, Qt::Uninitialized);
+    const qint64 length = file.seek(position) ? file.read(result.data(), result.size()) : -1;
+    result.resize(qMax<qint64>(length, 0));
+    return result;
+}
@@ -0,0 +1,53 @@
+#ifndef SEGMENTREADER_H
+#define SEGMENTREADER_H
+
+#include "LogArchive.h"
+#include "SegmentedLog.h"
+#include <QByteArray>
+#include <QFile>
+#include <memory>
+
+// Reads the first size bytes of one segment of a SegmentedLog. A finished segment is mapped, or read block
+// by block from its archive. The segment still being written is never mapped: the writer, or another
+// process clearing the log, may truncate it, and touching a mapped page past the new end raises SIGBUS.
+// It is read a block at a time into a buffer instead, where a truncation only makes reads come up short.
+// Not thread-safe; every reader opens its own.
+class SegmentReader
+{
+  public:
+    SegmentReader(const SegmentedLog& log, const LogSegment& segment, bool finished, qint64 size);
+    ~SegmentReader();
+
+    SegmentReader(const SegmentReader&) = delete;
+    SegmentReader& operator=(const SegmentReader&) = delete;
+
+    bool open();
+    bool isOpen() const;
+    bool isFinished() const;
+    qint64 size() const;
+    // dataAt never returns more than this many bytes at once; the whole segment when it is mapped
+    qint64 blockBytes() const;
+
+    // Contiguous bytes at position, up to the end of its block; available is 0 past size or if the file
+    // came up short. Valid until the next read.
+    const char* dataAt(qint64 position, qint64& available);
+    // Up to maxBytes from position on; a mapped segment is not copied, so the result is only valid as long
+    // as the reader
+    QByteArray read(qint64 position, qint64 maxBytes);
+
+    static constexpr qint64 ReadBytes = 64 * 1024;
+
+  private:
+    LogSegment segment;
+    bool finished;
+    qint64 limit;
+    QFile file;
+    const char* mapped = nullptr;
+    std::unique_ptr<LogArchive> archive;
+    // The block of the open segment read last
+    QByteArray buffer;
+    qint64 bufferStart = -1;
+    bool opened = false;
+};
+
+#endif // SEGMENTREADER_H
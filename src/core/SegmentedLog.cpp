@@ -0,0 +1,345 @@
+#include "SegmentedLog.h"
+#include "LogArchive.h"
+#include "Logger.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#if !defined(Q_OS_WIN)
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    const QString IndexFileName = "index.json";
+    const QString ArchiveExtension = "logz";
+
+    bool statSegment(const QString& path, LogSegment& segment)
+    {
+#if defined(Q_OS_WIN)
+        const QFileInfo info(path);
+        if (!info.exists())
+            return false;
+        segment.size = info.size();
+        segment.fileId = static_cast<quint64>(info.birthTime().toMSecsSinceEpoch());
+#else
+        struct stat status;
+        if (::stat(QFile::encodeName(path).constData(), &status) != 0)
+            return false;
+        segment.size = status.st_size;
+        segment.fileId = status.st_ino;
+#endif
+        return true;
+    }
+}
+
+SegmentedLog::SegmentedLog(const QString& directoryPath, qint64 maxSegmentBytes, qint64 maxTotalBytes)
+    : directory(directoryPath), maxSegmentBytes(maxSegmentBytes), maxTotalBytes(maxTotalBytes)
+{
+}
+
+SegmentedLog::~SegmentedLog()
+{
+    close();
+}
+
+QString SegmentedLog::directoryFor(int projectId, int processId)
+{
+    return QDir::current().absoluteFilePath(QString("logs/%1/%2").arg(projectId).arg(processId));
+}
+
+bool SegmentedLog::load()
+{
+    segmentList.clear();
+    clearedOffset = 0;
+
+    QFile indexFile(QDir(directory).filePath(IndexFileName));
+    if (!indexFile.exists())
+        return true;
+
+    if (!indexFile.open(QIODevice::ReadOnly))
+    {
+        LOG_WARNING_IN(Logs, "Failed to read log index " + indexFile.fileName() + ": " + indexFile.errorString());
+        return false;
+    }
+
+    const QJsonObject index = QJsonDocument::fromJson(indexFile.readAll()).object();
+    clearedOffset = index.value("clearedOffset").toInteger();
+
+    for (const QJsonValue& value : index.value("segments").toArray())
+    {
+        const QJsonObject object = value.toObject();
+        LogSegment segment;
+        segment.fileName = object.value("file").toString();
+        segment.startOffset = object.value("offset").toInteger();
+        segment.startedAt = object.value("startedAt").toInteger();
+
+        // The index only records boundaries; sizes come from the files, the last one is still growing
+        if (!statSegment(filePath(segment), segment))
+        {
+            segment.archived = true;
+            LogArchive archive(filePath(segment));
+            if (!archive.open())
+                continue;
+            segment.size = archive.size();
+            segment.fileId = archive.fileId();
+        }
+        segmentList.append(segment);
+    }
+    return true;
+}
+
+QString SegmentedLog::directoryPath() const
+{
+    return directory;
+}
+
+QList<LogSegment> SegmentedLog::segments() const
+{
+    return segmentList;
+}
+
+qint64 SegmentedLog::startOffset() const
+{
+    if (segmentList.isEmpty())
+        return clearedOffset;
+    return qMin(qMax(segmentList.first().startOffset, clearedOffset), endOffset());
+}
+
+qint64 SegmentedLog::endOffset() const
+{
+    if (segmentList.isEmpty())
+        return clearedOffset;
+    return segmentList.last().endOffset();
+}
+
+QByteArray SegmentedLog::read(qint64 offset, qint64 maxBytes) const
+{
+    QByteArray result;
+    qint64 position = qMax(offset, startOffset());
+    const qint64 end = qMin(endOffset(), offset + maxBytes);
+
+    for (const LogSegment& segment : segmentList)
+    {
+        if (position >= end)
+            break;
+        if (segment.endOffset() <= position)
+            continue;
+
+        const qint64 length = qMin(segment.endOffset(), end) - position;
+        QByteArray part;
+        if (segment.archived)
+        {
+            LogArchive archive(filePath(segment));
+            if (!archive.open())
+                break;
+            part = archive.read(position - segment.startOffset, length);
+        }
+        else
+        {
+            QFile file(filePath(segment));
+            if (!file.open(QIODevice::ReadOnly) || !file.seek(position - segment.startOffset))
+                break;
+            part = file.read(length);
+        }
+        result.append(part);
+        position += part.size();
+    }
+    return result;
+}
+
+QString SegmentedLog::sidecarPath(const LogSegment& segment, const QString& extension) const
+{
+    return QDir(directory).filePath(QFileInfo(segment.fileName).completeBaseName() + "." + extension);
+}
+
+QString SegmentedLog::filePath(const LogSegment& segment) const
+{
+    if (segment.archived)
+        return sidecarPath(segment, ArchiveExtension);
+    return QDir(directory).filePath(segment.fileName);
+}
+
+int SegmentedLog::archiveFinished()
+{
+    load();
+
+    // The last segment may still be written to
+    int archivedCount = 0;
+    for (qsizetype i = 0; i + 1 < segmentList.size(); ++i)
+    {
+        if (!segmentList.at(i).archived && archive(segmentList.at(i)))
+            ++archivedCount;
+    }
+
+    if (archivedCount > 0)
+        load();
+    return archivedCount;
+}
+
+bool SegmentedLog::openForAppend()
+{
+    if (activeFile.isOpen())
+        return true;
+
+    if (!QDir().mkpath(directory) || !load())
+        return false;
+
+    if (segmentList.isEmpty() || segmentList.last().size >= maxSegmentBytes)
+        return rotate();
+
+    activeFile.setFileName(filePath(segmentList.last()));
+    if (!activeFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        LOG_ERROR_IN(Logs, "Failed to open log segment " + activeFile.fileName() + ": " + activeFile.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool SegmentedLog::isOpen() const
+{
+    return activeFile.isOpen();
+}
+
+bool SegmentedLog::append(const QByteArray& data)
+{
+    if (!activeFile.isOpen())
+        return false;
+
+    // Output is split at write boundaries; readers join the segments again by offset
+    const qint64 activeSize = segmentList.last().size;
+    if (activeSize > 0 && activeSize + data.size() > maxSegmentBytes && !rotate())
+        return false;
+
+    const qint64 written = activeFile.write(data);
+    activeFile.flush();
+    if (written > 0)
+        segmentList.last().size += written;
+
+    return written == data.size();
+}
+
+void SegmentedLog::close()
+{
+    if (activeFile.isOpen())
+        activeFile.close();
+}
+
+bool SegmentedLog::clear()
+{
+    // A writer may have moved on since this log was loaded
+    load();
+    clearedOffset = endOffset();
+    enforceRetention();
+    return saveIndex();
+}
+
+bool SegmentedLog::rotate()
+{
+    const qint64 nextOffset = endOffset();
+    close();
+
+    // Readers may have cleared the log meanwhile; start from what is on disk
+    load();
+
+    LogSegment segment;
+    segment.startOffset = qMax(nextOffset, endOffset());
+    segment.startedAt = QDateTime::currentMSecsSinceEpoch();
+    segment.fileName = QString("%1.log").arg(segment.startOffset, 16, 10, QChar('0'));
+
+    activeFile.setFileName(filePath(segment));
+    if (!activeFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        LOG_ERROR_IN(Logs, "Failed to create log segment " + activeFile.fileName() + ": " + activeFile.errorString());
+        return false;
+    }
+
+    segmentList.append(segment);
+    enforceRetention();
+    return saveIndex();
+}
+
+void SegmentedLog::enforceRetention()
+{
+    qint64 totalBytes = 0;
+    for (const LogSegment& segment : segmentList)
+        totalBytes += segment.size;
+
+    // The newest segment always stays, a writer may have it open
+    while (segmentList.size() > 1)
+    {
+        const LogSegment& oldest = segmentList.first();
+        if (totalBytes <= maxTotalBytes && oldest.endOffset() > clearedOffset)
+            break;
+
+        if (!QFile::remove(filePath(oldest)) && QFile::exists(filePath(oldest)))
+        {
+            LOG_WARNING_IN(Logs, "Failed to delete log segment " + filePath(oldest));
+            break;
+        }
+        const QDir dir(directory);
+        const QString sidecars = QFileInfo(oldest.fileName).completeBaseName() + ".*";
+        for (const QString& sidecar : dir.entryList({sidecars}, QDir::Files))
+            dir.remove(sidecar);
+
+        totalBytes -= oldest.size;
+        segmentList.removeFirst();
+    }
+}
+
+bool SegmentedLog::saveIndex() const
+{
+    QJsonArray segments;
+    for (const LogSegment& segment : segmentList)
+    {
+        segments.append(QJsonObject{{"file", segment.fileName},
+                                    {"offset", segment.startOffset},
+                                    {"startedAt", segment.startedAt}});
+    }
+
+    QJsonObject index{{"clearedOffset", clearedOffset}, {"segments", segments}};
+
+    // Written to a temporary file and renamed, so readers never see a half-written index
+    QSaveFile indexFile(QDir(directory).filePath(IndexFileName));
+    if (!indexFile.open(QIODevice::WriteOnly) || indexFile.write(QJsonDocument(index).toJson()) < 0 ||
+        !indexFile.commit())
+    {
+        LOG_ERROR_IN(Logs, "Failed to write log index " + indexFile.fileName() + ": " + indexFile.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool SegmentedLog::archive(const LogSegment& segment)
+{
+    const QString path = filePath(segment);
+    const QString archivePath = sidecarPath(segment, ArchiveExtension);
+
+    // An earlier attempt may have written the archive but failed to delete the segment, e.g. while a
+    // reader had it mapped on Windows
+    bool archived = false;
+    {
+        LogArchive existing(archivePath);
+        archived = existing.open() && existing.fileId() == segment.fileId && existing.size() == segment.size;
+    }
+    if (!archived && !LogArchive::write(path, archivePath, segment.fileId))
+        return false;
+
+    if (!QFile::remove(path))
+    {
+        // Deleted by retention meanwhile; its archive would never be
+        if (!QFile::exists(path))
+        {
+            QFile::remove(archivePath);
+            return false;
+        }
+        LOG_WARNING_IN(Logs, "Failed to delete archived log segment " + path);
+        return false;
+    }
+    return true;
+}
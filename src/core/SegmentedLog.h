@@ -0,0 +1,90 @@
+#ifndef SEGMENTEDLOG_H
+#define SEGMENTEDLOG_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+// One file of a segmented log. Offsets are positions in the whole output of the process, so they
+// stay valid when older segments are deleted.
+struct LogSegment
+{
+    QString fileName;
+    qint64 startOffset = 0;
+    qint64 size = 0;
+    qint64 startedAt = 0; // ms since epoch
+    // Identity of the file on disk, its inode where there is one; a segment replaced under the same
+    // name gets a new one. Read from disk like size.
+    quint64 fileId = 0;
+    // Compressed into a LogArchive next to where the file was; fileName and fileId stay those of the file
+    bool archived = false;
+
+    qint64 endOffset() const
+    {
+        return startOffset + size;
+    }
+};
+
+// Output of one process under logs/<project id>/<process id>/, split into segments of at most
+// MaxSegmentBytes. index.json lists the segments by start offset and start time; once the segments
+// together exceed MaxTotalBytes the oldest ones are deleted. A log has one writer, but any number of
+// readers may load() the index and read() while it is being written. Finished segments can be archived,
+// replaced by a LogArchive that is read block by block; offsets, sizes and the index stay the same.
+class SegmentedLog
+{
+  public:
+    explicit SegmentedLog(const QString& directoryPath, qint64 maxSegmentBytes = MaxSegmentBytes,
+                          qint64 maxTotalBytes = MaxTotalBytes);
+    ~SegmentedLog();
+
+    static QString directoryFor(int projectId, int processId);
+
+    // Reads the index and takes the current segment sizes from disk
+    bool load();
+
+    QString directoryPath() const;
+    QList<LogSegment> segments() const;
+    // First offset that can still be read; older output was deleted or cleared
+    qint64 startOffset() const;
+    qint64 endOffset() const;
+
+    // Up to maxBytes from offset on, crossing segment boundaries
+    QByteArray read(qint64 offset, qint64 maxBytes) const;
+    // File kept next to a segment by readers, e.g. a search index; deleted together with the segment
+    QString sidecarPath(const LogSegment& segment, const QString& extension) const;
+    // The segment file, or its archive
+    QString filePath(const LogSegment& segment) const;
+
+    // Compresses every finished segment that is not archived yet; returns how many were. Any reader
+    // may do this, the writer never touches a finished segment again.
+    int archiveFinished();
+
+    // Writer side
+    bool openForAppend();
+    bool isOpen() const;
+    bool append(const QByteArray& data);
+    void close();
+
+    // Hides everything written so far without touching the segment a writer has open. Finished
+    // segments are deleted right away, the open one when the writer moves past it.
+    bool clear();
+
+    static constexpr qint64 MaxSegmentBytes = 8 * 1024 * 1024;
+    static constexpr qint64 MaxTotalBytes = 64 * 1024 * 1024;
+
+  private:
+    bool rotate();
+    void enforceRetention();
+    bool saveIndex() const;
+    bool archive(const LogSegment& segment);
+
+    QString directory;
+    qint64 maxSegmentBytes;
+    qint64 maxTotalBytes;
+    QList<LogSegment> segmentList;
+    qint64 clearedOffset = 0;
+    QFile activeFile;
+};
+
+#endif // SEGMENTEDLOG_H
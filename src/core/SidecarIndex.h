@@ -0,0 +1,142 @@
+#ifndef SIDECARINDEX_H
+#define SIDECARINDEX_H
+
+#include "SegmentedLog.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <algorithm>
+#include <vector>
+
+// Base of the indexes kept next to every segment of a SegmentedLog as a sidecar with their own extension,
+// like LogSearchIndex and LogRecordIndex. updateSegments() follows the segments of the log: the index of
+// a segment is kept while the segment only grows, loaded from its sidecar for a segment seen for the
+// first time and rebuilt from scratch for a truncated or replaced one. New output is then indexed, and
+// an index is saved once saveInterval of it is unsaved or its segment is finished. Sidecars of deleted
+// segments are removed. Segment is what is kept per segment; it has segment and indexedSize members.
+template <typename Segment> class SidecarIndex
+{
+  public:
+    virtual ~SidecarIndex() = default;
+    SidecarIndex(const SidecarIndex&) = delete;
+    SidecarIndex& operator=(const SidecarIndex&) = delete;
+
+    QString directoryPath() const
+    {
+        return log.directoryPath();
+    }
+
+  protected:
+    SidecarIndex(const QString& directoryPath, const QString& extension, qint64 saveInterval)
+        : log(directoryPath), extension(extension), saveInterval(saveInterval)
+    {
+    }
+
+    // Indexes the new output of every segment; returns the sum of what indexSegment() returned
+    qint64 updateSegments()
+    {
+        log.load();
+        const QList<LogSegment> segments = log.segments();
+
+        std::vector<Segment> updated;
+        updated.reserve(segments.size());
+        for (const LogSegment& segment : segments)
+        {
+            auto existing = std::find_if(segmentIndexes.begin(), segmentIndexes.end(),
+                                         [&](const Segment& candidate)
+                                         { return candidate.segment.fileName == segment.fileName; });
+
+            Segment index;
+            // A truncated or replaced segment is indexed again
+            if (existing != segmentIndexes.end() && existing->segment.fileId == segment.fileId &&
+                existing->indexedSize <= segment.size)
+            {
+                index = std::move(*existing);
+                index.segment = segment;
+            }
+            else
+            {
+                index.segment = segment;
+                load(index);
+            }
+            updated.push_back(std::move(index));
+        }
+
+        QSet<QString> fileNames;
+        for (const LogSegment& segment : segments)
+            fileNames.insert(segment.fileName);
+        const bool segmentsDeleted = std::any_of(segmentIndexes.begin(), segmentIndexes.end(),
+                                                 [&](const Segment& index)
+                                                 { return !fileNames.contains(index.segment.fileName); });
+        segmentIndexes = std::move(updated);
+
+        qint64 indexed = 0;
+        for (size_t i = 0; i < segmentIndexes.size(); ++i)
+        {
+            // Only the last segment is still written to
+            Segment& index = segmentIndexes[i];
+            const bool finished = i + 1 < segmentIndexes.size();
+            indexed += indexSegment(index, i > 0 ? &segmentIndexes[i - 1] : nullptr, finished);
+
+            if (unsaved(index) >= saveInterval || (finished && unsaved(index) > 0))
+                save(index);
+        }
+
+        // Sidecars of segments deleted while their index was being saved
+        if (!orphansChecked || segmentsDeleted)
+        {
+            removeOrphans();
+            orphansChecked = true;
+        }
+        return indexed;
+    }
+
+    // Saves what was indexed since the last save; for the destructor of the subclass, since the hooks
+    // are gone by the time this one runs
+    void saveAll()
+    {
+        for (Segment& index : segmentIndexes)
+        {
+            if (unsaved(index) > 0)
+                save(index);
+        }
+    }
+
+    QString sidecarPath(const Segment& index) const
+    {
+        return log.sidecarPath(index.segment, extension);
+    }
+
+    // Indexes what was appended to the segment of index since; previous is the index of the segment
+    // before it, or nullptr
+    virtual qint64 indexSegment(Segment& index, const Segment* previous, bool finished) = 0;
+    // What was indexed since the last save, in the unit of saveInterval
+    virtual qint64 unsaved(const Segment& index) const = 0;
+    // Restores index from its sidecar; false, leaving it empty, if there is none or it does not match
+    virtual bool load(Segment& index) const = 0;
+    virtual bool save(Segment& index) const = 0;
+
+    SegmentedLog log;
+    std::vector<Segment> segmentIndexes;
+
+  private:
+    void removeOrphans() const
+    {
+        QSet<QString> current;
+        for (const Segment& index : segmentIndexes)
+            current.insert(QFileInfo(sidecarPath(index)).fileName());
+
+        QDir dir(log.directoryPath());
+        for (const QString& fileName : dir.entryList({"*." + extension}, QDir::Files))
+        {
+            if (!current.contains(fileName))
+                dir.remove(fileName);
+        }
+    }
+
+    QString extension;
+    qint64 saveInterval;
+    bool orphansChecked = false;
+};
+
+#endif // SIDECARINDEX_H
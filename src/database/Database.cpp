@@ -117,7 +117,22 @@ bool Database::createProcessesTable(QSqlQuery& query)
         )
     )";
 
-    return query.exec(sql);
+    // Launch plan: a process starts once every process it depends on is ready
+    const QString dependenciesTable = R"(
+        CREATE TABLE IF NOT EXISTS process_dependencies (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            process_id INTEGER NOT NULL,
+            depends_on_id INTEGER NOT NULL,
+            FOREIGN KEY (process_id) REFERENCES processes (id) ON DELETE CASCADE,
+            FOREIGN KEY (depends_on_id) REFERENCES processes (id) ON DELETE CASCADE,
+            UNIQUE(process_id, depends_on_id)
+        )
+    )";
+
+    // Startup reconciliation only loads processes that are not stopped
+    const QString statusIndex = "CREATE INDEX IF NOT EXISTS idx_processes_status ON processes (status)";
+
+    return query.exec(sql) && query.exec(statusIndex) && query.exec(dependenciesTable);
 }
 
 bool Database::createNotesTable(QSqlQuery& query)
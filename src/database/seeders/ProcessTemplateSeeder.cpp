@@ -14,7 +14,7 @@ bool ProcessTemplateSeeder::shouldSeed()
 
 bool ProcessTemplateSeeder::seed()
 {
-    LOG_INFO("Seeding process templates");
+    LOG_INFO_IN(Database, "Seeding process templates");
 
     auto processTemplates = getDefaultTemplates();
     int successCount = 0;
@@ -28,12 +28,12 @@ bool ProcessTemplateSeeder::seed()
         }
         else
         {
-            LOG_WARNING("Failed to save template: " + processTemplate.getName());
+            LOG_WARNING_IN(Database, "Failed to save template: " + processTemplate.getName());
         }
     }
 
-    LOG_INFO("Successfully seeded " + QString::number(successCount) + " out of " +
-             QString::number(processTemplates.size()) + " templates");
+    LOG_INFO_IN(Database, "Successfully seeded " + QString::number(successCount) + " out of " +
+                QString::number(processTemplates.size()) + " templates");
     return successCount == processTemplates.size();
 }
 
@@ -9,7 +9,7 @@ void Seeder::addSeeder(std::unique_ptr<ISeeder> seeder)
 
 bool Seeder::runSeeders()
 {
-    LOG_INFO("Running database seeders...");
+    LOG_INFO_IN(Database, "Running database seeders...");
 
     bool allSuccess = true;
     int seededCount = 0;
@@ -18,24 +18,24 @@ bool Seeder::runSeeders()
     {
         if (seeder->shouldSeed())
         {
-            LOG_INFO("Running seeder: " + seeder->getName());
+            LOG_INFO_IN(Database, "Running seeder: " + seeder->getName());
             if (seeder->seed())
             {
                 seededCount++;
-                LOG_INFO("Seeder completed successfully: " + seeder->getName());
+                LOG_INFO_IN(Database, "Seeder completed successfully: " + seeder->getName());
             }
             else
             {
-                LOG_WARNING("Seeder failed: " + seeder->getName());
+                LOG_WARNING_IN(Database, "Seeder failed: " + seeder->getName());
                 allSuccess = false;
             }
         }
         else
         {
-            LOG_INFO("Seeder already run, skipping: " + seeder->getName());
+            LOG_INFO_IN(Database, "Seeder already run, skipping: " + seeder->getName());
         }
     }
 
-    LOG_INFO("Database seeding completed. Successfully ran " + QString::number(seededCount) + " seeders");
+    LOG_INFO_IN(Database, "Database seeding completed. Successfully ran " + QString::number(seededCount) + " seeders");
     return allSuccess;
 }
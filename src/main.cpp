@@ -1,4 +1,5 @@
 #include "core/Logger.h"
+#include "core/ProcessReconciler.h"
 #include "database/Database.h"
 #include "database/seeders/ProcessTemplateSeeder.h"
 #include "database/seeders/Seeder.h"
@@ -29,6 +30,7 @@ int main(int argc, char* argv[])
     if (!Database::instance().initialize())
     {
         LOG_CRITICAL("Failed to initialize database");
+        Logger::shutdown();
         return -1;
     }
 
@@ -57,6 +59,9 @@ int main(int argc, char* argv[])
         std::move(projectRepo), std::move(noteRepo), std::move(processRepo), std::move(editorRepo),
         std::move(processTemplateRepo), std::move(appRepo), std::move(snippetRepo));
 
+    // Correct processes left Running or Starting by a previous session before any list shows them
+    ProcessReconciler::run(repositoryProvider->getProcessRepository());
+
     MainWindow window(*repositoryProvider);
     window.setWindowTitle("DevPilot");
     window.showMaximized();
@@ -65,5 +70,9 @@ int main(int argc, char* argv[])
     QObject::connect(&ThemeManager::instance(), &ThemeManager::themeChanged, &app,
                      [&app](Theme theme) { app.setStyleSheet(AppStyle::styleSheet(theme)); });
 
-    return app.exec();
+    const int result = app.exec();
+
+    // Writes what is still queued; anything logged later is dropped
+    Logger::shutdown();
+    return result;
 }
@@ -16,7 +16,8 @@ std::optional<App> AppRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding app ID " + QString::number(id) + ": " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding app ID " + QString::number(id) + ": " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
@@ -35,7 +36,7 @@ QList<App> AppRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all apps: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all apps: " + query.lastError().text());
         return apps;
     }
 
@@ -69,7 +70,7 @@ std::optional<App> AppRepository::insert(const App& app)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert app '" + app.getName() + "': " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert app '" + app.getName() + "': " + query.lastError().text());
         return std::nullopt;
     }
 
@@ -94,7 +95,8 @@ std::optional<App> AppRepository::update(const App& app)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update app ID " + QString::number(app.getId()) + ": " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update app ID " + QString::number(app.getId()) + ": " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
@@ -109,7 +111,7 @@ bool AppRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete app ID " + QString::number(id) + ": " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete app ID " + QString::number(id) + ": " + query.lastError().text());
         return false;
     }
 
@@ -130,7 +132,8 @@ QList<App> AppRepository::findByProjectId(int projectId)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to fetch apps for project ID " + QString::number(projectId) + ": " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to fetch apps for project ID " + QString::number(projectId) + ": " +
+                     query.lastError().text());
         return apps;
     }
 
@@ -17,18 +17,19 @@ std::optional<Editor> EditorRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding editor ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding editor ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto editor = mapFromRecord(query);
-        LOG_INFO("Successfully found editor ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found editor ID: " + QString::number(id));
         return editor;
     }
 
-    LOG_INFO("Editor not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Editor not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -44,7 +45,7 @@ QList<Editor> EditorRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all editors: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all editors: " + query.lastError().text());
         return results;
     }
 
@@ -53,7 +54,7 @@ QList<Editor> EditorRepository::findAll()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " editors from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " editors from database");
     return results;
 }
 
@@ -65,11 +66,11 @@ bool EditorRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete editor ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete editor ID " + QString::number(id) + " : " + query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted editor ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted editor ID: " + QString::number(id));
     return true;
 }
 
@@ -104,12 +105,12 @@ std::optional<Editor> EditorRepository::insert(const Editor& editor)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert editor '" + editor.getName() + "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert editor '" + editor.getName() + "' : " + query.lastError().text());
         return std::nullopt;
     }
 
     auto id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new editor ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new editor ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -128,10 +129,11 @@ std::optional<Editor> EditorRepository::update(const Editor& editor)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update editor ID " + QString::number(editor.getId()) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update editor ID " + QString::number(editor.getId()) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated editor ID: " + QString::number(editor.getId()));
+    LOG_INFO_IN(Database, "Successfully updated editor ID: " + QString::number(editor.getId()));
     return editor;
 }
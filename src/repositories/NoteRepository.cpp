@@ -17,18 +17,19 @@ std::optional<Note> NoteRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding note ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding note ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto note = mapFromRecord(query);
-        LOG_INFO("Successfully found note ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found note ID: " + QString::number(id));
         return note;
     }
 
-    LOG_INFO("Note not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Note not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -41,8 +42,8 @@ QList<Note> NoteRepository::findByProjectId(int projectId)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding notes by project ID " + QString::number(projectId) + " : " +
-                  query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding notes by project ID " + QString::number(projectId) + " : " +
+                     query.lastError().text());
         return results;
     }
 
@@ -51,7 +52,8 @@ QList<Note> NoteRepository::findByProjectId(int projectId)
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Found " + QString::number(results.size()) + " notes for project ID: " + QString::number(projectId));
+    LOG_INFO_IN(Database, "Found " + QString::number(results.size()) + " notes for project ID: " +
+                QString::number(projectId));
     return results;
 }
 
@@ -67,7 +69,7 @@ QList<Note> NoteRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all notes: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all notes: " + query.lastError().text());
         return results;
     }
 
@@ -76,7 +78,7 @@ QList<Note> NoteRepository::findAll()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " notes from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " notes from database");
     return results;
 }
 
@@ -88,11 +90,11 @@ bool NoteRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete note ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete note ID " + QString::number(id) + " : " + query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted note ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted note ID: " + QString::number(id));
     return true;
 }
 
@@ -122,12 +124,12 @@ std::optional<Note> NoteRepository::insert(const Note& note)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert note '" + note.getTitle() + "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert note '" + note.getTitle() + "' : " + query.lastError().text());
         return std::nullopt;
     }
 
     auto id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new note ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new note ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -144,10 +146,11 @@ std::optional<Note> NoteRepository::update(const Note& note)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update note ID " + QString::number(note.getId()) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update note ID " + QString::number(note.getId()) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated note ID: " + QString::number(note.getId()));
+    LOG_INFO_IN(Database, "Successfully updated note ID: " + QString::number(note.getId()));
     return note;
 }
@@ -17,18 +17,19 @@ std::optional<Process> ProcessRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding module ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding module ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto module = mapFromRecord(query);
-        LOG_INFO("Successfully found process ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found process ID: " + QString::number(id));
         return module;
     }
 
-    LOG_INFO("Process not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Process not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -41,8 +42,8 @@ QList<Process> ProcessRepository::findByProjectId(int projectId)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding processes by project ID " + QString::number(projectId) + " : " +
-                  query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding processes by project ID " + QString::number(projectId) +
+                     " : " + query.lastError().text());
         return results;
     }
 
@@ -51,10 +52,170 @@ QList<Process> ProcessRepository::findByProjectId(int projectId)
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Found " + QString::number(results.size()) + " processes for project ID: " + QString::number(projectId));
+    LOG_INFO_IN(Database, "Found " + QString::number(results.size()) + " processes for project ID: " +
+                QString::number(projectId));
     return results;
 }
 
+QList<Process> ProcessRepository::findActive()
+{
+    QList<Process> results;
+
+    // An IN list, unlike "status != 'Stopped'", can use idx_processes_status
+    QSqlQuery query(database);
+    query.prepare("SELECT * FROM processes WHERE status IN ('Starting', 'Running', 'Error')");
+
+    if (!query.exec())
+    {
+        LOG_ERROR_IN(Database, "Database error when finding active processes: " + query.lastError().text());
+        return results;
+    }
+
+    while (query.next())
+    {
+        results.append(mapFromRecord(query));
+    }
+
+    return results;
+}
+
+QHash<int, QList<int>> ProcessRepository::findDependenciesByProjectId(int projectId)
+{
+    QHash<int, QList<int>> dependencies;
+    QSqlQuery query(database);
+    query.prepare(R"(
+        SELECT pd.process_id, pd.depends_on_id FROM process_dependencies pd
+        INNER JOIN processes p ON p.id = pd.process_id
+        WHERE p.project_id = ?
+    )");
+    query.addBindValue(projectId);
+
+    if (!query.exec())
+    {
+        LOG_ERROR_IN(Database, "Failed to fetch process dependencies for project ID " + QString::number(projectId) +
+                     ": " + query.lastError().text());
+        return dependencies;
+    }
+
+    while (query.next())
+    {
+        dependencies[query.value(0).toInt()].append(query.value(1).toInt());
+    }
+
+    return dependencies;
+}
+
+QList<int> ProcessRepository::findDependencyIds(int processId)
+{
+    QList<int> dependencyIds;
+    QSqlQuery query(database);
+    query.prepare("SELECT depends_on_id FROM process_dependencies WHERE process_id = ?");
+    query.addBindValue(processId);
+
+    if (!query.exec())
+    {
+        LOG_ERROR_IN(Database, "Failed to fetch dependencies of process ID " + QString::number(processId) + ": " +
+                     query.lastError().text());
+        return dependencyIds;
+    }
+
+    while (query.next())
+    {
+        dependencyIds.append(query.value(0).toInt());
+    }
+
+    return dependencyIds;
+}
+
+bool ProcessRepository::setDependencies(int processId, const QList<int>& dependencyIds)
+{
+    database.transaction();
+
+    QSqlQuery deleteQuery(database);
+    deleteQuery.prepare("DELETE FROM process_dependencies WHERE process_id = ?");
+    deleteQuery.addBindValue(processId);
+    bool success = deleteQuery.exec();
+
+    QSqlQuery insertQuery(database);
+    insertQuery.prepare("INSERT INTO process_dependencies (process_id, depends_on_id) VALUES (?, ?)");
+    for (int dependencyId : dependencyIds)
+    {
+        if (!success)
+            break;
+
+        if (dependencyId == processId)
+            continue;
+
+        insertQuery.addBindValue(processId);
+        insertQuery.addBindValue(dependencyId);
+        success = insertQuery.exec();
+    }
+
+    if (!success)
+    {
+        LOG_ERROR_IN(Database, "Failed to set dependencies of process ID " + QString::number(processId));
+        database.rollback();
+        return false;
+    }
+
+    database.commit();
+    return true;
+}
+
+bool ProcessRepository::updateRuntimeStates(const QList<Process>& processes)
+{
+    if (processes.isEmpty())
+        return true;
+
+    if (!database.transaction())
+    {
+        LOG_ERROR_IN(Database, "Failed to begin transaction for process runtime states: " +
+                     database.lastError().text());
+        return false;
+    }
+
+    QSqlQuery query(database);
+    query.prepare(R"(
+        UPDATE processes
+        SET
+            status = :status,
+            pid = :pid,
+            last_started_at = :last_started_at,
+            uptime = :uptime,
+            updated_at = :updated_at
+        WHERE id = :id
+    )");
+
+    const QDateTime now = QDateTime::currentDateTime();
+    for (const Process& process : processes)
+    {
+        query.bindValue(":status", process.getStatusString());
+        query.bindValue(":pid", process.getPID());
+        query.bindValue(":last_started_at",
+                        process.getLastStartedAt().isValid() ? process.getLastStartedAt() : QVariant());
+        query.bindValue(":uptime", process.getUptime().isValid() ? process.getUptime() : QVariant());
+        query.bindValue(":updated_at", now);
+        query.bindValue(":id", process.getId());
+
+        if (!query.exec())
+        {
+            LOG_ERROR_IN(Database, "Failed to update runtime state of process ID " + QString::number(process.getId()) +
+                         " : " + query.lastError().text());
+            database.rollback();
+            return false;
+        }
+    }
+
+    if (!database.commit())
+    {
+        LOG_ERROR_IN(Database, "Failed to commit process runtime states: " + database.lastError().text());
+        database.rollback();
+        return false;
+    }
+
+    return true;
+}
+
 std::optional<Process> ProcessRepository::save(const Process& process)
 {
     return process.getId() > 0 ? update(process) : insert(process);
@@ -67,7 +228,7 @@ QList<Process> ProcessRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all processes: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all processes: " + query.lastError().text());
         return results;
     }
 
@@ -76,7 +237,7 @@ QList<Process> ProcessRepository::findAll()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " processes from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " processes from database");
     return results;
 }
 
@@ -88,11 +249,11 @@ bool ProcessRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete process ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete process ID " + QString::number(id) + " : " + query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted process ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted process ID: " + QString::number(id));
     return true;
 }
 
@@ -159,12 +320,12 @@ std::optional<Process> ProcessRepository::insert(const Process& process)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert process '" + process.getName() + "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert process '" + process.getName() + "' : " + query.lastError().text());
         return std::nullopt;
     }
 
     int id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new process ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new process ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -204,10 +365,11 @@ std::optional<Process> ProcessRepository::update(const Process& process)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update process ID " + QString::number(process.getId()) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update process ID " + QString::number(process.getId()) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated process ID: " + QString::number(process.getId()));
+    LOG_INFO_IN(Database, "Successfully updated process ID: " + QString::number(process.getId()));
     return findById(process.getId());
 }
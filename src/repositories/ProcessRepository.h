@@ -14,6 +14,11 @@ class ProcessRepository : public IProcessRepository
     std::optional<Process> save(const Process& process) override;
     bool deleteById(int id) override;
     QList<Process> findByProjectId(int projectId) override;
+    QList<Process> findActive() override;
+    QHash<int, QList<int>> findDependenciesByProjectId(int projectId) override;
+    QList<int> findDependencyIds(int processId) override;
+    bool setDependencies(int processId, const QList<int>& dependencyIds) override;
+    bool updateRuntimeStates(const QList<Process>& processes) override;
     Process mapFromRecord(const QSqlQuery& query) override;
 
   private:
@@ -0,0 +1,62 @@
+#include "ProcessStatusWriter.h"
+#include "../core/Logger.h"
+#include <QCoreApplication>
+
+ProcessStatusWriter::ProcessStatusWriter(IProcessRepository& processRepository, int flushIntervalMs, QObject* parent)
+    : QObject(parent), processRepository(processRepository)
+{
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(flushIntervalMs);
+    connect(flushTimer, &QTimer::timeout, this, &ProcessStatusWriter::flush);
+
+    if (QCoreApplication* app = QCoreApplication::instance())
+    {
+        connect(app, &QCoreApplication::aboutToQuit, this, &ProcessStatusWriter::flush);
+    }
+}
+
+ProcessStatusWriter::~ProcessStatusWriter()
+{
+    flush();
+}
+
+void ProcessStatusWriter::enqueue(const Process& process)
+{
+    if (process.getId() <= 0)
+        return;
+
+    pending.insert(process.getId(), process);
+
+    // The first update of a batch arms the timer; later ones ride along
+    if (!flushTimer->isActive())
+    {
+        flushTimer->start();
+    }
+}
+
+bool ProcessStatusWriter::flush()
+{
+    flushTimer->stop();
+
+    if (pending.isEmpty())
+        return true;
+
+    QList<Process> batch = pending.values();
+    if (!processRepository.updateRuntimeStates(batch))
+    {
+        // The batch stays pending and is retried on the next tick
+        LOG_WARNING_IN(Database, "Failed to write " + QString::number(batch.size()) + " process states, retrying");
+        flushTimer->start();
+        return false;
+    }
+
+    pending.clear();
+    emit flushed(batch.size());
+    return true;
+}
+
+int ProcessStatusWriter::pendingCount() const
+{
+    return pending.size();
+}
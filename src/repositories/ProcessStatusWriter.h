@@ -0,0 +1,39 @@
+#ifndef PROCESSSTATUSWRITER_H
+#define PROCESSSTATUSWRITER_H
+
+#include "interfaces/IProcessRepository.h"
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+// Write-behind queue for the runtime fields of processes. Updates are coalesced per process and
+// written in one transaction every FlushIntervalMs, so a mass start or stop costs one commit
+// instead of a full-row UPDATE and SELECT per transition. Pending updates are flushed on quit.
+class ProcessStatusWriter : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ProcessStatusWriter(IProcessRepository& processRepository, int flushIntervalMs = FlushIntervalMs,
+                                 QObject* parent = nullptr);
+    ~ProcessStatusWriter();
+
+    // Queues the status, PID, start time and uptime of the process; a newer update replaces a pending one
+    void enqueue(const Process& process);
+
+    // Writes everything pending right away; readers call this before loading processes
+    bool flush();
+    int pendingCount() const;
+
+    static constexpr int FlushIntervalMs = 250;
+
+  signals:
+    void flushed(int count);
+
+  private:
+    IProcessRepository& processRepository;
+    QHash<int, Process> pending;
+    QTimer* flushTimer = nullptr;
+};
+
+#endif // PROCESSSTATUSWRITER_H
@@ -17,19 +17,19 @@ std::optional<ProcessTemplate> ProcessTemplateRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding process template ID " + QString::number(id) + " : " +
-                  query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding process template ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto processTemplate = mapFromRecord(query);
-        LOG_INFO("Successfully found process template ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found process template ID: " + QString::number(id));
         return processTemplate;
     }
 
-    LOG_INFO("Process template not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Process template not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -40,7 +40,7 @@ QList<ProcessTemplate> ProcessTemplateRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all process templates: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all process templates: " + query.lastError().text());
         return templates;
     }
 
@@ -49,7 +49,7 @@ QList<ProcessTemplate> ProcessTemplateRepository::findAll()
         templates.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(templates.size()) + " process templates from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(templates.size()) + " process templates from database");
     return templates;
 }
 
@@ -66,11 +66,12 @@ bool ProcessTemplateRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete process template ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete process template ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted process template ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted process template ID: " + QString::number(id));
     return true;
 }
 
@@ -109,13 +110,13 @@ std::optional<ProcessTemplate> ProcessTemplateRepository::insert(const ProcessTe
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert process template '" + processTemplate.getName() +
-                  "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert process template '" + processTemplate.getName() + "' : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     auto id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new process template ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new process template ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -146,11 +147,11 @@ std::optional<ProcessTemplate> ProcessTemplateRepository::update(const ProcessTe
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update process template ID " + QString::number(processTemplate.getId()) + " : " +
-                  query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update process template ID " + QString::number(processTemplate.getId()) +
+                     " : " + query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated process template ID: " + QString::number(processTemplate.getId()));
+    LOG_INFO_IN(Database, "Successfully updated process template ID: " + QString::number(processTemplate.getId()));
     return processTemplate;
 }
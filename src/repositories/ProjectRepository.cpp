@@ -17,18 +17,19 @@ std::optional<Project> ProjectRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding project ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding project ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto project = mapFromRecord(query);
-        LOG_INFO("Successfully found project ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found project ID: " + QString::number(id));
         return project;
     }
 
-    LOG_INFO("Project not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Project not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -40,18 +41,19 @@ std::optional<Project> ProjectRepository::findByName(const QString& name)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding project with name " + name + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding project with name " + name + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto project = mapFromRecord(query);
-        LOG_INFO("Successfully found project with name: " + name);
+        LOG_INFO_IN(Database, "Successfully found project with name: " + name);
         return project;
     }
 
-    LOG_INFO("Project not found with name: " + name);
+    LOG_INFO_IN(Database, "Project not found with name: " + name);
     return std::nullopt;
 }
 
@@ -64,8 +66,8 @@ QList<Project> ProjectRepository::findByDirectoryPath(const QString& directoryPa
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding projects by directory path " + directoryPath + " : " +
-                  query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding projects by directory path " + directoryPath + " : " +
+                     query.lastError().text());
         return results;
     }
 
@@ -74,7 +76,8 @@ QList<Project> ProjectRepository::findByDirectoryPath(const QString& directoryPa
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Found " + QString::number(results.size()) + " projects with directory path: " + directoryPath);
+    LOG_INFO_IN(Database, "Found " + QString::number(results.size()) + " projects with directory path: " +
+                directoryPath);
     return results;
 }
 
@@ -90,7 +93,7 @@ QList<Project> ProjectRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all projects: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all projects: " + query.lastError().text());
         return results;
     }
 
@@ -99,7 +102,7 @@ QList<Project> ProjectRepository::findAll()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " projects from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " projects from database");
     return results;
 }
 
@@ -111,7 +114,7 @@ QList<Project> ProjectRepository::findAllByRecentlyOpened()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching recently opened projects: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching recently opened projects: " + query.lastError().text());
         return results;
     }
 
@@ -120,7 +123,7 @@ QList<Project> ProjectRepository::findAllByRecentlyOpened()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " recently opened projects");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " recently opened projects");
     return results;
 }
 
@@ -133,18 +136,18 @@ bool ProjectRepository::updateLastOpened(int projectId)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update last_opened_at for project ID " +
-                  QString::number(projectId) + ": " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update last_opened_at for project ID " + QString::number(projectId) + ": " +
+                     query.lastError().text());
         return false;
     }
 
     if (query.numRowsAffected() == 0)
     {
-        LOG_WARNING("No project found to update last_opened_at with ID: " + QString::number(projectId));
+        LOG_WARNING_IN(Database, "No project found to update last_opened_at with ID: " + QString::number(projectId));
         return false;
     }
 
-    LOG_INFO("Updated last_opened_at for project ID: " + QString::number(projectId));
+    LOG_INFO_IN(Database, "Updated last_opened_at for project ID: " + QString::number(projectId));
     return true;
 }
 
@@ -156,11 +159,11 @@ bool ProjectRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete project ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete project ID " + QString::number(id) + " : " + query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted project ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted project ID: " + QString::number(id));
     return true;
 }
 
@@ -192,12 +195,12 @@ std::optional<Project> ProjectRepository::insert(const Project& project)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert project '" + project.getName() + "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert project '" + project.getName() + "' : " + query.lastError().text());
         return std::nullopt;
     }
 
     auto id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new project ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new project ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -215,10 +218,11 @@ std::optional<Project> ProjectRepository::update(const Project& project)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update project ID " + QString::number(project.getId()) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update project ID " + QString::number(project.getId()) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated project ID: " + QString::number(project.getId()));
+    LOG_INFO_IN(Database, "Successfully updated project ID: " + QString::number(project.getId()));
     return project;
 }
@@ -1,6 +1,7 @@
 #ifndef REPOSITORYPROVIDER_H
 #define REPOSITORYPROVIDER_H
 
+#include "ProcessStatusWriter.h"
 #include "interfaces/IAppRepository.h"
 #include "interfaces/IEditorRepository.h"
 #include "interfaces/INoteRepository.h"
@@ -8,6 +9,7 @@
 #include "interfaces/IProcessTemplateRepository.h"
 #include "interfaces/IProjectRepository.h"
 #include "interfaces/ISnippetRepository.h"
+#include <memory>
 
 class RepositoryProvider
 {
@@ -22,7 +24,8 @@ class RepositoryProvider
         : projectRepository(std::move(projectRepository)), noteRepository(std::move(noteRepository)),
           processRepository(std::move(processRepository)), editorRepository(std::move(editorRepository)),
           processTemplateRepository(std::move(processTemplateRepository)), appRepository(std::move(appRepository)),
-          snippetRepository(std::move(snippetRepository))
+          snippetRepository(std::move(snippetRepository)),
+          processStatusWriter(std::make_unique<ProcessStatusWriter>(*this->processRepository))
     {
     }
 
@@ -61,6 +64,12 @@ class RepositoryProvider
         return *snippetRepository;
     }
 
+    // Batched writes of process status changes, backed by the process repository
+    ProcessStatusWriter& getProcessStatusWriter() const
+    {
+        return *processStatusWriter;
+    }
+
   private:
     std::unique_ptr<IProjectRepository> projectRepository;
     std::unique_ptr<INoteRepository> noteRepository;
@@ -69,6 +78,7 @@ class RepositoryProvider
     std::unique_ptr<IProcessTemplateRepository> processTemplateRepository;
     std::unique_ptr<IAppRepository> appRepository;
     std::unique_ptr<ISnippetRepository> snippetRepository;
+    std::unique_ptr<ProcessStatusWriter> processStatusWriter;
 };
 
 #endif // REPOSITORYPROVIDER_H
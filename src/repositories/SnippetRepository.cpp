@@ -16,18 +16,19 @@ std::optional<Snippet> SnippetRepository::findById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when finding snippet ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when finding snippet ID " + QString::number(id) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
     if (query.next())
     {
         auto snippet = mapFromRecord(query);
-        LOG_INFO("Successfully found snippet ID: " + QString::number(id));
+        LOG_INFO_IN(Database, "Successfully found snippet ID: " + QString::number(id));
         return snippet;
     }
 
-    LOG_INFO("Snippet not found with ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Snippet not found with ID: " + QString::number(id));
     return std::nullopt;
 }
 
@@ -44,7 +45,7 @@ QList<Snippet> SnippetRepository::findAll()
 
     if (!query.exec())
     {
-        LOG_ERROR("Database error when fetching all snippets: " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Database error when fetching all snippets: " + query.lastError().text());
         return results;
     }
 
@@ -53,7 +54,7 @@ QList<Snippet> SnippetRepository::findAll()
         results.append(mapFromRecord(query));
     }
 
-    LOG_INFO("Fetched " + QString::number(results.size()) + " snippets from database");
+    LOG_INFO_IN(Database, "Fetched " + QString::number(results.size()) + " snippets from database");
     return results;
 }
 
@@ -65,11 +66,11 @@ bool SnippetRepository::deleteById(int id)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to delete snippet ID " + QString::number(id) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to delete snippet ID " + QString::number(id) + " : " + query.lastError().text());
         return false;
     }
 
-    LOG_INFO("Successfully deleted snippet ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully deleted snippet ID: " + QString::number(id));
     return true;
 }
 
@@ -99,12 +100,12 @@ std::optional<Snippet> SnippetRepository::insert(const Snippet& snippet)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to insert snippet '" + snippet.getTitle() + "' : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to insert snippet '" + snippet.getTitle() + "' : " + query.lastError().text());
         return std::nullopt;
     }
 
     auto id = query.lastInsertId().toInt();
-    LOG_INFO("Successfully inserted new snippet ID: " + QString::number(id));
+    LOG_INFO_IN(Database, "Successfully inserted new snippet ID: " + QString::number(id));
     return findById(id);
 }
 
@@ -124,10 +125,11 @@ std::optional<Snippet> SnippetRepository::update(const Snippet& snippet)
 
     if (!query.exec())
     {
-        LOG_ERROR("Failed to update snippet ID " + QString::number(snippet.getId()) + " : " + query.lastError().text());
+        LOG_ERROR_IN(Database, "Failed to update snippet ID " + QString::number(snippet.getId()) + " : " +
+                     query.lastError().text());
         return std::nullopt;
     }
 
-    LOG_INFO("Successfully updated snippet ID: " + QString::number(snippet.getId()));
+    LOG_INFO_IN(Database, "Successfully updated snippet ID: " + QString::number(snippet.getId()));
     return snippet;
 }
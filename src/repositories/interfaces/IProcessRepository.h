@@ -2,6 +2,8 @@
 #define IPROCESSREPOSITORY_H
 
 #include "../../models/Process.h"
+#include <QHash>
+#include <QList>
 #include <QSqlQuery>
 #include <QString>
 #include <optional>
@@ -17,6 +19,18 @@ class IProcessRepository
     virtual bool deleteById(int id) = 0;
 
     virtual QList<Process> findByProjectId(int projectId) = 0;
+
+    // Every process whose persisted status is not Stopped, across all projects
+    virtual QList<Process> findActive() = 0;
+
+    // Launch plan: maps each process of the project to the processes it waits for
+    virtual QHash<int, QList<int>> findDependenciesByProjectId(int projectId) = 0;
+    virtual QList<int> findDependencyIds(int processId) = 0;
+    virtual bool setDependencies(int processId, const QList<int>& dependencyIds) = 0;
+
+    // Writes only the runtime fields (status, pid, last_started_at, uptime) of every process in one transaction
+    virtual bool updateRuntimeStates(const QList<Process>& processes) = 0;
+
     virtual Process mapFromRecord(const QSqlQuery& query) = 0;
 };
 
@@ -1,22 +1,46 @@
 ﻿#include "ProcessWindow.h"
-#include "../core/AnsiHtmlConverter.h"
+#include "../core/ProcessSupervisor.h"
 #include "../styles/ButtonStyle.h"
 #include "../styles/GroupBoxStyle.h"
 #include "../styles/InputStyle.h"
 #include <QApplication>
 #include <QDateTime>
 #include <QDesktopServices>
-#include <QDir>
 #include <QFileDialog>
 #include <QFormLayout>
+#include <QGridLayout>
 #include <QGroupBox>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QProcess>
-#include <QScrollBar>
 #include <QSplitter>
 #include <QTabWidget>
 #include <QTimer>
+#include <algorithm>
+
+namespace
+{
+    // Typing pauses this long before the log is filtered again
+    constexpr int FilterDelayMs = 300;
+
+    QList<qint64> intersect(const QList<qint64>& left, const QList<qint64>& right)
+    {
+        QList<qint64> result;
+        std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(result));
+        return result;
+    }
+
+    QString formatBytes(double bytes)
+    {
+        if (bytes >= 1024.0 * 1024.0 * 1024.0)
+            return QString::number(bytes / (1024.0 * 1024.0 * 1024.0), 'f', 1) + " GB";
+        if (bytes >= 1024.0 * 1024.0)
+            return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+        if (bytes >= 1024.0)
+            return QString::number(bytes / 1024.0, 'f', 1) + " KB";
+        return QString::number(bytes, 'f', 0) + " B";
+    }
+} // namespace
 
 ProcessWindow::ProcessWindow(const Process& process, QWidget* parent) : BaseWindow(parent), currentProcess(process)
 {
@@ -28,6 +52,17 @@ ProcessWindow::ProcessWindow(const Process& process, QWidget* parent) : BaseWind
     setProcess(process);
 
     updateTimer->start();
+
+    if (currentProcess.getStatus() == Process::Status::Running)
+    {
+        startResourceSampling(currentProcess.getPID());
+    }
+}
+
+ProcessWindow::~ProcessWindow()
+{
+    stopResourceSampling();
+    LogStreamHub::instance().release(currentProcess.getId());
 }
 
 void ProcessWindow::setupUI()
@@ -54,6 +89,7 @@ void ProcessWindow::setupUI()
     statusLayout->addWidget(uptimeLabel);
 
     headerLayout->addLayout(statusLayout);
+    setupResourcesGroup(headerLayout);
     mainLayout->addWidget(headerGroup);
 
     tabWidget = new QTabWidget();
@@ -76,6 +112,29 @@ void ProcessWindow::setupUI()
     applyTheme(savedTheme);
 }
 
+void ProcessWindow::setupResourcesGroup(QHBoxLayout* headerLayout)
+{
+    cpuSparkline = new Sparkline("CPU");
+    cpuSparkline->setCeiling(100.0);
+    memorySparkline = new Sparkline("Memory");
+    threadsSparkline = new Sparkline("Threads");
+    openFilesSparkline = new Sparkline("Open files");
+    diskReadSparkline = new Sparkline("Disk read");
+    diskWriteSparkline = new Sparkline("Disk write");
+
+    auto* resourcesLayout = new QGridLayout();
+    resourcesLayout->setHorizontalSpacing(20);
+    resourcesLayout->addWidget(cpuSparkline, 0, 0);
+    resourcesLayout->addWidget(memorySparkline, 0, 1);
+    resourcesLayout->addWidget(threadsSparkline, 0, 2);
+    resourcesLayout->addWidget(openFilesSparkline, 1, 0);
+    resourcesLayout->addWidget(diskReadSparkline, 1, 1);
+    resourcesLayout->addWidget(diskWriteSparkline, 1, 2);
+
+    headerLayout->addSpacing(20);
+    headerLayout->addLayout(resourcesLayout, 1);
+}
+
 void ProcessWindow::setupLogsTab()
 {
     logsTab = new QWidget();
@@ -91,48 +150,193 @@ void ProcessWindow::setupLogsTab()
     themeComboBox->addItem("Terminal Green", "terminal");
     themeComboBox->setStyleSheet(InputStyle::primary());
 
+    logSearchEdit = new QLineEdit();
+    logSearchEdit->setPlaceholderText("Search logs...");
+    logSearchEdit->setClearButtonEnabled(true);
+    logSearchEdit->setStyleSheet(InputStyle::primary());
+
+    previousHitButton = new QPushButton(QIcon(":/Images/ArrowDropUp"), "");
+    previousHitButton->setStyleSheet(ButtonStyle::primary());
+    previousHitButton->setToolTip("Previous match");
+    nextHitButton = new QPushButton(QIcon(":/Images/ArrowDropDown"), "");
+    nextHitButton->setStyleSheet(ButtonStyle::primary());
+    nextHitButton->setToolTip("Next match");
+    logSearchLabel = new QLabel();
+
+    levelComboBox = new QComboBox();
+    levelComboBox->addItem("All levels", int(LogLevel::Unknown));
+    levelComboBox->addItem("Debug and above", int(LogLevel::Debug));
+    levelComboBox->addItem("Info and above", int(LogLevel::Info));
+    levelComboBox->addItem("Warnings and errors", int(LogLevel::Warning));
+    levelComboBox->addItem("Errors only", int(LogLevel::Error));
+    levelComboBox->setStyleSheet(InputStyle::primary());
+
+    jumpTimeEdit = new QDateTimeEdit(QDateTime::currentDateTime());
+    jumpTimeEdit->setDisplayFormat("yyyy-MM-dd HH:mm:ss");
+    jumpTimeEdit->setStyleSheet(InputStyle::primary());
+    jumpButton = new QPushButton("Go");
+    jumpButton->setStyleSheet(ButtonStyle::primary());
+    jumpButton->setToolTip("Jump to the first line logged at or after this time");
+
+    logFilterEdit = new QLineEdit();
+    logFilterEdit->setPlaceholderText("Filter: words \"a phrase\" -exclude /regex/");
+    logFilterEdit->setClearButtonEnabled(true);
+    logFilterEdit->setStyleSheet(InputStyle::primary());
+    logFilterLabel = new QLabel();
+    logFilterTimer = new QTimer(this);
+    logFilterTimer->setSingleShot(true);
+    logFilterTimer->setInterval(FilterDelayMs);
+
     logControlsLayout->addWidget(clearLogsButton);
     logControlsLayout->addWidget(themeComboBox);
+    logControlsLayout->addWidget(levelComboBox);
+    logControlsLayout->addWidget(jumpTimeEdit);
+    logControlsLayout->addWidget(jumpButton);
+    logControlsLayout->addWidget(logFilterEdit);
+    logControlsLayout->addWidget(logFilterLabel);
     logControlsLayout->addStretch();
+    logControlsLayout->addWidget(logSearchEdit);
+    logControlsLayout->addWidget(previousHitButton);
+    logControlsLayout->addWidget(nextHitButton);
+    logControlsLayout->addWidget(logSearchLabel);
 
     layout->addLayout(logControlsLayout);
 
     auto* logsLayout = new QVBoxLayout();
-    logsTextEdit = new QTextBrowser();
-    logsTextEdit->setReadOnly(true);
-    logsTextEdit->setStyleSheet(InputStyle::primary());
+    logView = new LogView();
 
-    logsLayout->addWidget(logsTextEdit);
+    logsLayout->addWidget(logView);
     layout->addLayout(logsLayout);
 
-    QString logsDirPath = QDir::current().absoluteFilePath("logs");
-    QDir logsDir(logsDirPath);
-    if (!logsDir.exists())
-    {
-        logsDir.mkpath(".");
-    }
-
-    QString logFilePath = logsDir.filePath(currentProcess.getName() + ".log");
-    logFile.setFileName(logFilePath);
-
-    if (!logFile.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        logsTextEdit->setPlainText("Failed to open log file: " + logFilePath);
-    }
+    const QString logDirectory = SegmentedLog::directoryFor(currentProcess.getProjectId(), currentProcess.getId());
+    logDocument = std::make_unique<LogDocument>(logDirectory);
 
-    lastLogPosition = logFile.pos();
+    // Live lines show up at once; the document catches up as soon as the segments change on disk
+    logWatcher = new LogWatcher(logDirectory, this);
+    logFilter = new LogFilter(logDirectory, this);
 
-    logUpdateTimer = new QTimer(this);
-    logUpdateTimer->setInterval(1000);
-    logUpdateTimer->start();
+    logStream = &LogStreamHub::instance().acquire(currentProcess.getId());
+    loadLogHistory();
 }
 
 void ProcessWindow::setupConnections()
 {
-    connect(logUpdateTimer, &QTimer::timeout, this, &ProcessWindow::readNewLogEntries);
+    connect(logStream, &LogStream::linesAppended, this, &ProcessWindow::readNewLogLines);
+    connect(logWatcher, &LogWatcher::changed, logView, &LogView::refreshDocument);
+    connect(logWatcher, &LogWatcher::changed, this,
+            [this]()
+            {
+                // A filter shows what the index had when it ran; one at a time keeps up with a busy log
+                if (levelFiltered && pendingFilterId == 0)
+                    filterLogs();
+                if (textFiltered && !logFilter->isRunning())
+                    logFilter->update();
+            });
     connect(clearLogsButton, &QPushButton::clicked, [this]() { clearLogs(); });
+    connect(logSearchEdit, &QLineEdit::returnPressed, this, &ProcessWindow::searchLogs);
+    connect(previousHitButton, &QPushButton::clicked, [this]() { showSearchHit(currentHit - 1); });
+    connect(nextHitButton, &QPushButton::clicked, [this]() { showSearchHit(currentHit + 1); });
+    connect(&LogIndexer::instance(), &LogIndexer::searchFinished, this, &ProcessWindow::onSearchFinished);
+    connect(levelComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ProcessWindow::filterLogs);
+    connect(jumpButton, &QPushButton::clicked, this, &ProcessWindow::jumpToTime);
+    connect(&LogIndexer::instance(), &LogIndexer::filterFinished, this, &ProcessWindow::onFilterFinished);
+    connect(logFilterEdit, &QLineEdit::textChanged, this,
+            [this]()
+            {
+                // The running scan is for a query that is gone
+                logFilter->cancel();
+                logFilterTimer->start();
+            });
+    connect(logFilterEdit, &QLineEdit::returnPressed, this, &ProcessWindow::filterText);
+    connect(logFilterTimer, &QTimer::timeout, this, &ProcessWindow::filterText);
+    connect(logFilter, &LogFilter::matchesFound, this, &ProcessWindow::onTextMatches);
+    connect(logFilter, &LogFilter::finished, this, &ProcessWindow::onTextFilterFinished);
+    connect(&LogIndexer::instance(), &LogIndexer::timeFound, this, &ProcessWindow::onTimeFound);
     connect(updateTimer, &QTimer::timeout, this, &ProcessWindow::updateProcessInfo);
     connect(themeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ProcessWindow::onThemeChanged);
+
+    connect(&ResourceSampler::instance(), &ResourceSampler::sampled, this,
+            [this](int processId, const ResourceSample&)
+            {
+                if (processId == currentProcess.getId())
+                    showResourceHistory();
+            });
+
+    // The supervisor knows the real PID once the command binds its port or hands over to a child
+    ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+    auto followPid = [this](int processId, int pid)
+    {
+        if (processId != currentProcess.getId())
+            return;
+
+        currentProcess.setPID(pid);
+        currentProcess.setStatus(Process::Status::Running);
+        startResourceSampling(pid);
+        updateStatusDisplay();
+    };
+    connect(&supervisor, &ProcessSupervisor::processReady, this, followPid);
+    connect(&supervisor, &ProcessSupervisor::pidChanged, this, followPid);
+    connect(&supervisor, &ProcessSupervisor::processStopped, this,
+            [this](int processId)
+            {
+                if (processId == currentProcess.getId())
+                    stopResourceSampling();
+            });
+}
+
+void ProcessWindow::startResourceSampling(int pid)
+{
+    if (pid <= 0)
+        return;
+
+    // Watch the new PID before dropping the old reference so the history survives the move
+    ResourceSampler::instance().watch(currentProcess.getId(), pid);
+    if (samplingResources)
+        ResourceSampler::instance().unwatch(currentProcess.getId());
+
+    samplingResources = true;
+    showResourceHistory();
+}
+
+void ProcessWindow::stopResourceSampling()
+{
+    if (!samplingResources)
+        return;
+
+    ResourceSampler::instance().unwatch(currentProcess.getId());
+    samplingResources = false;
+}
+
+void ProcessWindow::showResourceHistory()
+{
+    const QList<ResourceSample> history = ResourceSampler::instance().history(currentProcess.getId());
+    if (history.isEmpty())
+        return;
+
+    QList<double> cpu;
+    QList<double> memory;
+    QList<double> threads;
+    QList<double> openFiles;
+    QList<double> diskRead;
+    QList<double> diskWrite;
+
+    for (const ResourceSample& sample : history)
+    {
+        cpu.append(sample.cpuPercent);
+        memory.append(sample.residentBytes);
+        threads.append(sample.threads);
+        openFiles.append(sample.openFiles);
+        diskRead.append(sample.readBytesPerSecond);
+        diskWrite.append(sample.writeBytesPerSecond);
+    }
+
+    const ResourceSample& latest = history.last();
+    cpuSparkline->setValues(cpu, QString::number(latest.cpuPercent, 'f', 1) + " %");
+    memorySparkline->setValues(memory, formatBytes(latest.residentBytes));
+    threadsSparkline->setValues(threads, QString::number(latest.threads));
+    openFilesSparkline->setValues(openFiles, QString::number(latest.openFiles));
+    diskReadSparkline->setValues(diskRead, formatBytes(latest.readBytesPerSecond) + "/s");
+    diskWriteSparkline->setValues(diskWrite, formatBytes(latest.writeBytesPerSecond) + "/s");
 }
 
 void ProcessWindow::setupConfigurationTab()
@@ -189,38 +393,25 @@ void ProcessWindow::updateProcessInfo()
     updateStatusDisplay();
 }
 
-void ProcessWindow::readNewLogEntries()
+void ProcessWindow::loadLogHistory()
 {
-    if (!logFile.isOpen())
-    {
-        return;
-    }
-
-    // Check if the user is currently at the bottom
-    QScrollBar* scrollBar = logsTextEdit->verticalScrollBar();
-    bool wasAtBottom = (scrollBar->value() == scrollBar->maximum());
-
-    logFile.seek(lastLogPosition);
+    logView->setDocument(logDocument.get());
 
-    QStringList newLines;
-    while (!logFile.atEnd())
-    {
-        QString line = QString::fromUtf8(logFile.readLine());
-        newLines << AnsiHtmlConverter::toHtml(line);
-    }
-
-    if (!newLines.isEmpty())
-    {
-        logsTextEdit->append(newLines.join(""));
-    }
+    // Lines the stream holds beyond what the segments have so far
+    const QList<LogLine> buffered = logStream->readFrom(0);
+    lastLogSequence = logStream->nextSequence() - 1;
+    logView->appendLiveLines(buffered);
+}
 
-    lastLogPosition = logFile.pos();
+void ProcessWindow::readNewLogLines()
+{
+    const QList<LogLine> lines = logStream->readFrom(lastLogSequence + 1);
+    if (lines.isEmpty())
+        return;
 
-    // Only auto scroll if the user was at the bottom
-    if (wasAtBottom)
-    {
-        scrollBar->setValue(scrollBar->maximum());
-    }
+    // Lines the ring overwrote before this window got to them are read from the segments
+    lastLogSequence = lines.last().sequence;
+    logView->appendLiveLines(lines);
 }
 
 void ProcessWindow::onThemeChanged(int index)
@@ -233,74 +424,206 @@ void ProcessWindow::onThemeChanged(int index)
 
 void ProcessWindow::applyTheme(const QString& themeName)
 {
-    QString style;
+    QColor background("#1e1e1e");
+    QColor foreground("#d4d4d4");
+    QColor border("#3e3e3e");
 
-    if (themeName == "dark")
-    {
-        style = R"(
-            QTextBrowser {
-                background-color: #1e1e1e;
-                color: #d4d4d4;
-                border: 1px solid #3e3e3e;
-            }
-        )";
-    }
-    else if (themeName == "light")
+    if (themeName == "light")
     {
-        style = R"(
-            QTextBrowser {
-                background-color: #ffffff;
-                color: #000000;
-                border: 1px solid #cccccc;
-            }
-        )";
+        background = QColor("#ffffff");
+        foreground = QColor("#000000");
+        border = QColor("#cccccc");
     }
     else if (themeName == "terminal")
     {
-        style = R"(
-            QTextBrowser {
-                background-color: #000000;
-                color: #00ff00;
-                border: 1px solid #00ff00;
-            }
-        )";
+        background = QColor("#000000");
+        foreground = QColor("#00ff00");
+        border = QColor("#00ff00");
     }
 
-    style += R"(
-        QTextBrowser {
+    // The view paints its rows itself; the style sheet only frames it and picks the font
+    logView->setStyleSheet(QString(R"(
+        LogView {
+            background-color: %1;
+            border: 1px solid %2;
             border-radius: 4px;
-            padding: 8px;
             font-family: 'Consolas', 'Courier New', monospace;
             font-size: 9pt;
         }
-    )";
-
-    logsTextEdit->setStyleSheet(style);
+    )")
+                               .arg(background.name(), border.name()));
+    logView->setColors(background, foreground);
 }
 
 void ProcessWindow::clearLogs()
 {
-    logsTextEdit->clear();
+    // Hides the history instead of truncating a segment the running process is writing to
+    if (!logDocument->clear())
+    {
+        QMessageBox::warning(this, "Clear Logs", "Failed to clear logs in: " + logDocument->directoryPath());
+    }
 
-    if (logFile.isOpen())
+    // Lines already in the stream were cleared with the segments
+    logStream->markCleared();
+    lastLogSequence = logStream->nextSequence() - 1;
+    logView->clearLiveLines();
+    logView->refreshDocument();
+
+    searchHits.clear();
+    searchedText.clear();
+    currentHit = -1;
+    logSearchLabel->clear();
+
+    if (levelFiltered)
+        filterLogs();
+    if (textFiltered)
+        filterText();
+}
+
+void ProcessWindow::searchLogs()
+{
+    const QString text = logSearchEdit->text();
+    if (text.isEmpty())
     {
-        logFile.close();
+        searchHits.clear();
+        searchedText.clear();
+        logSearchLabel->clear();
+        return;
     }
 
-    QFile file(logFile.fileName());
-    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    // Enter on the same text steps through the matches
+    if (text == searchedText && !searchHits.isEmpty())
     {
-        file.close();
+        showSearchHit(currentHit - 1);
+        return;
     }
-    else
+
+    searchedText = text;
+    logSearchLabel->setText("Searching...");
+    pendingSearchId = LogIndexer::instance().search(logDocument->directoryPath(), text.toUtf8());
+}
+
+void ProcessWindow::onSearchFinished(int searchId, const QList<qint64>& offsets)
+{
+    if (searchId != pendingSearchId)
+        return;
+
+    searchHits = offsets;
+    if (searchHits.isEmpty())
     {
-        QMessageBox::warning(this, "Clear Logs", "Failed to clear log file: " + file.fileName());
+        currentHit = -1;
+        logSearchLabel->setText("No matches");
+        return;
     }
 
-    if (!logFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    // The newest match first, Enter and the up button walk back in time
+    showSearchHit(searchHits.size() - 1);
+}
+
+void ProcessWindow::showSearchHit(int index)
+{
+    if (searchHits.isEmpty())
+        return;
+
+    currentHit = (index + searchHits.size()) % searchHits.size();
+    logView->scrollToOffset(searchHits.at(currentHit));
+    logSearchLabel->setText(QString("%1 of %2").arg(currentHit + 1).arg(searchHits.size()));
+}
+
+void ProcessWindow::filterLogs()
+{
+    const auto minimum = static_cast<LogLevel>(levelComboBox->currentData().toInt());
+    if (minimum == LogLevel::Unknown)
     {
-        logsTextEdit->append("Failed to reopen log file after clearing.");
+        pendingFilterId = 0;
+        levelFiltered = false;
+        levelOffsets.clear();
+        showFilters();
+        return;
     }
 
-    lastLogPosition = 0;
+    pendingFilterId = LogIndexer::instance().filter(logDocument->directoryPath(), minimum);
+}
+
+void ProcessWindow::onFilterFinished(int filterId, const QList<qint64>& offsets)
+{
+    if (filterId != pendingFilterId)
+        return;
+
+    pendingFilterId = 0;
+    levelFiltered = true;
+    levelOffsets = offsets;
+    showFilters();
+}
+
+void ProcessWindow::filterText()
+{
+    logFilterTimer->stop();
+    const LogLineMatcher matcher(logFilterEdit->text());
+    if (!matcher.isValid())
+    {
+        logFilter->cancel();
+        logFilterLabel->setText("Invalid regex: " + matcher.errorString());
+        return;
+    }
+
+    textOffsets.clear();
+    if (matcher.isEmpty())
+    {
+        logFilter->cancel();
+        textFiltered = false;
+        logFilterLabel->clear();
+        showFilters();
+        return;
+    }
+
+    // Matches stream in while the worker reads the log
+    textFiltered = true;
+    showFilters();
+    logFilterLabel->setText("Filtering...");
+    logFilter->start(matcher);
+}
+
+void ProcessWindow::onTextMatches(const QList<qint64>& offsets)
+{
+    textOffsets.append(offsets);
+    logView->appendFilter(levelFiltered ? intersect(offsets, levelOffsets) : offsets);
+    logFilterLabel->setText(QString("Filtering... %1 lines").arg(logView->rowCount()));
+}
+
+void ProcessWindow::onTextFilterFinished()
+{
+    logFilterLabel->setText(QString("%1 lines").arg(logView->rowCount()));
+}
+
+void ProcessWindow::showFilters()
+{
+    if (!levelFiltered && !textFiltered)
+        logView->clearFilter();
+    else if (!textFiltered)
+        logView->setFilter(levelOffsets);
+    else if (!levelFiltered)
+        logView->setFilter(textOffsets);
+    else
+        logView->setFilter(intersect(textOffsets, levelOffsets));
+}
+
+void ProcessWindow::jumpToTime()
+{
+    logSearchLabel->setText("Searching...");
+    pendingTimeId =
+        LogIndexer::instance().findTime(logDocument->directoryPath(), jumpTimeEdit->dateTime().toMSecsSinceEpoch());
+}
+
+void ProcessWindow::onTimeFound(int requestId, qint64 offset)
+{
+    if (requestId != pendingTimeId)
+        return;
+
+    if (offset < 0 || !logView->scrollToOffset(offset))
+    {
+        logSearchLabel->setText("Nothing logged after that time");
+        return;
+    }
+    logSearchLabel->clear();
 }
@@ -1,11 +1,19 @@
 #ifndef PROCESSWINDOW_H
 #define PROCESSWINDOW_H
 
+#include "../components/shared/LogView.h"
+#include "../components/shared/Sparkline.h"
+#include "../core/LogIndexer.h"
+#include "../core/LogStream.h"
+#include "../core/LogWatcher.h"
+#include "../core/ResourceSampler.h"
+#include "../core/LogDocument.h"
+#include "../core/LogFilter.h"
 #include "../models/Process.h"
 #include "BaseWindow.h"
 #include <QCheckBox>
 #include <QComboBox>
-#include <QFile>
+#include <QDateTimeEdit>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -17,10 +25,10 @@
 #include <QSettings>
 #include <QTabWidget>
 #include <QTableWidget>
-#include <QTextBrowser>
 #include <QTextEdit>
 #include <QTimer>
 #include <QVBoxLayout>
+#include <memory>
 
 class ProcessWindow : public BaseWindow
 {
@@ -28,6 +36,7 @@ class ProcessWindow : public BaseWindow
 
   public:
     explicit ProcessWindow(const Process& process, QWidget* parent = nullptr);
+    ~ProcessWindow();
     void setProcess(const Process& process);
 
   private slots:
@@ -37,12 +46,28 @@ class ProcessWindow : public BaseWindow
     void setupUI();
     void setupConnections();
     void updateStatusDisplay();
+    void setupResourcesGroup(QHBoxLayout* headerLayout);
+    void startResourceSampling(int pid);
+    void stopResourceSampling();
+    void showResourceHistory();
     void setupLogsTab();
     void setupConfigurationTab();
-    void readNewLogEntries();
+    void loadLogHistory();
+    void readNewLogLines();
     void onThemeChanged(int index);
     void applyTheme(const QString& themeName);
     void clearLogs();
+    void searchLogs();
+    void showSearchHit(int index);
+    void onSearchFinished(int searchId, const QList<qint64>& offsets);
+    void filterLogs();
+    void onFilterFinished(int filterId, const QList<qint64>& offsets);
+    void filterText();
+    void onTextMatches(const QList<qint64>& offsets);
+    void onTextFilterFinished();
+    void showFilters();
+    void jumpToTime();
+    void onTimeFound(int requestId, qint64 offset);
 
   private:
     Process currentProcess;
@@ -50,14 +75,45 @@ class ProcessWindow : public BaseWindow
     QLabel* statusLabel;
     QLabel* pidLabel;
     QLabel* uptimeLabel;
+    Sparkline* cpuSparkline;
+    Sparkline* memorySparkline;
+    Sparkline* threadsSparkline;
+    Sparkline* openFilesSparkline;
+    Sparkline* diskReadSparkline;
+    Sparkline* diskWriteSparkline;
+    bool samplingResources = false;
     QTabWidget* tabWidget;
     QWidget* logsTab;
     QWidget* configurationTab;
     QPushButton* clearLogsButton;
-    QTextBrowser* logsTextEdit;
-    QFile logFile;
-    QTimer* logUpdateTimer;
-    qint64 lastLogPosition = 0;
+    QLineEdit* logSearchEdit;
+    QPushButton* previousHitButton;
+    QPushButton* nextHitButton;
+    QLabel* logSearchLabel;
+    // Line offsets of the last search, oldest first
+    QList<qint64> searchHits;
+    QString searchedText;
+    int currentHit = -1;
+    int pendingSearchId = 0;
+    QComboBox* levelComboBox;
+    QDateTimeEdit* jumpTimeEdit;
+    QPushButton* jumpButton;
+    int pendingFilterId = 0;
+    // Offsets each filter matched, oldest first; the view shows the lines both of them matched
+    QList<qint64> levelOffsets;
+    QList<qint64> textOffsets;
+    bool levelFiltered = false;
+    bool textFiltered = false;
+    QLineEdit* logFilterEdit;
+    QLabel* logFilterLabel;
+    QTimer* logFilterTimer;
+    LogFilter* logFilter = nullptr;
+    int pendingTimeId = 0;
+    LogView* logView;
+    std::unique_ptr<LogDocument> logDocument;
+    LogStream* logStream = nullptr;
+    LogWatcher* logWatcher = nullptr;
+    quint64 lastLogSequence = 0;
     QLabel* nameLabel;
     QLabel* commandLabel;
     QLabel* workingDirLabel;
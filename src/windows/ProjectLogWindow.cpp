@@ -0,0 +1,82 @@
+#include "ProjectLogWindow.h"
+#include "../core/SegmentedLog.h"
+#include <QVBoxLayout>
+
+namespace
+{
+    // Tags of the processes, in the order they are listed; readable on dark and light backgrounds
+    const QList<QColor> TagColors = {QColor("#1E90FF"), QColor("#E5A50A"), QColor("#2EC27E"), QColor("#C061CB"),
+                                     QColor("#E66100"), QColor("#26A2A2"), QColor("#E01B24"), QColor("#8F8F2E")};
+}
+
+ProjectLogWindow::ProjectLogWindow(const Project& project, const QList<Process>& processes, QWidget* parent)
+    : BaseWindow(parent), currentProject(project), currentProcesses(processes)
+{
+    for (qsizetype i = 0; i < currentProcesses.size(); ++i)
+    {
+        const Process& process = currentProcesses.at(i);
+        mergedLog.addSource(SegmentedLog::directoryFor(process.getProjectId(), process.getId()), process.getName(),
+                            TagColors.at(i % TagColors.size()));
+    }
+
+    setupUI();
+    setupConnections();
+    applyTheme();
+    logView->setMergedLog(&mergedLog);
+}
+
+void ProjectLogWindow::setupUI()
+{
+    setWindowTitle("Project Logs - " + currentProject.getName());
+    setMinimumSize(800, 600);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(20, 20, 20, 20);
+
+    logView = new LogView();
+    layout->addWidget(logView);
+
+    for (const Process& process : currentProcesses)
+        logWatchers.append(new LogWatcher(SegmentedLog::directoryFor(process.getProjectId(), process.getId()), this));
+}
+
+void ProjectLogWindow::setupConnections()
+{
+    // Only new lines are merged, however many processes changed at once
+    for (LogWatcher* watcher : logWatchers)
+        connect(watcher, &LogWatcher::changed, logView, &LogView::refreshDocument);
+}
+
+void ProjectLogWindow::applyTheme()
+{
+    // Same terminal theme as the process windows
+    const QString themeName = settings.value("terminal/theme", "dark").toString();
+    QColor background("#1e1e1e");
+    QColor foreground("#d4d4d4");
+    QColor border("#3e3e3e");
+
+    if (themeName == "light")
+    {
+        background = QColor("#ffffff");
+        foreground = QColor("#000000");
+        border = QColor("#cccccc");
+    }
+    else if (themeName == "terminal")
+    {
+        background = QColor("#000000");
+        foreground = QColor("#00ff00");
+        border = QColor("#00ff00");
+    }
+
+    logView->setStyleSheet(QString(R"(
+        LogView {
+            background-color: %1;
+            border: 1px solid %2;
+            border-radius: 4px;
+            font-family: 'Consolas', 'Courier New', monospace;
+            font-size: 9pt;
+        }
+    )")
+                               .arg(background.name(), border.name()));
+    logView->setColors(background, foreground);
+}
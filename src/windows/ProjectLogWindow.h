@@ -0,0 +1,35 @@
+#ifndef PROJECTLOGWINDOW_H
+#define PROJECTLOGWINDOW_H
+
+#include "../components/shared/LogView.h"
+#include "../core/LogWatcher.h"
+#include "../core/MergedLog.h"
+#include "../models/Process.h"
+#include "../models/Project.h"
+#include "BaseWindow.h"
+#include <QList>
+#include <QSettings>
+
+// Output of every process of a project in one view, interleaved by the time it was received; each
+// line carries the colored name of its process
+class ProjectLogWindow : public BaseWindow
+{
+    Q_OBJECT
+
+  public:
+    ProjectLogWindow(const Project& project, const QList<Process>& processes, QWidget* parent = nullptr);
+
+  private:
+    void setupUI() override;
+    void setupConnections() override;
+    void applyTheme() override;
+
+    Project currentProject;
+    QList<Process> currentProcesses;
+    MergedLog mergedLog;
+    LogView* logView;
+    QList<LogWatcher*> logWatchers;
+    QSettings settings;
+};
+
+#endif // PROJECTLOGWINDOW_H
@@ -68,6 +68,7 @@ void SettingsWindow::setupConnections()
         connect(themeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
                 [this](int index) { applyButton->setEnabled(true); });
     }
+    connect(compactOutputCheck, &QCheckBox::toggled, this, [this]() { applyButton->setEnabled(true); });
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged, this, &SettingsWindow::onThemeChanged);
 }
 
@@ -169,6 +170,16 @@ QWidget* SettingsWindow::createGeneralPage()
 
     formLayout->addRow(themeLabel, themeComboBox);
 
+    QLabel* compactOutputLabel = new QLabel("Process output:");
+    compactOutputLabel->setProperty("role", "text");
+    compactOutputLabel->setStyleSheet(FontStyle::text());
+    compactOutputCheck = new QCheckBox("Collapse progress bars and repeated lines");
+    compactOutputCheck->setToolTip("Keeps only the last frame of lines redrawn with carriage returns and counts "
+                                   "repeated lines. Turn off to log the raw output. Applies to processes started "
+                                   "afterwards.");
+
+    formLayout->addRow(compactOutputLabel, compactOutputCheck);
+
     layout->addLayout(formLayout);
     layout->addStretch();
 
@@ -509,6 +520,7 @@ void SettingsWindow::loadSettings()
             themeComboBox->setCurrentIndex(themeIndex);
         }
     }
+    compactOutputCheck->setChecked(settings.value("logs/compactOutput", true).toBool());
 
     loadEditors();
     loadTemplates();
@@ -530,6 +542,7 @@ void SettingsWindow::saveSettings()
             ThemeManager::instance().setTheme(selectedTheme);
         }
     }
+    settings.setValue("logs/compactOutput", compactOutputCheck->isChecked());
 
     saveEditors();
     saveTemplates();
@@ -103,6 +103,7 @@ class SettingsWindow : public BaseWindow
     // General Page Widgets
     QWidget* generalPage;
     QComboBox* themeComboBox;
+    QCheckBox* compactOutputCheck;
 };
 
 #endif // SETTINGSWINDOW_H
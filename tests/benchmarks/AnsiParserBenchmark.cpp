@@ -0,0 +1,163 @@
+// clang-format off
+
+#include "../../src/core/AnsiHtmlConverter.h"
+#include "../../src/core/AnsiParser.h"
+#include <QElapsedTimer>
+#include <QMap>
+#include <QRegularExpression>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // The regex-based converter this parser replaced, kept here as the baseline
+    QString legacyToHtml(const QString& text)
+    {
+        const QMap<QString, QString> fg = {
+            {"30", "black"}, {"31", "red"}, {"32", "green"}, {"33", "yellow"}, {"34", "blue"}, {"35", "magenta"},
+            {"36", "cyan"}, {"37", "white"}, {"90", "gray"}, {"91", "lightcoral"}, {"92", "lightgreen"},
+            {"93", "lightyellow"}, {"94", "lightblue"}, {"95", "violet"}, {"96", "cyan"}, {"97", "white"}};
+        const QMap<QString, QString> bg = {{"40", "black"}, {"41", "red"}, {"42", "green"}, {"43", "yellow"},
+                                           {"44", "blue"}, {"45", "magenta"}, {"46", "cyan"}, {"47", "white"}};
+
+        QString html = text;
+        html.replace("&", "&amp;");
+        html.replace("<", "&lt;");
+        html.replace(">", "&gt;");
+
+        QRegularExpression ansiRegex("\x1B\\[([0-9;]+)m");
+        int offset = 0;
+        QString result;
+        int lastPos = 0;
+        bool inSpan = false;
+
+        while (true)
+        {
+            QRegularExpressionMatch match = ansiRegex.match(html, offset);
+            if (!match.hasMatch())
+                break;
+
+            result += html.mid(lastPos, match.capturedStart() - lastPos);
+
+            QString style;
+            for (const QString& code : match.captured(1).split(';'))
+            {
+                if (code == "0")
+                {
+                    if (inSpan)
+                    {
+                        result += "</span>";
+                        inSpan = false;
+                    }
+                    style = "";
+                    break;
+                }
+                if (fg.contains(code))
+                    style += "color:" + fg[code] + ";";
+                if (bg.contains(code))
+                    style += "background-color:" + bg[code] + ";";
+                if (code == "1")
+                    style += "font-weight:bold;";
+                if (code == "3")
+                    style += "font-style:italic;";
+            }
+
+            if (!style.isEmpty())
+            {
+                if (inSpan)
+                    result += "</span>";
+                result += "<span style=\"" + style + "\">";
+                inSpan = true;
+            }
+
+            lastPos = match.capturedEnd();
+            offset = match.capturedEnd();
+        }
+
+        result += html.mid(lastPos);
+        if (inSpan)
+            result += "</span>";
+
+        QRegularExpression urlRegex(R"(\b(https?://[^\s&lt;&gt;&quot;]+))");
+        result.replace(urlRegex, R"(<a href="\1" style="color: #1E90FF; text-decoration: underline;">\1</a>)");
+        result.replace("\n", "<br>");
+        return result;
+    }
+
+    QList<QByteArray> sampleLines(bool colored)
+    {
+        QList<QByteArray> lines;
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (colored)
+                lines.append("\x1b[2m12:00:0" + QByteArray::number(i % 10) + "\x1b[22m \x1b[36m[vite]\x1b[39m "
+                             "\x1b[32mhmr update\x1b[39m \x1b[2m/src/components/Item" + QByteArray::number(i) +
+                             ".vue\x1b[22m\n");
+            else
+                lines.append("2024-05-01 12:00:00.123  INFO 4242 --- [nio-8080-exec-" + QByteArray::number(i % 10) +
+                             "] o.s.web.servlet.DispatcherServlet : Completed initialization in 1 ms\n");
+        }
+        return lines;
+    }
+
+    template <typename Convert> double linesPerSecond(const QList<QByteArray>& lines, Convert convert)
+    {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        qsizetype total = 0;
+        for (const QByteArray& line : lines)
+            total += convert(line);
+        const double seconds = qMax<qint64>(elapsed.nsecsElapsed(), 1) / 1e9;
+        REQUIRE(total > 0);
+        return lines.size() / seconds;
+    }
+}
+
+TEST_CASE("ANSI parser: lines per second against the regex converter", "[.][benchmark][ansiParser]")
+{
+    for (bool colored : {false, true})
+    {
+        const QList<QByteArray> lines = sampleLines(colored);
+        const char* kind = colored ? "colored" : "plain";
+
+        const double legacy = linesPerSecond(lines, [](const QByteArray& line)
+                                             { return legacyToHtml(QString::fromUtf8(line)).size(); });
+
+        AnsiHtmlConverter converter;
+        const double html = linesPerSecond(lines, [&](const QByteArray& line) { return converter.convert(line).size(); });
+
+        AnsiParser parser;
+        const double spans = linesPerSecond(lines, [&](const QByteArray& line) { return parser.feed(line).size(); });
+
+        WARN(kind << " lines/s: regex " << qRound64(legacy) << ", streaming HTML " << qRound64(html)
+                  << ", streaming spans " << qRound64(spans));
+        CHECK(html > legacy);
+    }
+
+    const QList<QByteArray> lines = sampleLines(true);
+    BENCHMARK("regex converter (1000 colored lines)")
+    {
+        qsizetype total = 0;
+        for (int i = 0; i < 1000; ++i)
+            total += legacyToHtml(QString::fromUtf8(lines.at(i))).size();
+        return total;
+    };
+
+    AnsiHtmlConverter converter;
+    BENCHMARK("streaming HTML (1000 colored lines)")
+    {
+        qsizetype total = 0;
+        for (int i = 0; i < 1000; ++i)
+            total += converter.convert(lines.at(i)).size();
+        return total;
+    };
+
+    AnsiParser parser;
+    BENCHMARK("streaming spans (1000 colored lines)")
+    {
+        qsizetype total = 0;
+        for (int i = 0; i < 1000; ++i)
+            total += parser.feed(lines.at(i)).size();
+        return total;
+    };
+}
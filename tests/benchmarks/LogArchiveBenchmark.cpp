@@ -0,0 +1,60 @@
+// clang-format off
+
+#include "../../src/core/LogArchive.h"
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Log archive: 8 MB segment", "[.][benchmark][logArchive]")
+{
+    constexpr qint64 SegmentBytes = 8 * 1024 * 1024;
+    constexpr int Reads = 1000;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString segmentPath = dir.filePath("segment.log");
+    const QString archivePath = dir.filePath("segment.logz");
+    {
+        QFile segment(segmentPath);
+        REQUIRE(segment.open(QIODevice::WriteOnly));
+        for (int i = 0; segment.size() < SegmentBytes; ++i)
+        {
+            const QByteArray time = QByteArray::asprintf("2024-05-01T12:%02d:%02d.%03dZ", i / 60000 % 60,
+                                                         i / 1000 % 60, i % 1000);
+            segment.write(time + " \x1b[32mINFO\x1b[0m http - GET /api/items/" + QByteArray::number(i * 7919 % 100000) +
+                          " 200 in " + QByteArray::number(i % 37) + "ms\n");
+        }
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    REQUIRE(LogArchive::write(segmentPath, archivePath, 1));
+    const qint64 writeMs = elapsed.elapsed();
+
+    // Every read opens the archive anew, so nothing comes from the block cache
+    const qint64 archivedSize = QFileInfo(archivePath).size();
+    QRandomGenerator random(42);
+    elapsed.restart();
+    for (int i = 0; i < Reads; ++i)
+    {
+        LogArchive archive(archivePath);
+        REQUIRE(archive.open());
+        REQUIRE(archive.read(random.bounded(SegmentBytes - 200), 200).size() == 200);
+    }
+    const double readMs = double(elapsed.nsecsElapsed()) / 1e6 / Reads;
+
+    WARN("compressed " << SegmentBytes / (1024 * 1024) << " MB to " << archivedSize / 1024 << " KB ("
+                       << double(SegmentBytes) / archivedSize << "x) in " << writeMs << " ms; a random read takes "
+                       << readMs << " ms");
+    CHECK(readMs < 10);
+
+    BENCHMARK("random read, cold")
+    {
+        LogArchive archive(archivePath);
+        archive.open();
+        return archive.read(random.bounded(SegmentBytes - 200), 200).size();
+    };
+}
@@ -0,0 +1,55 @@
+// clang-format off
+
+#include "../../src/core/LogCompactor.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // What a webpack build looks like: a progress line redrawn for every module, a warning every hundred modules
+    // and a summary, in chunks of the size a pipe hands over
+    QList<QByteArray> webpackChunks(int modules)
+    {
+        QByteArray output;
+        for (int i = 0; i < modules; ++i)
+        {
+            output += "\r\x1b[2K<s> [webpack.Progress] " + QByteArray::number(10 + i * 80 / modules) + "% building " +
+                      QByteArray::number(i) + "/" + QByteArray::number(modules) + " modules ./src/module" +
+                      QByteArray::number(i) + ".js";
+            if (i % 100 == 0)
+                output += "\nWARNING in ./node_modules/legacy/index.js: export 'default' was not found\n";
+        }
+        output += "\ncompiled with warnings in 8123 ms\n";
+
+        QList<QByteArray> chunks;
+        for (qsizetype start = 0; start < output.size(); start += 4096)
+            chunks.append(output.mid(start, 4096));
+        return chunks;
+    }
+
+    qsizetype compactAll(const QList<QByteArray>& chunks)
+    {
+        LogCompactor compactor;
+        qsizetype written = 0;
+        for (const QByteArray& chunk : chunks)
+            written += compactor.compact(chunk).size();
+        return written + compactor.flush().size();
+    }
+}
+
+TEST_CASE("Log compactor: webpack build output", "[.][benchmark][logCompactor]")
+{
+    const QList<QByteArray> chunks = webpackChunks(20000);
+    qsizetype rawBytes = 0;
+    for (const QByteArray& chunk : chunks)
+        rawBytes += chunk.size();
+
+    const qsizetype compactedBytes = compactAll(chunks);
+    WARN(rawBytes / 1024 << " KB raw, " << compactedBytes / 1024 << " KB compacted");
+    CHECK(compactedBytes * 10 < rawBytes);
+
+    BENCHMARK("compact")
+    {
+        return compactAll(chunks);
+    };
+}
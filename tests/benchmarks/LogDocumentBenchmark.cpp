@@ -0,0 +1,62 @@
+// clang-format off
+
+#include "../../src/core/LogDocument.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Log document: index and page through 256 MB", "[.][benchmark][logDocument]")
+{
+    constexpr qint64 TotalBytes = 256LL * 1024 * 1024;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    {
+        SegmentedLog log(dir.path(), SegmentedLog::MaxSegmentBytes, TotalBytes * 2);
+        REQUIRE(log.openForAppend());
+
+        QByteArray block;
+        for (int i = 0; block.size() < 1024 * 1024; ++i)
+            block += "\x1b[32m[dev]\x1b[0m GET /api/items/" + QByteArray::number(i) + " 200 in 3ms\n";
+        for (qint64 written = 0; written < TotalBytes; written += block.size())
+            log.append(block);
+    }
+
+    LogDocument document(dir.path());
+    QElapsedTimer elapsed;
+    elapsed.start();
+    document.refresh();
+    while (document.indexMore())
+    {
+    }
+    const qint64 tailMs = elapsed.elapsed();
+    const QList<QByteArray> lastScreen = document.lines(document.lineCount() - 60, 60);
+    const qint64 firstPaintMs = elapsed.elapsed();
+
+    elapsed.restart();
+    while (document.hasOlder())
+        document.indexOlder();
+    const qint64 olderMs = elapsed.elapsed();
+
+    WARN("tail of " << lastScreen.size() << " rows ready in " << firstPaintMs << " ms (indexed in " << tailMs
+                    << " ms); " << document.lineCount() << " lines indexed in " << olderMs << " ms more");
+    REQUIRE(document.lineCount() > 0);
+
+    // One screen of rows anywhere in the log, as the view asks for it when painting
+    const qint64 middle = document.lineCount() / 2;
+    BENCHMARK("60 rows from the middle")
+    {
+        return document.lines(middle, 60);
+    };
+
+    BENCHMARK("open on the tail")
+    {
+        LogDocument fresh(dir.path());
+        fresh.refresh();
+        while (fresh.indexMore())
+        {
+        }
+        return fresh.lines(fresh.lineCount() - 60, 60);
+    };
+}
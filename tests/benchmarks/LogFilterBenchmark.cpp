@@ -0,0 +1,83 @@
+// clang-format off
+
+#include "../../src/core/LogFilter.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // Time to the first batch of matches and to the end of the scan
+    struct FilterTimes
+    {
+        qint64 firstBatchMs = -1;
+        qint64 totalMs = 0;
+        qsizetype matches = 0;
+    };
+
+    FilterTimes filterAll(LogFilter& filter, const QString& query)
+    {
+        FilterTimes times;
+        QElapsedTimer elapsed;
+        QObject receiver;
+        QObject::connect(&filter, &LogFilter::matchesFound, &receiver,
+                         [&](const QList<qint64>& offsets)
+                         {
+                             if (times.firstBatchMs < 0)
+                                 times.firstBatchMs = elapsed.elapsed();
+                             times.matches += offsets.size();
+                         });
+        QSignalSpy finishedSpy(&filter, &LogFilter::finished);
+
+        elapsed.start();
+        filter.start(LogLineMatcher(query));
+        REQUIRE(finishedSpy.wait(120000));
+        times.totalMs = elapsed.elapsed();
+        return times;
+    }
+}
+
+TEST_CASE("Log filter: terms and regex over 256 MB", "[.][benchmark][logFilter]")
+{
+    constexpr qint64 TotalBytes = 256LL * 1024 * 1024;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    {
+        SegmentedLog log(dir.path(), SegmentedLog::MaxSegmentBytes, TotalBytes * 2);
+        REQUIRE(log.openForAppend());
+
+        QByteArray block;
+        for (int i = 0; block.size() < 1024 * 1024; ++i)
+            block += "\x1b[32m[dev]\x1b[0m GET /api/items/" + QByteArray::number(i) + " 200 in 3ms\n";
+        qint64 written = 0;
+        for (int i = 0; written < TotalBytes; ++i)
+        {
+            log.append(block);
+            written += block.size();
+            if (i % 50 == 0)
+                log.append("Unhandled rejection: ECONNRESET while proxying /api/orders/" + QByteArray::number(i) + "\n");
+        }
+    }
+
+    LogFilter filter(dir.path());
+    for (const QString& query : {QString("econnreset -items"), QString("/orders/\\d+$/")})
+    {
+        const FilterTimes times = filterAll(filter, query);
+        WARN(query.toStdString() << ": " << times.matches << " matches, first after " << times.firstBatchMs
+                                 << " ms, all after " << times.totalMs << " ms");
+        CHECK(times.matches > 0);
+    }
+
+    BENCHMARK("terms")
+    {
+        return filterAll(filter, "econnreset -items").matches;
+    };
+
+    BENCHMARK("regex")
+    {
+        return filterAll(filter, "/orders/\\d+$/").matches;
+    };
+}
@@ -0,0 +1,84 @@
+// clang-format off
+
+#include "../../src/core/LogRecordIndex.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // What filtering looked like without an index: read everything and parse every line
+    qsizetype scanAll(const QString& path, LogLevel minimum)
+    {
+        SegmentedLog log(path);
+        log.load();
+
+        LogRecordParser parser;
+        qsizetype lines = 0;
+        const QByteArray text = log.read(log.startOffset(), log.endOffset() - log.startOffset());
+        for (qsizetype position = 0; position < text.size();)
+        {
+            qsizetype newline = text.indexOf('\n', position);
+            if (newline < 0)
+                newline = text.size();
+            if (parser.parse(text.constData() + position, newline - position).level >= minimum)
+                ++lines;
+            position = newline + 1;
+        }
+        return lines;
+    }
+}
+
+TEST_CASE("Log record index: warnings in 64 MB", "[.][benchmark][logRecordIndex]")
+{
+    constexpr qint64 TotalBytes = 64LL * 1024 * 1024;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    {
+        SegmentedLog log(dir.path(), SegmentedLog::MaxSegmentBytes, TotalBytes * 2);
+        REQUIRE(log.openForAppend());
+
+        QByteArray block;
+        for (int i = 0; block.size() < 1024 * 1024; ++i)
+        {
+            const QByteArray time = QByteArray::asprintf("2024-05-01T12:%02d:%02d.%03dZ", i / 60000 % 60,
+                                                         i / 1000 % 60, i % 1000);
+            if (i % 500 == 0)
+                block += time + " WARN proxy - upstream slow: " + QByteArray::number(i) + " ms\n";
+            else
+                block += time + " INFO http - GET /api/items/" + QByteArray::number(i) + " 200\n";
+        }
+        for (qint64 written = 0; written < TotalBytes; written += block.size())
+            log.append(block);
+    }
+
+    LogRecordIndex index(dir.path());
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const qint64 indexed = index.update();
+    const qint64 indexMs = elapsed.elapsed();
+
+    elapsed.restart();
+    const qsizetype filtered = index.filter(LogLevel::Warning).size();
+    const qint64 filterMs = elapsed.elapsed();
+
+    elapsed.restart();
+    const qsizetype scanned = scanAll(dir.path(), LogLevel::Warning);
+    const qint64 scanMs = elapsed.elapsed();
+
+    WARN("indexed " << indexed << " lines in " << indexMs << " ms; " << filtered << " warnings in " << filterMs
+                    << " ms with the index, " << scanMs << " ms parsing everything");
+    CHECK(filtered == scanned);
+
+    BENCHMARK("indexed filter")
+    {
+        return index.filter(LogLevel::Warning).size();
+    };
+
+    BENCHMARK("full parse")
+    {
+        return scanAll(dir.path(), LogLevel::Warning);
+    };
+}
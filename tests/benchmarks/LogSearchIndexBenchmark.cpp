@@ -0,0 +1,82 @@
+// clang-format off
+
+#include "../../src/core/LogSearchIndex.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // What searching looked like without an index: read everything and look at every line
+    qsizetype scanAll(const QString& path, const QByteArray& query)
+    {
+        SegmentedLog log(path);
+        log.load();
+
+        constexpr qint64 ChunkBytes = 4 * 1024 * 1024;
+        qsizetype hits = 0;
+        const QByteArray needle = query.toLower();
+        for (qint64 offset = log.startOffset(); offset < log.endOffset(); offset += ChunkBytes)
+        {
+            // Chunks overlap by a query length, matches starting in the overlap belong to the next one
+            const QByteArray chunk = log.read(offset, ChunkBytes + needle.size() - 1).toLower();
+            qsizetype position = chunk.indexOf(needle);
+            for (; position >= 0 && position < ChunkBytes; position = chunk.indexOf(needle, position + 1))
+                ++hits;
+        }
+        return hits;
+    }
+}
+
+TEST_CASE("Log search index: rare term in 256 MB", "[.][benchmark][logSearchIndex]")
+{
+    constexpr qint64 TotalBytes = 256LL * 1024 * 1024;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    {
+        SegmentedLog log(dir.path(), SegmentedLog::MaxSegmentBytes, TotalBytes * 2);
+        REQUIRE(log.openForAppend());
+
+        QByteArray block;
+        for (int i = 0; block.size() < 1024 * 1024; ++i)
+            block += "\x1b[32m[dev]\x1b[0m GET /api/items/" + QByteArray::number(i) + " 200 in 3ms\n";
+        qint64 written = 0;
+        for (int i = 0; written < TotalBytes; ++i)
+        {
+            log.append(block);
+            written += block.size();
+            if (i % 50 == 0)
+                log.append("Unhandled rejection: ECONNRESET while proxying /api/orders/" + QByteArray::number(i) + "\n");
+        }
+    }
+
+    LogSearchIndex index(dir.path());
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const qint64 indexed = index.update();
+    const qint64 indexMs = elapsed.elapsed();
+
+    elapsed.restart();
+    const qsizetype indexedHits = index.search("econnreset").size();
+    const qint64 searchMs = elapsed.elapsed();
+
+    elapsed.restart();
+    const qsizetype scannedHits = scanAll(dir.path(), "econnreset");
+    const qint64 scanMs = elapsed.elapsed();
+
+    WARN("indexed " << indexed / (1024 * 1024) << " MB in " << indexMs << " ms; " << indexedHits << " hits in "
+                    << searchMs << " ms with the index, " << scanMs << " ms scanning everything");
+    CHECK(indexedHits == scannedHits);
+
+    BENCHMARK("indexed search")
+    {
+        return index.search("econnreset").size();
+    };
+
+    BENCHMARK("full scan")
+    {
+        return scanAll(dir.path(), "econnreset");
+    };
+}
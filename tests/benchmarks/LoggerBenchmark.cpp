@@ -0,0 +1,86 @@
+// clang-format off
+
+// Measures INFO calls whatever the build type
+#define LOGGER_MIN_LEVEL 0
+
+#include "../../src/core/Logger.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Logs messagesPerThread messages from each thread and waits until all of them are written
+    void logFromThreads(int threadCount, int messagesPerThread)
+    {
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < threadCount; ++thread)
+        {
+            threads.emplace_back([thread, messagesPerThread]()
+            {
+                for (int i = 0; i < messagesPerThread; ++i)
+                    LOG_INFO(QString("Loaded project %1 from thread %2").arg(i).arg(thread));
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        Logger::flush();
+    }
+}
+
+TEST_CASE("Logger: calls per second from several threads", "[.][benchmark][logger]")
+{
+    constexpr int MessagesPerThread = 100000;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    REQUIRE(Logger::open(dir.filePath("benchmark.log")));
+
+    for (int threadCount : {1, 4, 8})
+    {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        logFromThreads(threadCount, MessagesPerThread);
+        const qint64 ms = qMax<qint64>(elapsed.elapsed(), 1);
+        WARN(threadCount << " threads: " << qint64(threadCount) * MessagesPerThread * 1000 / ms
+                         << " calls per second, written in " << ms << " ms");
+    }
+
+    BENCHMARK("10000 calls from 4 threads")
+    {
+        logFromThreads(4, 2500);
+    };
+
+    Logger::shutdown();
+}
+
+TEST_CASE("Logger: cost of a call below the minimum level", "[.][benchmark][logger]")
+{
+    constexpr int Calls = 10000000;
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    REQUIRE(Logger::open(dir.filePath("benchmark.log")));
+    Logger::setMinimumLevel(Logger::Category::Database, Logger::Level::Warning);
+
+    // The message is never built, so this measures the level check alone
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int i = 0; i < Calls; ++i)
+        LOG_INFO_IN(Database, "Found " + QString::number(i) + " processes for project ID: " + QString::number(i));
+    const qint64 ns = qMax<qint64>(elapsed.nsecsElapsed(), 1);
+    WARN(Calls << " disabled calls in " << ns / 1000000 << " ms, " << double(ns) / Calls << " ns per call");
+
+    BENCHMARK("1000 disabled calls")
+    {
+        for (int i = 0; i < 1000; ++i)
+            LOG_INFO_IN(Database, "Found " + QString::number(i) + " processes");
+        return Logger::isEnabled(Logger::Level::Info, Logger::Category::Database);
+    };
+
+    Logger::flush();
+    Logger::shutdown();
+}
@@ -0,0 +1,72 @@
+// clang-format off
+
+#include "../../src/core/MergedLog.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    constexpr int ProcessCount = 10;
+
+    // Lines of every process stamped a millisecond apart, interleaved with the others
+    void writeLines(const QTemporaryDir& dir, int first, int count)
+    {
+        for (int process = 0; process < ProcessCount; ++process)
+        {
+            SegmentedLog log(dir.filePath(QString::number(process)));
+            REQUIRE(log.openForAppend());
+            QByteArray chunk;
+            QList<LogStamp> stamps;
+            const qint64 start = log.endOffset();
+            for (int i = first; i < first + count; ++i)
+            {
+                stamps.append({start + chunk.size(), qint64(i) * ProcessCount + process});
+                chunk += "[worker " + QByteArray::number(process) + "] processed job " + QByteArray::number(i) + "\n";
+            }
+            log.append(chunk);
+            REQUIRE(LogTimeline::append(log, stamps));
+        }
+    }
+}
+
+TEST_CASE("Merged log: tailing ten processes", "[.][benchmark][mergedLog]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    writeLines(dir, 0, 200000);
+
+    MergedLog merged;
+    for (int process = 0; process < ProcessCount; ++process)
+        merged.addSource(dir.filePath(QString::number(process)), QString("worker %1").arg(process), Qt::cyan);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    merged.refresh();
+    const qint64 openMs = elapsed.elapsed();
+
+    elapsed.restart();
+    writeLines(dir, 200000, 100);
+    const qint64 writeMs = elapsed.elapsed();
+    elapsed.restart();
+    merged.refresh();
+    const qint64 refreshMs = elapsed.elapsed();
+
+    WARN(merged.rowCount() << " rows; opened in " << openMs << " ms, 1000 new lines merged in " << refreshMs
+                           << " ms (" << writeMs << " ms writing them)");
+    CHECK(merged.rowCount() == ProcessCount * (MergedLog::TailLines + 100));
+
+    int next = 200100;
+    BENCHMARK("refresh with 1000 new lines")
+    {
+        writeLines(dir, next, 100);
+        next += 100;
+        return merged.refresh();
+    };
+
+    BENCHMARK("merge 1000 older rows")
+    {
+        return merged.mergeOlder();
+    };
+}
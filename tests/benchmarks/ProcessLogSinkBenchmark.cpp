@@ -0,0 +1,78 @@
+// clang-format off
+
+#include "../../src/core/ProcessLogSink.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // A dev server line as webpack prints it, delivered in small readyRead chunks
+    constexpr int ChunkCount = 20000;
+    const QByteArray Chunk = "\x1b[32m[webpack-dev-server]\x1b[0m asset main.js 1.2 MiB [emitted] (name: main)\n";
+
+    // The previous readyReadStandardOutput handler: open, decode, write and close per chunk
+    void writeLegacy(const QString& path, const QByteArray& chunk)
+    {
+        QFile logFile(path);
+        if (logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        {
+            QTextStream out(&logFile);
+            out << QString::fromUtf8(chunk);
+        }
+    }
+
+    double megabytesPerSecond(qint64 bytes, qint64 nanoseconds)
+    {
+        return (bytes / (1024.0 * 1024.0)) / (nanoseconds / 1e9);
+    }
+}
+
+TEST_CASE("Process log sink: throughput against open-per-chunk", "[.][benchmark][processLogSink]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const qint64 totalBytes = qint64(ChunkCount) * Chunk.size();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int i = 0; i < ChunkCount; ++i)
+    {
+        writeLegacy(dir.filePath("legacy.log"), Chunk);
+    }
+    const double legacy = megabytesPerSecond(totalBytes, elapsed.nsecsElapsed());
+
+    elapsed.restart();
+    {
+        ProcessLogSink sink(dir.filePath("sink"));
+        REQUIRE(sink.open());
+        for (int i = 0; i < ChunkCount; ++i)
+        {
+            sink.write(Chunk);
+        }
+    }
+    const double buffered = megabytesPerSecond(totalBytes, elapsed.nsecsElapsed());
+
+    WARN("open-per-chunk: " << legacy << " MB/s, log sink: " << buffered << " MB/s");
+    SegmentedLog written(dir.filePath("sink"));
+    written.load();
+    CHECK(written.endOffset() == totalBytes);
+    CHECK(buffered > legacy);
+
+    BENCHMARK("open-per-chunk (1000 chunks)")
+    {
+        for (int i = 0; i < 1000; ++i)
+            writeLegacy(dir.filePath("legacy.log"), Chunk);
+    };
+
+    ProcessLogSink sink(dir.filePath("sink"));
+    REQUIRE(sink.open());
+    BENCHMARK("log sink (1000 chunks)")
+    {
+        for (int i = 0; i < 1000; ++i)
+            sink.write(Chunk);
+    };
+}
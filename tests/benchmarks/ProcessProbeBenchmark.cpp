@@ -0,0 +1,70 @@
+// clang-format off
+
+#include "../../src/core/ProcessProbe.h"
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QProcess>
+#include <QTcpServer>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(Q_OS_LINUX)
+
+// Equivalent of the previous per-probe shell-out: fork a tool and parse its text output
+static bool shellIsProcessRunning(int pid)
+{
+    QProcess ps;
+    ps.start("ps", {"-p", QString::number(pid)});
+    ps.waitForFinished();
+    return QString(ps.readAllStandardOutput()).contains(QString::number(pid));
+}
+
+static int shellFindPidByPort(int port)
+{
+    QProcess netstat;
+    netstat.start("sh", {"-c", QString("netstat -ltnp 2>/dev/null | grep :%1").arg(port)});
+    netstat.waitForFinished();
+
+    QString output = netstat.readAllStandardOutput();
+    int slash = output.indexOf('/');
+    if (slash < 0)
+        return 0;
+
+    int start = output.lastIndexOf(' ', slash) + 1;
+    return output.mid(start, slash - start).toInt();
+}
+
+TEST_CASE("Process probe: native vs shell-out", "[.][benchmark][processProbe]")
+{
+    QTcpServer server;
+    REQUIRE(server.listen(QHostAddress::LocalHost, 0));
+    const int port = server.serverPort();
+    const int pid = static_cast<int>(QCoreApplication::applicationPid());
+
+    BENCHMARK("isProcessRunning (kill)")
+    {
+        return ProcessProbe::isProcessRunning(pid);
+    };
+
+    BENCHMARK("isProcessRunning (ps)")
+    {
+        return shellIsProcessRunning(pid);
+    };
+
+    BENCHMARK("findPidByPort (/proc)")
+    {
+        return ProcessProbe::findPidByPort(port);
+    };
+
+    BENCHMARK("findPidByPort (netstat)")
+    {
+        return shellFindPidByPort(port);
+    };
+
+    BENCHMARK("listeningPorts (/proc, all ports)")
+    {
+        return ProcessProbe::listeningPorts();
+    };
+}
+
+#endif
@@ -0,0 +1,55 @@
+// clang-format off
+
+#include "../../src/core/ResourceSampler.h"
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QThread>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(Q_OS_LINUX)
+#include <csignal>
+#endif
+
+#if defined(Q_OS_LINUX)
+
+TEST_CASE("Resource sampler: 50-process tree", "[.][benchmark][resourceSampler]")
+{
+    constexpr int TreeSize = 50;
+
+    // A shell with 49 sleeping children, like a dev server with workers
+    QProcess shell;
+    shell.start("/bin/sh", {"-c", QString("for i in $(seq %1); do sleep 60 & done; wait").arg(TreeSize - 1)});
+    REQUIRE(shell.waitForStarted());
+    const int rootPid = static_cast<int>(shell.processId());
+
+    QHash<int, ResourceSampler::Counters> previous;
+    ResourceSample sample;
+    for (int attempt = 0; attempt < 200 && sample.processCount < TreeSize; ++attempt)
+    {
+        QThread::msleep(10);
+        sample = ResourceSampler::sampleTree(rootPid, previous);
+    }
+    REQUIRE(sample.processCount == TreeSize);
+
+    BENCHMARK("sampleTree (50 processes)")
+    {
+        return ResourceSampler::sampleTree(rootPid, previous);
+    };
+
+    // At one sample per second, 1% of a core leaves 10 ms per sample
+    constexpr int Samples = 50;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int i = 0; i < Samples; ++i)
+    {
+        ResourceSampler::sampleTree(rootPid, previous);
+    }
+    CHECK(elapsed.nsecsElapsed() / Samples < 10'000'000);
+
+    for (int pid : previous.keys())
+        ::kill(pid, SIGKILL);
+    shell.waitForFinished();
+}
+
+#endif
@@ -0,0 +1,111 @@
+// clang-format off
+
+#include "../../src/components/home/ProcessListItem.h"
+#include "../../src/core/ProcessSupervisor.h"
+#include "../../src/repositories/ProcessRepository.h"
+#include "../../src/repositories/ProcessStatusWriter.h"
+#include "../helpers/TestHelpers.h"
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QSignalSpy>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTimer>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+
+struct ProcessListItemFixture
+{
+    QSqlDatabase db;
+    std::unique_ptr<ProcessRepository> repository;
+
+    ProcessListItemFixture()
+    {
+        db = QSqlDatabase::addDatabase("QSQLITE", "process_list_item_test_connection");
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+
+        QSqlQuery query(db);
+        bool success = query.exec(R"(
+            CREATE TABLE IF NOT EXISTS processes (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                project_id INTEGER NOT NULL,
+                name TEXT NOT NULL,
+                command TEXT NOT NULL,
+                working_directory TEXT NOT NULL,
+                status TEXT NOT NULL DEFAULT 'stopped',
+                pid INTEGER,
+                port INTEGER,
+                log_path TEXT,
+                last_started_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+                uptime DATETIME,
+                created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+                updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
+            )
+        )");
+        REQUIRE(success);
+
+        repository = std::make_unique<ProcessRepository>(db);
+    }
+
+    ~ProcessListItemFixture()
+    {
+        repository.reset();
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase("process_list_item_test_connection");
+    }
+};
+
+#if defined(Q_OS_UNIX)
+TEST_CASE_METHOD(ProcessListItemFixture, "Stopping a process that ignores SIGTERM keeps the GUI responsive",
+                 "[components][processListItem][latency]")
+{
+    ARRANGE(
+        // Ignoring SIGTERM forces the full stop deadline before SIGKILL
+        QProcess child;
+        ProcessSupervisor::instance().trackLaunch(&child);
+        child.start("sh", {"-c", "trap '' TERM; exec sleep 30"});
+        REQUIRE(child.waitForStarted());
+
+        Process process;
+        process.setProjectId(1);
+        process.setName("Stubborn");
+        process.setCommand("sleep 30");
+        process.setWorkingDirectory("/tmp");
+        process.setStatus(Process::Status::Running);
+        process.setPID(static_cast<int>(child.processId()));
+        auto saved = repository->save(process);
+        REQUIRE(saved.has_value());
+
+        ProcessStatusWriter statusWriter(*repository);
+        ProcessListItem item(*saved, statusWriter);
+        QSignalSpy stopSpy(&ProcessSupervisor::instance(), &ProcessSupervisor::stopFinished);
+
+        // Heartbeat on the GUI thread; any blocking call shows up as a large gap between ticks
+        qint64 maxGapMs = 0;
+        QElapsedTimer sinceLastTick;
+        QTimer heartbeat;
+        heartbeat.setInterval(10);
+        QObject::connect(&heartbeat, &QTimer::timeout, [&]()
+        {
+            maxGapMs = std::max(maxGapMs, sinceLastTick.restart());
+        });
+    )
+
+    ACT(
+        sinceLastTick.start();
+        heartbeat.start();
+        item.getStopButton()->click();
+        bool stopped = stopSpy.wait(ProcessSupervisor::StopTimeoutMs * 3);
+        heartbeat.stop();
+    )
+
+    ASSERT(
+        REQUIRE(stopped);
+        CHECK(item.getProcess().getStatus() == Process::Status::Stopped);
+        CHECK(maxGapMs < 250);
+        CHECK(child.waitForFinished(1000));
+    )
+}
+#endif
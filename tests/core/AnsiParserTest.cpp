@@ -0,0 +1,165 @@
+// clang-format off
+
+#include "../../src/core/AnsiHtmlConverter.h"
+#include "../../src/core/AnsiParser.h"
+#include "../helpers/TestHelpers.h"
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("ANSI parser splits a line into styled spans", "[core][ansiParser]")
+{
+    ARRANGE(
+        QByteArray line = "\x1b[1;32mready\x1b[0m in 120ms";
+    )
+
+    ACT(
+        QList<AnsiSpan> spans = AnsiParser::parseLine(line);
+    )
+
+    ASSERT(
+        REQUIRE(spans.size() == 2);
+        CHECK(spans[0].text == "ready");
+        CHECK(spans[0].style.foreground == QColor("green"));
+        CHECK(spans[0].style.bold);
+        CHECK(spans[1].text == " in 120ms");
+        CHECK_FALSE(spans[1].style.foreground.isValid());
+        CHECK_FALSE(spans[1].style.bold);
+    )
+}
+
+TEST_CASE("ANSI parser drops escape sequences that are not SGR", "[core][ansiParser]")
+{
+    ARRANGE(
+        QByteArray line = "\x1b[2K\x1b[1Gbuilding \x1b[m50%";
+    )
+
+    ACT(
+        QString text = AnsiParser::plainText(line);
+    )
+
+    ASSERT(
+        CHECK(text == "building 50%");
+    )
+}
+
+TEST_CASE("ANSI parser resets individual attributes", "[core][ansiParser]")
+{
+    ARRANGE(
+        AnsiStyle style;
+    )
+
+    ACT(
+        AnsiParser::applySgr("1;3;91;44", style);
+        AnsiStyle styled = style;
+        AnsiParser::applySgr("22;39", style);
+    )
+
+    ASSERT(
+        CHECK(styled.bold);
+        CHECK(styled.italic);
+        CHECK(styled.foreground == QColor("lightcoral"));
+        CHECK(styled.background == QColor("blue"));
+        CHECK_FALSE(style.bold);
+        CHECK(style.italic);
+        CHECK_FALSE(style.foreground.isValid());
+        CHECK(style.background == QColor("blue"));
+    )
+}
+
+TEST_CASE("ANSI parser gives URLs their own spans", "[core][ansiParser]")
+{
+    ARRANGE(
+        QByteArray line = "Local: http://localhost:5173/ (ready)";
+    )
+
+    ACT(
+        QList<AnsiSpan> spans = AnsiParser::parseLine(line);
+    )
+
+    ASSERT(
+        REQUIRE(spans.size() == 3);
+        CHECK(spans[1].text == "http://localhost:5173/");
+        CHECK(spans[1].link == "http://localhost:5173/");
+        CHECK(spans[2].link.isEmpty());
+    )
+}
+
+TEST_CASE("ANSI parser reads 256-color and 24-bit colors", "[core][ansiParser]")
+{
+    ARRANGE(
+        AnsiStyle style;
+    )
+
+    ACT(
+        AnsiParser::applySgr("38;5;208;48;2;10;20;30", style);
+        AnsiStyle colon;
+        AnsiParser::applySgr("38:2:1:2:3", colon);
+    )
+
+    ASSERT(
+        CHECK(style.foreground == QColor(255, 135, 0));
+        CHECK(style.background == QColor(10, 20, 30));
+        CHECK(colon.foreground == QColor(1, 2, 3));
+        CHECK(AnsiParser::paletteColor(244) == QColor(128, 128, 128));
+    )
+}
+
+TEST_CASE("ANSI parser carries style and cut-off sequences across chunks", "[core][ansiParser]")
+{
+    ARRANGE(
+        AnsiParser parser;
+        QByteArray euro = "\xe2\x82\xac";
+    )
+
+    ACT(
+        QList<AnsiSpan> first = parser.feed(QByteArray("price: \x1b[3"));
+        QList<AnsiSpan> second = parser.feed(QByteArray("1m10 ") + euro.left(1));
+        QList<AnsiSpan> third = parser.feed(euro.mid(1) + "\nnext line");
+    )
+
+    ASSERT(
+        REQUIRE(first.size() == 1);
+        CHECK(first[0].text == "price: ");
+        REQUIRE(second.size() == 1);
+        CHECK(second[0].text == "10 ");
+        CHECK(second[0].style.foreground == QColor("red"));
+        REQUIRE(third.size() == 1);
+        CHECK(third[0].text == QString::fromUtf8("\xe2\x82\xac\nnext line"));
+        CHECK(third[0].style.foreground == QColor("red"));
+    )
+}
+
+TEST_CASE("ANSI parser skips text but keeps its style changes", "[core][ansiParser]")
+{
+    ARRANGE(
+        AnsiParser parser;
+        QByteArray skipped = "\x1b[1mhidden\x1b[34m";
+    )
+
+    ACT(
+        parser.skip(skipped.constData(), skipped.size());
+        QList<AnsiSpan> spans = parser.feed(QByteArray("shown"));
+    )
+
+    ASSERT(
+        REQUIRE(spans.size() == 1);
+        CHECK(spans[0].style.bold);
+        CHECK(spans[0].style.foreground == QColor("blue"));
+    )
+}
+
+TEST_CASE("HTML converter keeps colors across chunks", "[core][ansiParser]")
+{
+    ARRANGE(
+        AnsiHtmlConverter converter;
+    )
+
+    ACT(
+        QString first = converter.convert("\x1b[31merror: <tag>\n");
+        QString second = converter.convert("still red\x1b[0m done");
+    )
+
+    ASSERT(
+        CHECK(first == "<span style=\"color:#ff0000;\">error: &lt;tag&gt;<br></span>");
+        CHECK(second == "<span style=\"color:#ff0000;\">still red</span> done");
+    )
+}
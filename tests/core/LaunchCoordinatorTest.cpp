@@ -0,0 +1,164 @@
+// clang-format off
+
+#include "../../src/core/LaunchCoordinator.h"
+#include "../helpers/TestHelpers.h"
+#include <QSignalSpy>
+#include <catch2/catch_test_macros.hpp>
+
+using DependencyMap = QHash<int, QList<int>>;
+
+namespace
+{
+    // db and cache have no dependencies; api needs both; worker needs db;
+    // frontend needs api; proxy needs api and frontend
+    enum Service { Db = 1, Cache, Api, Worker, Frontend, Proxy };
+
+    const QList<int> Stack = {Db, Cache, Api, Worker, Frontend, Proxy};
+    const DependencyMap StackDependencies = {
+        {Api, {Db, Cache}},
+        {Worker, {Db}},
+        {Frontend, {Api}},
+        {Proxy, {Api, Frontend}},
+    };
+}
+
+TEST_CASE("Independent processes start together", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+    )
+
+    ACT(
+        bool launched = coordinator.launch(Stack, StackDependencies);
+    )
+
+    ASSERT(
+        REQUIRE(launched);
+        CHECK(coordinator.isLaunching());
+        CHECK(QSet<int>(started.cbegin(), started.cend()) == QSet<int>({Db, Cache}));
+    )
+}
+
+TEST_CASE("Processes start as soon as their dependencies are ready", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+        QSignalSpy finishedSpy(&coordinator, &LaunchCoordinator::finished);
+        coordinator.launch(Stack, StackDependencies);
+    )
+
+    ACT(
+        coordinator.markReady(Db);
+        bool workerAfterDb = started.contains(Worker) && !started.contains(Api);
+
+        coordinator.markReady(Cache);
+        bool apiAfterCache = started.contains(Api);
+
+        coordinator.markReady(Api);
+        coordinator.markReady(Worker);
+        coordinator.markReady(Frontend);
+        coordinator.markReady(Proxy);
+    )
+
+    ASSERT(
+        CHECK(workerAfterDb);
+        CHECK(apiAfterCache);
+        CHECK(started.size() == Stack.size());
+        CHECK(started.indexOf(Frontend) < started.indexOf(Proxy));
+        REQUIRE(finishedSpy.count() == 1);
+        CHECK(finishedSpy.first().at(0).toBool());
+        CHECK_FALSE(coordinator.isLaunching());
+    )
+}
+
+TEST_CASE("A failed process skips everything that depends on it", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+        QSignalSpy skippedSpy(&coordinator, &LaunchCoordinator::processSkipped);
+        QSignalSpy finishedSpy(&coordinator, &LaunchCoordinator::finished);
+        coordinator.launch(Stack, StackDependencies);
+    )
+
+    ACT(
+        coordinator.markReady(Db);
+        coordinator.markFailed(Cache);
+        coordinator.markReady(Worker);
+    )
+
+    ASSERT(
+        CHECK(skippedSpy.count() == 3);
+        CHECK_FALSE(started.contains(Api));
+        CHECK_FALSE(started.contains(Proxy));
+        REQUIRE(finishedSpy.count() == 1);
+        CHECK_FALSE(finishedSpy.first().at(0).toBool());
+    )
+}
+
+TEST_CASE("Running processes count as ready and are not started again", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+    )
+
+    ACT(
+        coordinator.launch(Stack, StackDependencies, {Db, Cache});
+    )
+
+    ASSERT(
+        CHECK(QSet<int>(started.cbegin(), started.cend()) == QSet<int>({Api, Worker}));
+    )
+}
+
+TEST_CASE("A dependency cycle is rejected before anything starts", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+        DependencyMap dependencies = StackDependencies;
+        dependencies.insert(Db, {Proxy});
+    )
+
+    ACT(
+        bool launched = coordinator.launch(Stack, dependencies);
+    )
+
+    ASSERT(
+        CHECK_FALSE(launched);
+        CHECK(started.isEmpty());
+        CHECK(LaunchCoordinator::hasCycle(Stack, dependencies));
+        CHECK_FALSE(LaunchCoordinator::hasCycle(Stack, StackDependencies));
+    )
+}
+
+TEST_CASE("A cancelled launch starts nothing more and accepts a new one", "[core][launchCoordinator]")
+{
+    ARRANGE(
+        QList<int> started;
+        LaunchCoordinator coordinator([&started](int processId) { started.append(processId); });
+        QSignalSpy finishedSpy(&coordinator, &LaunchCoordinator::finished);
+        coordinator.launch(Stack, StackDependencies);
+    )
+
+    ACT(
+        coordinator.cancel();
+        bool launchingAfterCancel = coordinator.isLaunching();
+        coordinator.markReady(Db);
+        coordinator.markReady(Cache);
+        QList<int> startedAfterCancel = started;
+        started.clear();
+        bool relaunched = coordinator.launch(Stack, StackDependencies);
+    )
+
+    ASSERT(
+        CHECK_FALSE(launchingAfterCancel);
+        CHECK(QSet<int>(startedAfterCancel.cbegin(), startedAfterCancel.cend()) == QSet<int>({Db, Cache}));
+        CHECK(finishedSpy.isEmpty());
+        REQUIRE(relaunched);
+        CHECK(QSet<int>(started.cbegin(), started.cend()) == QSet<int>({Db, Cache}));
+    )
+}
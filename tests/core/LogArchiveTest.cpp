@@ -0,0 +1,78 @@
+// clang-format off
+
+#include "../../src/core/LogArchive.h"
+#include "../helpers/TestHelpers.h"
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    QByteArray writeSegment(const QString& path, int lines)
+    {
+        QByteArray text;
+        for (int i = 0; i < lines; ++i)
+            text += "2024-05-01 12:00:00 INFO http - GET /api/items/" + QByteArray::number(i) + " 200 in 3ms\n";
+
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        REQUIRE(file.write(text) == text.size());
+        return text;
+    }
+}
+
+TEST_CASE("Log archive reads back any range", "[core][logArchive]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QByteArray text = writeSegment(dir.filePath("segment.log"), 10000);
+        REQUIRE(LogArchive::write(dir.filePath("segment.log"), dir.filePath("segment.logz"), 42));
+        LogArchive archive(dir.filePath("segment.logz"));
+    )
+
+    ACT(
+        bool opened = archive.open();
+        QByteArray start = archive.read(0, 100);
+        QByteArray acrossBlocks = archive.read(LogArchive::BlockBytes - 50, 100);
+        QByteArray end = archive.read(text.size() - 30, 100);
+        QByteArray everything = archive.read(0, text.size());
+        qint64 available = 0;
+        const char* data = archive.dataAt(LogArchive::BlockBytes + 10, available);
+    )
+
+    ASSERT(
+        REQUIRE(opened);
+        CHECK(archive.size() == text.size());
+        CHECK(archive.fileId() == 42);
+        CHECK(start == text.mid(0, 100));
+        CHECK(acrossBlocks == text.mid(LogArchive::BlockBytes - 50, 100));
+        CHECK(end == text.right(30));
+        CHECK(everything == text);
+        CHECK(available == LogArchive::BlockBytes - 10);
+        CHECK(QByteArray(data, 5) == text.mid(LogArchive::BlockBytes + 10, 5));
+        CHECK(QFileInfo(dir.filePath("segment.logz")).size() * 5 < text.size());
+    )
+}
+
+TEST_CASE("Log archive refuses damaged files", "[core][logArchive]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeSegment(dir.filePath("segment.log"), 5000);
+        REQUIRE(LogArchive::write(dir.filePath("segment.log"), dir.filePath("segment.logz"), 1));
+        REQUIRE(QFile::resize(dir.filePath("segment.logz"), QFileInfo(dir.filePath("segment.logz")).size() - 1));
+        LogArchive truncated(dir.filePath("segment.logz"));
+        LogArchive plain(dir.filePath("segment.log"));
+    )
+
+    ACT(
+        bool truncatedOpened = truncated.open();
+        bool plainOpened = plain.open();
+    )
+
+    ASSERT(
+        CHECK_FALSE(truncatedOpened);
+        CHECK_FALSE(plainOpened);
+        CHECK(truncated.read(0, 10).isEmpty());
+    )
+}
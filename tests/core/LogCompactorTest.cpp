@@ -0,0 +1,139 @@
+// clang-format off
+
+#include "../../src/core/LogCompactor.h"
+#include "../helpers/TestHelpers.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    QByteArray repeatMarker(int count)
+    {
+        return "\x1b[2m(\xc3\x97" + QByteArray::number(count) + ")\x1b[0m\n";
+    }
+}
+
+TEST_CASE("Compactor keeps the last frame of a redrawn line", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+    )
+
+    ACT(
+        const QByteArray output = compactor.compact("building 10%\rbuilding 50%\rbuilding 100%\ndone\n");
+    )
+
+    ASSERT(
+        CHECK(output == "building 100%\ndone\n");
+    )
+}
+
+TEST_CASE("Compactor keeps CRLF line endings, also split across chunks", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+    )
+
+    ACT(
+        const QByteArray whole = compactor.compact("one\r\ntwo\r\n");
+        const QByteArray firstPart = compactor.compact("three\r");
+        const QByteArray secondPart = compactor.compact("\nfour\n");
+    )
+
+    ASSERT(
+        CHECK(whole == "one\r\ntwo\r\n");
+        CHECK(firstPart.isEmpty());
+        CHECK(secondPart == "three\r\nfour\n");
+    )
+}
+
+TEST_CASE("Compactor redraws a line across chunks", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+    )
+
+    ACT(
+        const QByteArray first = compactor.compact("50%\r");
+        const QByteArray second = compactor.compact("75%\r100%\n");
+    )
+
+    ASSERT(
+        CHECK(first.isEmpty());
+        CHECK(second == "100%\n");
+    )
+}
+
+TEST_CASE("Compactor counts repeated lines", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+    )
+
+    ACT(
+        const QByteArray output = compactor.compact("warn: slow\nwarn: slow\nwarn: slow\nok\n\n\nok\n");
+    )
+
+    ASSERT(
+        CHECK(output == "warn: slow\n" + repeatMarker(3) + "ok\n\n\nok\n");
+    )
+}
+
+TEST_CASE("Compactor flush writes the count of a run in progress", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+        REQUIRE(compactor.compact("warn\nwarn\n") == "warn\n");
+    )
+
+    ACT(
+        const QByteArray flushed = compactor.flush();
+        const QByteArray after = compactor.compact("warn\n");
+    )
+
+    ASSERT(
+        CHECK(flushed == repeatMarker(2));
+        CHECK(after == "warn\n");
+        CHECK(compactor.flush().isEmpty());
+    )
+}
+
+TEST_CASE("Compactor flush writes an unterminated line", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+        REQUIRE(compactor.compact("Password: ").isEmpty());
+    )
+
+    ACT(
+        const QByteArray prompt = compactor.flush();
+        const QByteArray rest = compactor.compact("accepted\n");
+        compactor.compact("10%");
+        const QByteArray frame = compactor.flush();
+        const QByteArray redrawn = compactor.compact("\r20%\r30%\n");
+    )
+
+    ASSERT(
+        CHECK(prompt == "Password: ");
+        CHECK(rest == "accepted\n");
+        CHECK(frame == "10%");
+        CHECK(redrawn == "\n30%\n");
+    )
+}
+
+TEST_CASE("Compactor writes overlong lines as they are", "[core][logCompactor]")
+{
+    ARRANGE(
+        LogCompactor compactor;
+        const QByteArray longLine(LogCompactor::MaxLineBytes + 1, 'x');
+    )
+
+    ACT(
+        const QByteArray output = compactor.compact(longLine);
+        const QByteArray end = compactor.compact("\n");
+    )
+
+    ASSERT(
+        CHECK(output == longLine);
+        CHECK(end == "\n");
+    )
+}
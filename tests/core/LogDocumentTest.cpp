@@ -0,0 +1,314 @@
+// clang-format off
+
+#include "../../src/core/LogDocument.h"
+#include "../helpers/TestHelpers.h"
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    void writeLines(const QString& path, int first, int count, qint64 maxSegmentBytes)
+    {
+        SegmentedLog log(path, maxSegmentBytes, 1024 * 1024);
+        REQUIRE(log.openForAppend());
+        for (int i = first; i < first + count; ++i)
+            log.append("line " + QByteArray::number(i) + "\n");
+    }
+}
+
+TEST_CASE("Log document indexes lines across segments", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 200, 64);
+        LogDocument document(dir.path());
+    )
+
+    ACT(
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+        QList<QByteArray> lines = document.lines(130, 3);
+    )
+
+    ASSERT(
+        CHECK(document.lineCount() == 200);
+        CHECK_FALSE(document.isIndexing());
+        CHECK(lines == QList<QByteArray>({"line 130", "line 131", "line 132"}));
+        CHECK(document.lines(199, 10) == QList<QByteArray>({"line 199"}));
+    )
+}
+
+TEST_CASE("Log document indexes in bounded slices", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 100, 1024 * 1024);
+        LogDocument document(dir.path());
+        document.refresh();
+    )
+
+    ACT(
+        bool more = document.indexMore(50);
+        qint64 afterSlice = document.lineCount();
+        while (document.indexMore(50))
+        {
+        }
+    )
+
+    ASSERT(
+        CHECK(more);
+        CHECK(afterSlice < 10);
+        CHECK(document.lineCount() == 100);
+    )
+}
+
+TEST_CASE("Log document picks up appended output on refresh", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path());
+        REQUIRE(writer.openForAppend());
+        writer.append("first\nsecond with");
+        LogDocument document(dir.path());
+        document.refresh();
+        document.indexMore();
+    )
+
+    ACT(
+        qint64 before = document.lineCount();
+        writer.append("out newline yet\nthird\n");
+        document.refresh();
+        document.indexMore();
+    )
+
+    ASSERT(
+        CHECK(before == 1);
+        CHECK(document.lineCount() == 3);
+        CHECK(document.lines(1, 1) == QList<QByteArray>({"second without newline yet"}));
+    )
+}
+
+TEST_CASE("Log document starts over after the log was cleared", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 50, 64);
+        LogDocument document(dir.path());
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+    )
+
+    ACT(
+        REQUIRE(document.clear());
+        writeLines(dir.path(), 50, 2, 64);
+        document.refresh();
+        document.indexMore();
+    )
+
+    ASSERT(
+        CHECK(document.lineCount() == 2);
+        CHECK(document.lines(0, 2) == QList<QByteArray>({"line 50", "line 51"}));
+    )
+}
+
+TEST_CASE("Log document carries colors across checkpoints", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path());
+        REQUIRE(writer.openForAppend());
+        writer.append("\x1b[31mred from here\n");
+        for (int i = 0; i < 100; ++i)
+            writer.append("plain " + QByteArray::number(i) + "\n");
+        LogDocument document(dir.path());
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+    )
+
+    ACT(
+        AnsiStyle style;
+        QList<QByteArray> lines = document.lines(70, 1, &style);
+    )
+
+    ASSERT(
+        CHECK(lines == QList<QByteArray>({"plain 69"}));
+        CHECK(style.foreground == QColor(255, 0, 0));
+        CHECK(document.endStyle().foreground == QColor(255, 0, 0));
+    )
+}
+
+TEST_CASE("Log document opens on the tail and indexes older lines on demand", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 5000, 4096);
+        LogDocument document(dir.path());
+    )
+
+    ACT(
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+        qint64 tailLines = document.lineCount();
+        QList<QByteArray> tailFirst = document.lines(0, 1);
+
+        qint64 added = document.indexOlder(1000);
+        QList<QByteArray> olderFirst = document.lines(0, 1);
+
+        while (document.hasOlder())
+            document.indexOlder(1000);
+    )
+
+    ASSERT(
+        CHECK(tailLines == LogDocument::TailLines);
+        CHECK(tailFirst == QList<QByteArray>({"line 3000"}));
+        CHECK(added > 0);
+        CHECK(olderFirst == QList<QByteArray>({"line " + QByteArray::number(3000 - added)}));
+        CHECK(document.lineCount() == 5000);
+        CHECK(document.startOffset() == 0);
+        CHECK(document.lines(0, 2) == QList<QByteArray>({"line 0", "line 1"}));
+        CHECK(document.lines(2999, 2) == QList<QByteArray>({"line 2999", "line 3000"}));
+        CHECK(document.lines(4999, 1) == QList<QByteArray>({"line 4999"}));
+    )
+}
+
+TEST_CASE("Log document carries colors through older lines", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path());
+        REQUIRE(writer.openForAppend());
+        writer.append("\x1b[32mgreen from here\n");
+        for (int i = 0; i < LogDocument::TailLines + 200; ++i)
+            writer.append("plain " + QByteArray::number(i) + "\n");
+        LogDocument document(dir.path());
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+        while (document.hasOlder())
+            document.indexOlder();
+    )
+
+    ACT(
+        AnsiStyle style;
+        QList<QByteArray> lines = document.lines(130, 1, &style);
+    )
+
+    ASSERT(
+        CHECK(lines == QList<QByteArray>({"plain 129"}));
+        CHECK(style.foreground == QColor(0, 128, 0));
+    )
+}
+
+TEST_CASE("Log document finds the line of an offset", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 5000, 4096);
+        LogDocument document(dir.path());
+        document.refresh();
+        while (document.indexMore())
+        {
+        }
+        document.indexOlder(20000);
+
+        SegmentedLog log(dir.path());
+        log.load();
+        const QByteArray text = log.read(0, log.endOffset());
+        qint64 line2500 = text.indexOf("line 2500\n");
+        qint64 line4000 = text.indexOf("line 4000\n");
+    )
+
+    ACT(
+        qint64 olderRow = document.lineAt(line2500 + 3);
+        qint64 tailRow = document.lineAt(line4000);
+        qint64 notIndexed = document.lineAt(0);
+    )
+
+    ASSERT(
+        REQUIRE(olderRow >= 0);
+        CHECK(document.lines(olderRow, 1) == QList<QByteArray>({"line 2500"}));
+        CHECK(document.lines(tailRow, 1) == QList<QByteArray>({"line 4000"}));
+        CHECK(notIndexed == -1);
+    )
+}
+
+TEST_CASE("Log document starts over after a segment was truncated or replaced", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 100, 1024 * 1024);
+        LogDocument document(dir.path());
+        document.refresh();
+        document.indexMore();
+
+        SegmentedLog log(dir.path());
+        log.load();
+        const QString segmentPath = dir.filePath(log.segments().first().fileName);
+    )
+
+    ACT(
+        REQUIRE(QFile::resize(segmentPath, 20));
+        document.refresh();
+        document.indexMore();
+        qint64 truncatedLines = document.lineCount();
+
+        // Written next to the old file and renamed over it, as a log rotation tool would
+        QSaveFile replacement(segmentPath);
+        REQUIRE(replacement.open(QIODevice::WriteOnly));
+        replacement.write("replaced 0\nreplaced 1\nreplaced 2\n");
+        REQUIRE(replacement.commit());
+        document.refresh();
+        document.indexMore();
+    )
+
+    ASSERT(
+        CHECK(truncatedLines == 2);
+        CHECK(document.lineCount() == 3);
+        CHECK(document.lines(0, 1) == QList<QByteArray>({"replaced 0"}));
+    )
+}
+
+TEST_CASE("Log document reads archived segments", "[core][logDocument]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 30000, 128 * 1024);
+        LogDocument opened(dir.path());
+        opened.refresh();
+        while (opened.indexMore())
+        {
+        }
+    )
+
+    ACT(
+        int archived = SegmentedLog(dir.path()).archiveFinished();
+        opened.refresh();
+        LogDocument reopened(dir.path());
+        reopened.refresh();
+        while (reopened.indexMore())
+        {
+        }
+        while (reopened.hasOlder())
+            reopened.indexOlder();
+    )
+
+    ASSERT(
+        CHECK(archived == 2);
+        CHECK(opened.lineCount() == LogDocument::TailLines);
+        CHECK(opened.lines(0, 1) == QList<QByteArray>({"line 28000"}));
+        CHECK(reopened.lineCount() == 30000);
+        CHECK(reopened.lines(0, 2) == QList<QByteArray>({"line 0", "line 1"}));
+        CHECK(reopened.lines(15000, 1) == QList<QByteArray>({"line 15000"}));
+        CHECK(reopened.lines(29999, 1) == QList<QByteArray>({"line 29999"}));
+    )
+}
@@ -0,0 +1,149 @@
+// clang-format off
+
+#include "../../src/core/LogFilter.h"
+#include "../../src/core/LogLineMatcher.h"
+#include "../../src/core/SegmentedLog.h"
+#include "../helpers/LogTestHelpers.h"
+#include "../helpers/TestHelpers.h"
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+using LogTestHelpers::linesAt;
+using LogTestHelpers::writeLines;
+
+namespace
+{
+    bool matches(const QString& query, const QByteArray& line)
+    {
+        return LogLineMatcher(query).matches(line.constData(), line.size());
+    }
+
+    QList<qint64> collect(QSignalSpy& matchesSpy)
+    {
+        QList<qint64> offsets;
+        for (const QList<QVariant>& arguments : matchesSpy)
+            offsets.append(arguments.at(0).value<QList<qint64>>());
+        return offsets;
+    }
+}
+
+TEST_CASE("Line matcher needs every term and ignores case", "[core][logFilter]")
+{
+    ASSERT(
+        CHECK(matches("error db", "Error: DB connection lost"));
+        CHECK_FALSE(matches("error db", "Error: cache miss"));
+        CHECK(matches("+error", "ERROR"));
+        CHECK(LogLineMatcher("   ").isEmpty());
+        CHECK(matches("", "anything"));
+    )
+}
+
+TEST_CASE("Line matcher excludes terms and keeps quoted phrases together", "[core][logFilter]")
+{
+    ASSERT(
+        CHECK(matches("error -timeout", "error: refused"));
+        CHECK_FALSE(matches("error -timeout", "error: Timeout after 3s"));
+        CHECK(matches("\"connection refused\"", "connect: Connection refused"));
+        CHECK_FALSE(matches("\"connection refused\"", "refused connection"));
+        CHECK(matches("a - b", "a - b"));
+    )
+}
+
+TEST_CASE("Line matcher treats slashes as a regular expression", "[core][logFilter]")
+{
+    ARRANGE(
+        LogLineMatcher matcher("/^GET /items/\\d+ 5\\d\\d$/");
+        LogLineMatcher invalid("/(unclosed/");
+    )
+
+    ASSERT(
+        CHECK(matcher.isValid());
+        CHECK(matcher.matches("get /items/7 503", 16));
+        CHECK_FALSE(matcher.matches("GET /items/7 200", 16));
+        CHECK_FALSE(invalid.isValid());
+        CHECK_FALSE(invalid.errorString().isEmpty());
+    )
+}
+
+TEST_CASE("Line matcher looks past colors", "[core][logFilter]")
+{
+    ASSERT(
+        CHECK(matches("\"error: db\"", "\x1b[31merror\x1b[0m: db down"));
+        CHECK(matches("/^error/", "\x1b[31merror\x1b[0m"));
+        CHECK_FALSE(matches("31m", "\x1b[31merror\x1b[0m"));
+    )
+}
+
+TEST_CASE("Log filter streams matching lines of every segment", "[core][logFilter]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000);
+        LogFilter filter(dir.path());
+        QSignalSpy matchesSpy(&filter, &LogFilter::matchesFound);
+        QSignalSpy finishedSpy(&filter, &LogFilter::finished);
+    )
+
+    ACT(
+        filter.start(LogLineMatcher("refused"));
+        REQUIRE(finishedSpy.wait(5000));
+        const QList<QByteArray> lines = linesAt(dir.path(), collect(matchesSpy));
+    )
+
+    ASSERT(
+        REQUIRE(lines.size() == 10);
+        CHECK(lines.first() == "[api] Request 42 failed: Connection REFUSED");
+        CHECK(lines.last() == "[api] Request 942 failed: Connection REFUSED");
+        CHECK_FALSE(filter.isRunning());
+    )
+}
+
+TEST_CASE("Log filter update scans only new output", "[core][logFilter]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 500);
+        LogFilter filter(dir.path());
+        QSignalSpy matchesSpy(&filter, &LogFilter::matchesFound);
+        QSignalSpy finishedSpy(&filter, &LogFilter::finished);
+        filter.start(LogLineMatcher("refused"));
+        REQUIRE(finishedSpy.wait(5000));
+        matchesSpy.clear();
+    )
+
+    ACT(
+        writeLines(dir.path(), 500, 500);
+        filter.update();
+        REQUIRE(finishedSpy.wait(5000));
+        const QList<QByteArray> lines = linesAt(dir.path(), collect(matchesSpy));
+    )
+
+    ASSERT(
+        REQUIRE(lines.size() == 5);
+        CHECK(lines.first() == "[api] Request 542 failed: Connection REFUSED");
+    )
+}
+
+TEST_CASE("Log filter drops results of a replaced query", "[core][logFilter]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000);
+        LogFilter filter(dir.path());
+        QSignalSpy matchesSpy(&filter, &LogFilter::matchesFound);
+        QSignalSpy finishedSpy(&filter, &LogFilter::finished);
+    )
+
+    ACT(
+        filter.start(LogLineMatcher("200"));
+        filter.start(LogLineMatcher("refused"));
+        REQUIRE(finishedSpy.wait(5000));
+        const QList<QByteArray> lines = linesAt(dir.path(), collect(matchesSpy));
+    )
+
+    ASSERT(
+        CHECK(finishedSpy.size() == 1);
+        CHECK(lines.size() == 10);
+    )
+}
@@ -0,0 +1,160 @@
+// clang-format off
+
+#include "../../src/core/LogIndexer.h"
+#include "../../src/core/LogRecordIndex.h"
+#include "../helpers/LogTestHelpers.h"
+#include "../helpers/TestHelpers.h"
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+using LogTestHelpers::indexFiles;
+using LogTestHelpers::linesAt;
+using LogTestHelpers::writeLines;
+
+namespace
+{
+    // 2024-05-01T12:00:00Z
+    constexpr qint64 Noon = 1714564800000;
+
+    // Line i is logged i seconds after noon; every tenth is an error followed by a stack frame
+    QByteArray recordLine(int i)
+    {
+        const QByteArray time = QByteArray::asprintf("2024-05-01T12:%02d:%02dZ", i / 60, i % 60);
+        const QByteArray logger = i % 2 == 0 ? "api" : "worker";
+        if (i % 10 == 0)
+        {
+            return time + " ERROR " + logger + " - request " + QByteArray::number(i) + " failed\n" +
+                   "    at handler (app.js:" + QByteArray::number(i) + ")\n";
+        }
+        return time + " INFO " + logger + " - request " + QByteArray::number(i) + " ok\n";
+    }
+}
+
+TEST_CASE("Record index filters by level with continuation lines", "[core][logRecordIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000, recordLine);
+        LogRecordIndex index(dir.path());
+    )
+
+    ACT(
+        qint64 indexed = index.update();
+        QList<qint64> errors = index.filter(LogLevel::Error);
+        QList<qint64> everything = index.filter(LogLevel::Info);
+        QList<qint64> newest = index.filter(LogLevel::Error, QByteArray(), 2);
+    )
+
+    ASSERT(
+        CHECK(indexed == 1100);
+        CHECK(index.lineCount() == 1100);
+        REQUIRE(errors.size() == 200);
+        CHECK(linesAt(dir.path(), errors).at(0) == "2024-05-01T12:00:00Z ERROR api - request 0 failed");
+        CHECK(linesAt(dir.path(), errors).at(1) == "    at handler (app.js:0)");
+        CHECK(everything.size() == 1100);
+        CHECK(linesAt(dir.path(), newest) == QList<QByteArray>({"2024-05-01T12:16:30Z ERROR api - request 990 failed",
+                                                                "    at handler (app.js:990)"}));
+    )
+}
+
+TEST_CASE("Record index filters by logger", "[core][logRecordIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 100, recordLine);
+        LogRecordIndex index(dir.path());
+        index.update();
+    )
+
+    ACT(
+        QList<qint64> worker = index.filter(LogLevel::Info, "worker");
+        QList<qint64> unknown = index.filter(LogLevel::Info, "scheduler");
+    )
+
+    ASSERT(
+        CHECK(worker.size() == 50);
+        CHECK(linesAt(dir.path(), worker).first() == "2024-05-01T12:00:01Z INFO worker - request 1 ok");
+        CHECK(unknown.isEmpty());
+    )
+}
+
+TEST_CASE("Record index jumps to a time", "[core][logRecordIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000, recordLine);
+        LogRecordIndex index(dir.path());
+        index.update();
+    )
+
+    ACT(
+        qint64 exact = index.findTime(Noon + 500 * 1000);
+        qint64 between = index.findTime(Noon + 500 * 1000 + 1);
+        qint64 before = index.findTime(Noon - 60 * 1000);
+        qint64 after = index.findTime(Noon + 2000 * 1000);
+    )
+
+    ASSERT(
+        CHECK(linesAt(dir.path(), {exact}).first() == "2024-05-01T12:08:20Z ERROR api - request 500 failed");
+        CHECK(linesAt(dir.path(), {between}).first() == "2024-05-01T12:08:21Z INFO worker - request 501 ok");
+        CHECK(before == 0);
+        CHECK(after == -1);
+    )
+}
+
+TEST_CASE("Record index is saved and extended with new output", "[core][logRecordIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 500, recordLine);
+        {
+            LogRecordIndex index(dir.path());
+            index.update();
+        }
+        QStringList saved = indexFiles(dir.path(), "rec");
+    )
+
+    ACT(
+        LogRecordIndex reopened(dir.path());
+        qint64 indexedAgain = reopened.update();
+        writeLines(dir.path(), 500, 100, recordLine);
+        qint64 indexedNew = reopened.update();
+        QList<qint64> errors = reopened.filter(LogLevel::Error);
+    )
+
+    ASSERT(
+        CHECK_FALSE(saved.isEmpty());
+        CHECK(indexedAgain == 0);
+        CHECK(indexedNew == 110);
+        CHECK(errors.size() == 120);
+        CHECK(linesAt(dir.path(), errors).at(100) == "2024-05-01T12:08:20Z ERROR api - request 500 failed");
+    )
+}
+
+TEST_CASE("Log indexer filters on its worker thread", "[core][logRecordIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 200, recordLine);
+        QSignalSpy filterSpy(&LogIndexer::instance(), &LogIndexer::filterFinished);
+        QSignalSpy timeSpy(&LogIndexer::instance(), &LogIndexer::timeFound);
+    )
+
+    ACT(
+        int filterId = LogIndexer::instance().filter(dir.path(), LogLevel::Warning);
+        bool filtered = filterSpy.wait(5000);
+        int timeId = LogIndexer::instance().findTime(dir.path(), Noon + 10 * 1000);
+        bool found = timeSpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(filtered);
+        CHECK(filterSpy.first().at(0).toInt() == filterId);
+        CHECK(filterSpy.first().at(1).value<QList<qint64>>().size() == 40);
+        REQUIRE(found);
+        CHECK(timeSpy.first().at(0).toInt() == timeId);
+        CHECK(linesAt(dir.path(), {timeSpy.first().at(1).toLongLong()}).first() ==
+              "2024-05-01T12:00:10Z ERROR api - request 10 failed");
+    )
+}
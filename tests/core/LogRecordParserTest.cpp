@@ -0,0 +1,126 @@
+// clang-format off
+
+#include "../../src/core/LogRecordParser.h"
+#include "../helpers/TestHelpers.h"
+#include <QDateTime>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    // 2024-05-01T12:00:00Z
+    constexpr qint64 Noon = 1714564800000;
+
+    LogRecord parse(const QByteArray& line)
+    {
+        LogRecordParser parser;
+        return parser.parse(line.constData(), line.size());
+    }
+
+    qint64 localTime(int hour, int minute, int second, int msecs)
+    {
+        return QDateTime(QDate(2024, 5, 1), QTime(hour, minute, second, msecs)).toMSecsSinceEpoch();
+    }
+}
+
+TEST_CASE("Record parser reads JSON lines", "[core][logRecordParser]")
+{
+    ARRANGE(
+        QByteArray bunyan = R"({"msg":"slow query","level":"warn","time":"2024-05-01T12:00:00.250Z","logger":"db"})";
+        QByteArray pino = R"({"level":50,"time":1714564800000,"pid":7,"name":"api","msg":"boom"})";
+    )
+
+    ACT(
+        LogRecord warning = parse(bunyan);
+        LogRecord error = parse(pino);
+    )
+
+    ASSERT(
+        CHECK(warning.level == LogLevel::Warning);
+        CHECK(warning.timestamp == Noon + 250);
+        CHECK(warning.logger == "db");
+        CHECK(error.level == LogLevel::Error);
+        CHECK(error.timestamp == Noon);
+        CHECK(error.logger == "api");
+    )
+}
+
+TEST_CASE("Record parser reads logfmt lines", "[core][logRecordParser]")
+{
+    ARRANGE(
+        QByteArray line = R"(time=2024-05-01T14:00:00+02:00 level=info logger=http msg="GET / 200")";
+        QByteArray quoted = R"(ts="2024-05-01T12:00:00Z" lvl=ERROR msg="failed")";
+    )
+
+    ACT(
+        LogRecord info = parse(line);
+        LogRecord error = parse(quoted);
+    )
+
+    ASSERT(
+        CHECK(info.level == LogLevel::Info);
+        CHECK(info.timestamp == Noon);
+        CHECK(info.logger == "http");
+        CHECK(error.level == LogLevel::Error);
+        CHECK(error.timestamp == Noon);
+    )
+}
+
+TEST_CASE("Record parser reads text lines", "[core][logRecordParser]")
+{
+    ACT(
+        LogRecord log4j = parse("2024-05-01 12:00:00,123 ERROR com.example.App - disk full");
+        LogRecord python = parse("WARNING:urllib3.connectionpool:Retrying");
+        LogRecord colored = parse("\x1b[33m[warn]\x1b[0m vite: hmr update failed");
+        LogRecord node = parse("Error: Cannot find module 'express'");
+        LogRecord bracketedTime = parse("[2024-05-01T12:00:00Z] [DEBUG] cache warm");
+    )
+
+    ASSERT(
+        CHECK(log4j.level == LogLevel::Error);
+        CHECK(log4j.timestamp == localTime(12, 0, 0, 123));
+        CHECK(log4j.logger == "com.example.App");
+        CHECK(python.level == LogLevel::Warning);
+        CHECK(python.logger == "urllib3.connectionpool");
+        CHECK(colored.level == LogLevel::Warning);
+        CHECK(node.level == LogLevel::Error);
+        CHECK(bracketedTime.level == LogLevel::Debug);
+        CHECK(bracketedTime.timestamp == Noon);
+    )
+}
+
+TEST_CASE("Record parser leaves plain output alone", "[core][logRecordParser]")
+{
+    ACT(
+        LogRecord request = parse("GET /api/errors 200 in 3ms");
+        LogRecord prose = parse("The info page has loaded");
+        LogRecord stackFrame = parse("    at Object.<anonymous> (/app/index.js:10:5)");
+        LogRecord badDate = parse("2024-13-01 00:00:00 starting");
+    )
+
+    ASSERT(
+        CHECK(request.level == LogLevel::Unknown);
+        CHECK(prose.level == LogLevel::Unknown);
+        CHECK(stackFrame.level == LogLevel::Unknown);
+        CHECK(stackFrame.timestamp == 0);
+        CHECK(badDate.timestamp == 0);
+    )
+}
+
+TEST_CASE("Record parser converts local times across hours", "[core][logRecordParser]")
+{
+    ARRANGE(
+        LogRecordParser parser;
+        QByteArray first = "2024-05-01 12:59:59.900 first";
+        QByteArray second = "2024-05-01 13:00:00.100 second";
+    )
+
+    ACT(
+        qint64 before = parser.parseDateTime(first.constData(), first.size());
+        qint64 after = parser.parseDateTime(second.constData(), second.size());
+    )
+
+    ASSERT(
+        CHECK(before == localTime(12, 59, 59, 900));
+        CHECK(after == localTime(13, 0, 0, 100));
+    )
+}
@@ -0,0 +1,132 @@
+// clang-format off
+
+#include "../../src/core/LogIndexer.h"
+#include "../../src/core/LogSearchIndex.h"
+#include "../helpers/LogTestHelpers.h"
+#include "../helpers/TestHelpers.h"
+#include <QDir>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+using LogTestHelpers::indexFiles;
+using LogTestHelpers::linesAt;
+using LogTestHelpers::writeLines;
+
+TEST_CASE("Search index finds lines across segments ignoring case", "[core][logSearchIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000);
+        LogSearchIndex index(dir.path());
+    )
+
+    ACT(
+        qint64 indexed = index.update();
+        QList<qint64> hits = index.search("connection refused");
+        QList<qint64> none = index.search("timeout");
+    )
+
+    ASSERT(
+        CHECK(indexed > 0);
+        REQUIRE(hits.size() == 10);
+        CHECK(linesAt(dir.path(), hits).first() == "[api] Request 42 failed: Connection REFUSED");
+        CHECK(linesAt(dir.path(), hits).last() == "[api] Request 942 failed: Connection REFUSED");
+        CHECK(none.isEmpty());
+    )
+}
+
+TEST_CASE("Search index keeps the newest hits and handles short queries", "[core][logSearchIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 1000);
+        LogSearchIndex index(dir.path());
+        index.update();
+    )
+
+    ACT(
+        QList<qint64> newest = index.search("refused", 2);
+        QList<qint64> twoCharacters = index.search("D:");
+    )
+
+    ASSERT(
+        CHECK(linesAt(dir.path(), newest) == QList<QByteArray>({"[api] Request 842 failed: Connection REFUSED",
+                                                                "[api] Request 942 failed: Connection REFUSED"}));
+        CHECK(twoCharacters.size() == 10);
+    )
+}
+
+TEST_CASE("Search index is saved and extended with new output", "[core][logSearchIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 500);
+        {
+            LogSearchIndex index(dir.path());
+            index.update();
+        }
+        QStringList saved = indexFiles(dir.path(), "tri");
+    )
+
+    ACT(
+        LogSearchIndex reopened(dir.path());
+        qint64 indexedAgain = reopened.update();
+        writeLines(dir.path(), 500, 100);
+        qint64 indexedNew = reopened.update();
+        QList<qint64> hits = reopened.search("REQUEST 542");
+    )
+
+    ASSERT(
+        CHECK_FALSE(saved.isEmpty());
+        CHECK(indexedAgain == 0);
+        CHECK(indexedNew > 0);
+        CHECK(linesAt(dir.path(), hits) == QList<QByteArray>({"[api] Request 542 failed: Connection REFUSED"}));
+    )
+}
+
+TEST_CASE("Segments without an index are indexed from scratch", "[core][logSearchIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 300);
+        {
+            LogSearchIndex index(dir.path());
+            index.update();
+        }
+        for (const QString& fileName : indexFiles(dir.path(), "tri"))
+            QDir(dir.path()).remove(fileName);
+    )
+
+    ACT(
+        LogSearchIndex index(dir.path());
+        qint64 indexed = index.update();
+        QList<qint64> hits = index.search("refused");
+    )
+
+    ASSERT(
+        CHECK(indexed > 0);
+        CHECK(hits.size() == 3);
+        CHECK_FALSE(indexFiles(dir.path(), "tri").isEmpty());
+    )
+}
+
+TEST_CASE("Log indexer searches on its worker thread", "[core][logSearchIndex]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeLines(dir.path(), 0, 200);
+        QSignalSpy finishedSpy(&LogIndexer::instance(), &LogIndexer::searchFinished);
+    )
+
+    ACT(
+        int searchId = LogIndexer::instance().search(dir.path(), "refused");
+        bool finished = finishedSpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(finished);
+        CHECK(finishedSpy.first().at(0).toInt() == searchId);
+        CHECK(finishedSpy.first().at(1).value<QList<qint64>>().size() == 2);
+    )
+}
@@ -0,0 +1,231 @@
+// clang-format off
+
+#include "../../src/core/LogLineRing.h"
+#include "../../src/core/LogStream.h"
+#include "../helpers/TestHelpers.h"
+#include <QSignalSpy>
+#include <QTest>
+#include <atomic>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    quint64 appendLine(LogLineRing& ring, const QByteArray& text, qint64 fileOffset = 0)
+    {
+        return ring.append(text.constData(), text.size(), fileOffset);
+    }
+
+    QList<QByteArray> texts(const QList<LogLine>& lines)
+    {
+        QList<QByteArray> result;
+        for (const LogLine& line : lines)
+            result.append(line.text);
+        return result;
+    }
+}
+
+TEST_CASE("Log line ring numbers lines from one", "[core][logStream]")
+{
+    ARRANGE(
+        LogLineRing ring(4, 1024);
+    )
+
+    ACT(
+        quint64 first = appendLine(ring, "a\n", 0);
+        quint64 second = appendLine(ring, "b\n", 2);
+        QList<LogLine> lines = ring.readFrom(0);
+    )
+
+    ASSERT(
+        CHECK(first == 1);
+        CHECK(second == 2);
+        CHECK(ring.nextSequence() == 3);
+        REQUIRE(lines.size() == 2);
+        CHECK(lines[1].sequence == 2);
+        CHECK(lines[1].fileOffset == 2);
+        CHECK(lines[1].text == "b\n");
+    )
+}
+
+TEST_CASE("Log line ring drops the oldest lines once full", "[core][logStream]")
+{
+    ARRANGE(
+        LogLineRing ring(3, 1024);
+    )
+
+    ACT(
+        for (const char* text : {"1\n", "2\n", "3\n", "4\n", "5\n"})
+            appendLine(ring, text);
+    )
+
+    ASSERT(
+        CHECK(texts(ring.readFrom(0)) == QList<QByteArray>({"3\n", "4\n", "5\n"}));
+        CHECK(texts(ring.readFrom(4)) == QList<QByteArray>({"4\n", "5\n"}));
+        CHECK(ring.readFrom(6).isEmpty());
+    )
+}
+
+TEST_CASE("Log line ring drops lines whose bytes were reused", "[core][logStream]")
+{
+    ARRANGE(
+        LogLineRing ring(16, 32);
+        QByteArray eight(8, 'x');
+    )
+
+    ACT(
+        for (int i = 0; i < 6; ++i)
+            appendLine(ring, eight);
+        QList<LogLine> lines = ring.readFrom(0);
+    )
+
+    ASSERT(
+        // 32 bytes hold the last four lines of eight bytes
+        REQUIRE(lines.size() == 4);
+        CHECK(lines.first().sequence == 3);
+        CHECK(lines.last().text == eight);
+    )
+}
+
+TEST_CASE("Log line ring readers never see torn lines", "[core][logStream]")
+{
+    ARRANGE(
+        LogLineRing ring(64, 2048);
+        constexpr int LineCount = 200000;
+        std::atomic<bool> done{false};
+        std::atomic<int> torn{0};
+        std::atomic<int> seen{0};
+    )
+
+    ACT(
+        std::thread reader([&]()
+        {
+            quint64 next = 1;
+            while (!done.load())
+            {
+                for (const LogLine& line : ring.readFrom(next))
+                {
+                    if (line.text != QByteArray::number(line.sequence) + '\n' || line.fileOffset != qint64(line.sequence))
+                        ++torn;
+                    next = line.sequence + 1;
+                    ++seen;
+                }
+            }
+        });
+
+        for (int i = 1; i <= LineCount; ++i)
+            appendLine(ring, QByteArray::number(i) + '\n', i);
+        done = true;
+        reader.join();
+    )
+
+    ASSERT(
+        CHECK(torn.load() == 0);
+        CHECK(seen.load() > 0);
+    )
+}
+
+TEST_CASE("Log stream splits output into lines across writes", "[core][logStream]")
+{
+    ARRANGE(
+        LogStream stream;
+        QSignalSpy appended(&stream, &LogStream::linesAppended);
+    )
+
+    ACT(
+        stream.write("compiling\nbuil", 100);
+        stream.write("d done\nlistening", 114);
+        QList<LogLine> lines = stream.readFrom(0);
+    )
+
+    ASSERT(
+        CHECK(appended.count() == 2);
+        REQUIRE(lines.size() == 2);
+        CHECK(lines[0].text == "compiling\n");
+        CHECK(lines[0].fileOffset == 100);
+        CHECK(lines[1].text == "build done\n");
+        CHECK(lines[1].fileOffset == 110);
+    )
+}
+
+TEST_CASE("Log stream publishes an unterminated line after a pause", "[core][logStream]")
+{
+    ARRANGE(
+        LogStream stream;
+        QSignalSpy appended(&stream, &LogStream::linesAppended);
+    )
+
+    ACT(
+        stream.write("Password: ", 0);
+        bool published = appended.wait(1000);
+        QList<LogLine> lines = stream.readFrom(0);
+    )
+
+    ASSERT(
+        CHECK(published);
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0].text == "Password: ");
+    )
+}
+
+TEST_CASE("Log stream hides lines written before it was cleared", "[core][logStream]")
+{
+    ARRANGE(
+        LogStream stream;
+        stream.write("old\n", 0);
+    )
+
+    ACT(
+        stream.markCleared();
+        stream.write("new\n", 4);
+    )
+
+    ASSERT(
+        CHECK(texts(stream.readFrom(0)) == QList<QByteArray>({"new\n"}));
+    )
+}
+
+TEST_CASE("Log stream hub keeps one stream per process", "[core][logStream]")
+{
+    ARRANGE(
+        LogStreamHub& hub = LogStreamHub::instance();
+    )
+
+    ACT(
+        LogStream* first = &hub.acquire(9001);
+        LogStream* again = &hub.acquire(9001);
+        LogStream* other = &hub.acquire(9002);
+    )
+
+    ASSERT(
+        CHECK(first == again);
+        CHECK(first != other);
+        hub.release(9001);
+        hub.release(9001);
+        hub.release(9002);
+    )
+}
+
+TEST_CASE("Log stream hub drops a stream once nobody holds it", "[core][logStream]")
+{
+    ARRANGE(
+        LogStreamHub& hub = LogStreamHub::instance();
+        LogStream& writer = hub.acquire(9003);
+        hub.acquire(9003);
+        writer.write("kept\n", 0);
+    )
+
+    ACT(
+        hub.release(9003);
+        const bool keptForViewer = !hub.acquire(9003).readFrom(0).isEmpty();
+        hub.release(9003);
+        hub.release(9003);
+        const bool fresh = hub.acquire(9003).readFrom(0).isEmpty();
+        hub.release(9003);
+    )
+
+    ASSERT(
+        CHECK(keptForViewer);
+        CHECK(fresh);
+    )
+}
@@ -0,0 +1,79 @@
+// clang-format off
+
+#include "../../src/core/LogTimeline.h"
+#include "../../src/core/ProcessLogSink.h"
+#include "../helpers/TestHelpers.h"
+#include <QTemporaryDir>
+#include <QTest>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Timeline gives output the time its chunk was received", "[core][logTimeline]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        ProcessLogSink sink(dir.path());
+        REQUIRE(sink.open());
+        LogTimeline timeline(dir.path());
+    )
+
+    ACT(
+        sink.write("first line\nsecond ");
+        QTest::qWait(20);
+        const qint64 laterOffset = sink.position();
+        sink.write("line\nthird line\n");
+        sink.close();
+        timeline.refresh();
+    )
+
+    ASSERT(
+        CHECK(timeline.timeAt(0) > 0);
+        CHECK(timeline.timeAt(11) == timeline.timeAt(0));
+        CHECK(timeline.timeAt(laterOffset) >= timeline.timeAt(0) + 20);
+        CHECK(timeline.timeAt(laterOffset + 5) == timeline.timeAt(laterOffset));
+    )
+}
+
+TEST_CASE("Timeline falls back to the start of the segment", "[core][logTimeline]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path());
+        REQUIRE(log.openForAppend());
+        log.append("written without stamps\n");
+        LogTimeline timeline(dir.path());
+    )
+
+    ACT(
+        timeline.refresh();
+    )
+
+    ASSERT(
+        CHECK(timeline.timeAt(5) == log.segments().first().startedAt);
+        CHECK(timeline.timeAt(-1) == 0);
+    )
+}
+
+TEST_CASE("Timeline reads stamps written since the last refresh", "[core][logTimeline]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path());
+        REQUIRE(log.openForAppend());
+        log.append("one\ntwo\n");
+        REQUIRE(LogTimeline::append(log, {{0, 1000}, {4, 2000}}));
+        LogTimeline timeline(dir.path());
+        timeline.refresh();
+    )
+
+    ACT(
+        log.append("three\n");
+        REQUIRE(LogTimeline::append(log, {{8, 3000}}));
+        timeline.refresh();
+    )
+
+    ASSERT(
+        CHECK(timeline.timeAt(2) == 1000);
+        CHECK(timeline.timeAt(4) == 2000);
+        CHECK(timeline.timeAt(10) == 3000);
+    )
+}
@@ -0,0 +1,57 @@
+// clang-format off
+
+#include "../../src/core/LogWatcher.h"
+#include "../../src/core/SegmentedLog.h"
+#include "../helpers/TestHelpers.h"
+#include <QDir>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Log watcher reports appended output", "[core][logWatcher]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("logs");
+        LogWatcher watcher(path);
+        QSignalSpy changedSpy(&watcher, &LogWatcher::changed);
+        SegmentedLog log(path);
+        REQUIRE(log.openForAppend());
+        changedSpy.wait(200);
+        changedSpy.clear();
+    )
+
+    ACT(
+        log.append("ready\n");
+        bool changed = changedSpy.wait(2000);
+    )
+
+    ASSERT(
+        CHECK(watcher.isWatching());
+        CHECK(QDir(path).exists());
+        CHECK(changed);
+    )
+}
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Log watcher ignores sidecar files", "[core][logWatcher]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        LogWatcher watcher(dir.path());
+        QSignalSpy changedSpy(&watcher, &LogWatcher::changed);
+    )
+
+    ACT(
+        QFile sidecar(dir.filePath("0000000000000000.tri"));
+        REQUIRE(sidecar.open(QIODevice::WriteOnly));
+        sidecar.write("index");
+        sidecar.close();
+        bool changed = changedSpy.wait(300);
+    )
+
+    ASSERT(
+        CHECK_FALSE(changed);
+    )
+}
+#endif
@@ -0,0 +1,188 @@
+// clang-format off
+
+// INFO and DEBUG are kept whatever the build type
+#define LOGGER_MIN_LEVEL 0
+
+#include "../../src/core/Logger.h"
+#include "../helpers/TestHelpers.h"
+#include <QFile>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    QString readLog(const QString& path)
+    {
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        return QString::fromUtf8(file.readAll());
+    }
+
+    // Counts how often a message was built
+    QString countedMessage(int& built, const QString& text)
+    {
+        ++built;
+        return text;
+    }
+}
+
+TEST_CASE("Logger writes the messages of every thread in order", "[core][logger]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("test.log");
+        REQUIRE(Logger::open(path));
+        constexpr int ThreadCount = 4;
+        constexpr int MessageCount = 1000;
+    )
+
+    ACT(
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < ThreadCount; ++thread)
+        {
+            threads.emplace_back([thread]()
+            {
+                for (int i = 0; i < MessageCount; ++i)
+                    LOG_INFO(QString("thread %1 message %2").arg(thread).arg(i));
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        Logger::flush();
+        const QString text = readLog(path);
+        Logger::shutdown();
+    )
+
+    ASSERT(
+        int next[ThreadCount] = {};
+        bool inOrder = true;
+        const QRegularExpression pattern("thread (\\d) message (\\d+)$", QRegularExpression::MultilineOption);
+        for (const QRegularExpressionMatch& match : pattern.globalMatch(text))
+        {
+            const int thread = match.captured(1).toInt();
+            inOrder = inOrder && match.captured(2).toInt() == next[thread];
+            ++next[thread];
+        }
+        CHECK(inOrder);
+        for (int thread = 0; thread < ThreadCount; ++thread)
+            CHECK(next[thread] == MessageCount);
+        CHECK(text.contains("[INFO] [general] [LoggerTest.cpp:"));
+    )
+}
+
+TEST_CASE("Logger drops messages after shutdown", "[core][logger]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("test.log");
+        REQUIRE(Logger::open(path));
+    )
+
+    ACT(
+        LOG_WARNING("before shutdown");
+        Logger::shutdown();
+        LOG_WARNING("after shutdown");
+        Logger::flush();
+    )
+
+    ASSERT(
+        const QString text = readLog(path);
+        CHECK(text.contains("before shutdown"));
+        CHECK_FALSE(text.contains("after shutdown"));
+    )
+}
+
+TEST_CASE("Logger does not build messages below the minimum level", "[core][logger]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("test.log");
+        REQUIRE(Logger::open(path));
+        Logger::setMinimumLevel(Logger::Category::General, Logger::Level::Warning);
+        int built = 0;
+    )
+
+    ACT(
+        LOG_INFO(countedMessage(built, "disabled info"));
+        LOG_WARNING(countedMessage(built, "enabled warning"));
+        Logger::flush();
+        Logger::setMinimumLevel(Logger::Category::General, Logger::Level::Info);
+        const QString text = readLog(path);
+        Logger::shutdown();
+    )
+
+    ASSERT(
+        CHECK(built == 1);
+        CHECK_FALSE(text.contains("disabled info"));
+        CHECK(text.contains("[WARN] [general]"));
+        CHECK(text.contains("enabled warning"));
+    )
+}
+
+TEST_CASE("Logger keeps a minimum level for every category", "[core][logger]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("test.log");
+        REQUIRE(Logger::open(path));
+    )
+
+    ACT(
+        const bool known = Logger::configure("warning, db=debug");
+        LOG_DEBUG_IN(Database, "database debug");
+        LOG_INFO_IN(Ui, "ui info");
+        LOG_ERROR_IN(Ui, "ui error");
+        const bool unknown = Logger::configure("db=loud,network=debug");
+        const Logger::Level databaseLevel = Logger::minimumLevel(Logger::Category::Database);
+        Logger::configure("info,db=warning");
+        Logger::flush();
+        const QString text = readLog(path);
+        Logger::shutdown();
+    )
+
+    ASSERT(
+        CHECK(known);
+        CHECK_FALSE(unknown);
+        CHECK(databaseLevel == Logger::Level::Debug);
+        CHECK(Logger::minimumLevel(Logger::Category::Database) == Logger::Level::Warning);
+        CHECK(Logger::minimumLevel(Logger::Category::Process) == Logger::Level::Info);
+        CHECK(text.contains("[DEBUG] [db]"));
+        CHECK(text.contains("database debug"));
+        CHECK_FALSE(text.contains("ui info"));
+        CHECK(text.contains("[ERROR] [ui]"));
+    )
+}
+
+// What a release build compiles: INFO and DEBUG calls are gone whatever the minimum level
+#undef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 2
+
+TEST_CASE("Logger compiles out levels below LOGGER_MIN_LEVEL", "[core][logger]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        const QString path = dir.filePath("test.log");
+        REQUIRE(Logger::open(path));
+        Logger::setMinimumLevel(Logger::Category::General, Logger::Level::Debug);
+        int built = 0;
+    )
+
+    ACT(
+        LOG_DEBUG(countedMessage(built, "compiled out debug"));
+        LOG_INFO(countedMessage(built, "compiled out info"));
+        LOG_WARNING(countedMessage(built, "compiled in warning"));
+        Logger::flush();
+        Logger::setMinimumLevel(Logger::Category::General, Logger::Level::Info);
+        const QString text = readLog(path);
+        Logger::shutdown();
+    )
+
+    ASSERT(
+        CHECK(built == 1);
+        CHECK_FALSE(text.contains("compiled out"));
+        CHECK(text.contains("compiled in warning"));
+    )
+}
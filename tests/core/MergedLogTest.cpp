@@ -0,0 +1,191 @@
+// clang-format off
+
+#include "../../src/core/AnsiParser.h"
+#include "../../src/core/MergedLog.h"
+#include "../helpers/TestHelpers.h"
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    using StampedLines = QList<QPair<qint64, QByteArray>>;
+
+    // Appends every line stamped with its time, as if it was received then
+    void writeStamped(const QString& path, const StampedLines& lines)
+    {
+        SegmentedLog log(path);
+        REQUIRE(log.openForAppend());
+        for (const auto& [time, line] : lines)
+        {
+            const qint64 offset = log.endOffset();
+            log.append(line + "\n");
+            REQUIRE(LogTimeline::append(log, {{offset, time}}));
+        }
+    }
+
+    QStringList texts(const MergedLog& merged)
+    {
+        QStringList result;
+        for (qint64 row = 0; row < merged.rowCount(); ++row)
+            result.append(AnsiParser::plainText(merged.rowText(row)));
+        return result;
+    }
+
+    bool inTimeOrder(const MergedLog& merged)
+    {
+        for (qint64 row = 1; row < merged.rowCount(); ++row)
+        {
+            if (merged.row(row).time < merged.row(row - 1).time)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Merged log interleaves processes by time received", "[core][mergedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeStamped(dir.filePath("api"), {{10, "GET /1"}, {30, "GET /2"}, {50, "GET /3"}});
+        writeStamped(dir.filePath("web"), {{20, "compiled"}, {40, "reloaded"}});
+        MergedLog merged;
+        merged.addSource(dir.filePath("api"), "api", Qt::blue);
+        merged.addSource(dir.filePath("web"), "web", Qt::green);
+    )
+
+    ACT(
+        const bool more = merged.refresh();
+    )
+
+    ASSERT(
+        CHECK_FALSE(more);
+        CHECK(texts(merged) == QStringList{"api GET /1", "web compiled", "api GET /2", "web reloaded", "api GET /3"});
+        CHECK(merged.row(1).source == 1);
+        CHECK_FALSE(merged.hasOlder());
+    )
+}
+
+TEST_CASE("Merged log moves lines received late in among the last rows", "[core][mergedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeStamped(dir.filePath("api"), {{10, "GET /1"}});
+        writeStamped(dir.filePath("worker"), {{20, "job 1"}});
+        MergedLog merged;
+        merged.addSource(dir.filePath("api"), "api", Qt::blue);
+        merged.addSource(dir.filePath("worker"), "worker", Qt::green);
+        merged.refresh();
+    )
+
+    ACT(
+        writeStamped(dir.filePath("api"), {{60, "GET /2"}});
+        merged.refresh();
+        writeStamped(dir.filePath("worker"), {{45, "job 2"}});
+        merged.refresh();
+    )
+
+    ASSERT(
+        CHECK(texts(merged) == QStringList{"api    GET /1", "worker job 1", "worker job 2", "api    GET /2"});
+    )
+}
+
+TEST_CASE("Merged log starts at the tail and merges older rows on demand", "[core][mergedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        StampedLines apiLines;
+        StampedLines webLines;
+        for (int i = 0; i < 1000; ++i)
+        {
+            apiLines.append({i * 2, "api line " + QByteArray::number(i)});
+            webLines.append({i * 2 + 1, "web line " + QByteArray::number(i)});
+        }
+        writeStamped(dir.filePath("api"), apiLines);
+        writeStamped(dir.filePath("web"), webLines);
+        MergedLog merged;
+        merged.addSource(dir.filePath("api"), "api", Qt::blue);
+        merged.addSource(dir.filePath("web"), "web", Qt::green);
+        merged.refresh();
+        const qint64 tailRows = merged.rowCount();
+    )
+
+    ACT(
+        const qint64 added = merged.mergeOlder(100);
+        while (merged.hasOlder())
+            merged.mergeOlder();
+    )
+
+    ASSERT(
+        CHECK(tailRows == 2 * MergedLog::TailLines);
+        CHECK(added == 100);
+        CHECK(merged.rowCount() == 2000);
+        CHECK(inTimeOrder(merged));
+        CHECK(texts(merged).first() == "api api line 0");
+        CHECK(texts(merged).last() == "web web line 999");
+    )
+}
+
+TEST_CASE("Merged log drops its oldest rows and merges them again on demand", "[core][mergedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        StampedLines apiLines;
+        StampedLines webLines;
+        for (int i = 0; i < 1000; ++i)
+        {
+            apiLines.append({i * 2, "api line " + QByteArray::number(i)});
+            webLines.append({i * 2 + 1, "web line " + QByteArray::number(i)});
+        }
+        writeStamped(dir.filePath("api"), apiLines);
+        writeStamped(dir.filePath("web"), webLines);
+        MergedLog merged;
+        merged.addSource(dir.filePath("api"), "api", Qt::blue);
+        merged.addSource(dir.filePath("web"), "web", Qt::green);
+        merged.refresh();
+        while (merged.hasOlder())
+            merged.mergeOlder();
+    )
+
+    ACT(
+        const qint64 dropped = merged.dropOldest(500);
+        const QStringList kept = texts(merged);
+        const bool older = merged.hasOlder();
+        while (merged.hasOlder())
+            merged.mergeOlder();
+    )
+
+    ASSERT(
+        CHECK(dropped == 1500);
+        REQUIRE(kept.size() == 500);
+        CHECK(kept.first() == "api api line 750");
+        CHECK(kept.last() == "web web line 999");
+        CHECK(older);
+        CHECK(merged.rowCount() == 2000);
+        CHECK(inTimeOrder(merged));
+        CHECK(texts(merged).first() == "api api line 0");
+        CHECK(merged.dropOldest(5000) == 0);
+    )
+}
+
+TEST_CASE("Merged log starts over when a log is cleared", "[core][mergedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        writeStamped(dir.filePath("api"), {{10, "GET /1"}, {30, "GET /2"}});
+        writeStamped(dir.filePath("web"), {{20, "compiled"}});
+        MergedLog merged;
+        merged.addSource(dir.filePath("api"), "api", Qt::blue);
+        merged.addSource(dir.filePath("web"), "web", Qt::green);
+        merged.refresh();
+    )
+
+    ACT(
+        SegmentedLog(dir.filePath("api")).clear();
+        writeStamped(dir.filePath("api"), {{40, "GET /3"}});
+        merged.refresh();
+    )
+
+    ASSERT(
+        CHECK(texts(merged) == QStringList{"web compiled", "api GET /3"});
+    )
+}
@@ -0,0 +1,127 @@
+// clang-format off
+
+#include "../../src/core/ProcessLogSink.h"
+#include "../helpers/TestHelpers.h"
+#include <QTemporaryDir>
+#include <QTest>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    QByteArray readAll(const QString& path)
+    {
+        SegmentedLog log(path);
+        log.load();
+        return log.read(log.startOffset(), log.endOffset() - log.startOffset());
+    }
+}
+
+TEST_CASE("Log sink writes bytes verbatim", "[core][processLogSink]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        QString path = dir.filePath("server");
+        // Invalid UTF-8 and CRLF must survive untouched
+        QByteArray chunk("\xff\xfe progress 10%\r\nready\n");
+        ProcessLogSink sink(path);
+        REQUIRE(sink.open());
+    )
+
+    ACT(
+        sink.write(chunk);
+        sink.close();
+    )
+
+    ASSERT(
+        CHECK(readAll(path) == chunk);
+        CHECK_FALSE(sink.isOpen());
+    )
+}
+
+TEST_CASE("Log sink appends to an existing file", "[core][processLogSink]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        QString path = dir.filePath("server");
+        {
+            ProcessLogSink previousRun(path);
+            REQUIRE(previousRun.open());
+            previousRun.write("first run\n");
+        }
+        ProcessLogSink sink(path);
+        REQUIRE(sink.open());
+    )
+
+    ACT(
+        sink.write("second run\n");
+        sink.close();
+    )
+
+    ASSERT(
+        CHECK(readAll(path) == "first run\nsecond run\n");
+    )
+}
+
+TEST_CASE("Log sink buffers until the size limit", "[core][processLogSink]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        QString path = dir.filePath("server");
+        ProcessLogSink sink(path, 16, 60000);
+        REQUIRE(sink.open());
+    )
+
+    ACT(
+        sink.write("0123456789");
+        QByteArray beforeLimit = readAll(path);
+        sink.write("0123456789");
+        QByteArray afterLimit = readAll(path);
+    )
+
+    ASSERT(
+        CHECK(beforeLimit.isEmpty());
+        CHECK(afterLimit == "0123456789");
+        CHECK(sink.pendingBytes() == 10);
+    )
+}
+
+TEST_CASE("Log sink writes oversized chunks directly", "[core][processLogSink]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        QString path = dir.filePath("server");
+        ProcessLogSink sink(path, 16, 60000);
+        REQUIRE(sink.open());
+        QByteArray large(64, 'x');
+    )
+
+    ACT(
+        sink.write("head ");
+        sink.write(large);
+    )
+
+    ASSERT(
+        CHECK(readAll(path) == "head " + large);
+        CHECK(sink.pendingBytes() == 0);
+    )
+}
+
+TEST_CASE("Log sink flushes after the interval", "[core][processLogSink]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        QString path = dir.filePath("server");
+        ProcessLogSink sink(path, ProcessLogSink::BufferLimit, 20);
+        REQUIRE(sink.open());
+    )
+
+    ACT(
+        sink.write("tick\n");
+        bool flushed = QTest::qWaitFor([&]() { return sink.pendingBytes() == 0; }, 1000);
+    )
+
+    ASSERT(
+        CHECK(flushed);
+        CHECK(readAll(path) == "tick\n");
+    )
+}
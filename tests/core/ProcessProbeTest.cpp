@@ -0,0 +1,133 @@
+// clang-format off
+
+#include "../../src/core/ProcessProbe.h"
+#include "../helpers/TestHelpers.h"
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Parse LISTEN sockets from an IPv4 table", "[core][processProbe]")
+{
+    ARRANGE(
+        QByteArray table =
+            "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n"
+            "   0: 0100007F:1F90 00000000:0000 0A 00000000:00000000 00:00000000 00000000  1000        0 41234 1 0000000000000000 100 0 0 10 0\n"
+            "   1: 0100007F:C350 0100007F:1F90 01 00000000:00000000 00:00000000 00000000  1000        0 41235 1 0000000000000000 20 4 30 10 -1\n";
+    )
+
+    ACT(
+        auto sockets = ProcessProbe::parseListenSockets(table);
+    )
+
+    ASSERT(
+        REQUIRE(sockets.size() == 1);
+        CHECK(sockets.value(8080) == 41234);
+    )
+}
+
+TEST_CASE("Parse LISTEN sockets from an IPv6 table", "[core][processProbe]")
+{
+    ARRANGE(
+        QByteArray table =
+            "  sl  local_address                         remote_address                        st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n"
+            "   0: 00000000000000000000000000000000:0BB8 00000000000000000000000000000000:0000 0A 00000000:00000000 00:00000000 00000000  1000        0 99001 1 0000000000000000 100 0 0 10 0\n";
+    )
+
+    ACT(
+        auto sockets = ProcessProbe::parseListenSockets(table);
+    )
+
+    ASSERT(
+        REQUIRE(sockets.size() == 1);
+        CHECK(sockets.value(3000) == 99001);
+    )
+}
+
+TEST_CASE("Parse ignores malformed lines", "[core][processProbe]")
+{
+    ARRANGE(
+        QByteArray table = "header\n   0: garbage\n\n";
+    )
+
+    ACT(
+        auto sockets = ProcessProbe::parseListenSockets(table);
+    )
+
+    ASSERT(
+        CHECK(sockets.isEmpty());
+    )
+}
+
+TEST_CASE("Parse a stat line whose command name contains parentheses", "[core][processProbe]")
+{
+    ARRANGE(
+        QByteArray stat = "4242 (npm (run) dev) S 4200 4242 4100 0 -1 4194560 1510 0 0 0 3 1 0 0 20 0 1 0 123456\n";
+        ProcessProbe::ProcessEntry entry;
+    )
+
+    ACT(
+        bool parsed = ProcessProbe::parseProcessStat(stat, entry);
+    )
+
+    ASSERT(
+        REQUIRE(parsed);
+        CHECK(entry.pid == 4242);
+        CHECK(entry.state == 'S');
+        CHECK(entry.parentPid == 4200);
+        CHECK(entry.processGroupId == 4242);
+        CHECK(entry.sessionId == 4100);
+    )
+}
+
+TEST_CASE("Current process is reported as running", "[core][processProbe]")
+{
+    ASSERT(
+        CHECK(ProcessProbe::isProcessRunning(static_cast<int>(QCoreApplication::applicationPid())));
+        CHECK_FALSE(ProcessProbe::isProcessRunning(0));
+    )
+}
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Find PID of a listening socket owned by this process", "[core][processProbe]")
+{
+    ARRANGE(
+        QTcpServer server;
+        REQUIRE(server.listen(QHostAddress::LocalHost, 0));
+    )
+
+    ACT(
+        int pid = ProcessProbe::findPidByPort(server.serverPort());
+        auto ports = ProcessProbe::listeningPorts();
+    )
+
+    ASSERT(
+        CHECK(pid == QCoreApplication::applicationPid());
+        CHECK(ports.value(server.serverPort()) == QCoreApplication::applicationPid());
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Find listening ports among a requested set", "[core][processProbe]")
+{
+    ARRANGE(
+        QTcpServer server;
+        REQUIRE(server.listen(QHostAddress::LocalHost, 0));
+
+        QTcpServer closed;
+        REQUIRE(closed.listen(QHostAddress::LocalHost, 0));
+        int closedPort = closed.serverPort();
+        closed.close();
+    )
+
+    ACT(
+        QSet<int> listening = ProcessProbe::findListeningPorts({server.serverPort(), closedPort});
+    )
+
+    ASSERT(
+        CHECK(listening.contains(server.serverPort()));
+        CHECK_FALSE(listening.contains(closedPort));
+    )
+}
+#endif
@@ -0,0 +1,237 @@
+// clang-format off
+
+#include "../../src/core/ProcessReconciler.h"
+#include "../../src/core/ProcessSupervisor.h"
+#include "../helpers/TestHelpers.h"
+#include <QSemaphore>
+#include <QTest>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    using PortOwners = QHash<int, int>;
+
+    Process makeProcess(int id, Process::Status status, int pid, int port)
+    {
+        Process process;
+        process.setId(id);
+        process.setStatus(status);
+        process.setPID(pid);
+        process.setPort(port);
+        return process;
+    }
+
+    std::optional<Process> findCorrected(const QList<Process>& corrected, int id)
+    {
+        for (const Process& process : corrected)
+        {
+            if (process.getId() == id)
+                return process;
+        }
+        return std::nullopt;
+    }
+
+    // Active processes kept in memory; only what the reconciler reads and writes does anything
+    class FakeProcessRepository : public IProcessRepository
+    {
+      public:
+        QList<Process> active;
+        QList<Process> updated;
+
+        std::optional<Process> findById(int) override { return std::nullopt; }
+        QList<Process> findAll() override { return active; }
+        std::optional<Process> save(const Process& process) override { return process; }
+        bool deleteById(int) override { return false; }
+        QList<Process> findByProjectId(int) override { return active; }
+        QList<Process> findActive() override { return active; }
+        QHash<int, QList<int>> findDependenciesByProjectId(int) override { return {}; }
+        QList<int> findDependencyIds(int) override { return {}; }
+        bool setDependencies(int, const QList<int>&) override { return false; }
+        Process mapFromRecord(const QSqlQuery&) override { return Process(); }
+
+        bool updateRuntimeStates(const QList<Process>& processes) override
+        {
+            updated.append(processes);
+            return true;
+        }
+    };
+
+    // Until the snapshots queued so far were taken and their results posted back, then delivers them
+    void waitForWorker()
+    {
+        QSemaphore idle;
+        ProcessSupervisor::instance().runOnWorker([&idle]() { idle.release(); });
+        idle.acquire();
+        QTest::qWait(50);
+    }
+}
+
+TEST_CASE("Running processes with a live PID are left alone", "[core][processReconciler]")
+{
+    ARRANGE(
+        ProcessReconciler::Snapshot snapshot;
+        snapshot.livePids = QSet<int>({100});
+    )
+
+    ACT(
+        auto corrected = ProcessReconciler::reconcile({makeProcess(1, Process::Status::Running, 100, 3000)}, snapshot);
+    )
+
+    ASSERT(
+        CHECK(corrected.isEmpty());
+    )
+}
+
+TEST_CASE("A dead PID is replaced by the port owner or marked stopped", "[core][processReconciler]")
+{
+    ARRANGE(
+        ProcessReconciler::Snapshot snapshot;
+        snapshot.portOwners = PortOwners({{3000, 200}});
+        QList<Process> processes({
+            makeProcess(1, Process::Status::Running, 100, 3000),
+            makeProcess(2, Process::Status::Running, 101, 4000),
+        });
+    )
+
+    ACT(
+        auto corrected = ProcessReconciler::reconcile(processes, snapshot);
+        auto moved = findCorrected(corrected, 1);
+        auto stopped = findCorrected(corrected, 2);
+    )
+
+    ASSERT(
+        REQUIRE(corrected.size() == 2);
+        REQUIRE(moved.has_value());
+        CHECK(moved->getStatus() == Process::Status::Running);
+        CHECK(moved->getPID() == 200);
+        REQUIRE(stopped.has_value());
+        CHECK(stopped->getStatus() == Process::Status::Stopped);
+        CHECK(stopped->getPID() == 0);
+    )
+}
+
+TEST_CASE("A start left over from a previous session is Running once its port is bound", "[core][processReconciler]")
+{
+    ARRANGE(
+        ProcessReconciler::Snapshot snapshot;
+        snapshot.livePids = QSet<int>({100, 101});
+        snapshot.portOwners = PortOwners({{3000, 300}});
+        QList<Process> processes({
+            makeProcess(1, Process::Status::Starting, 100, 3000),
+            makeProcess(2, Process::Status::Starting, 101, 4000),
+        });
+    )
+
+    ACT(
+        auto corrected = ProcessReconciler::reconcile(processes, snapshot);
+    )
+
+    ASSERT(
+        CHECK(findCorrected(corrected, 1)->getStatus() == Process::Status::Running);
+        CHECK(findCorrected(corrected, 1)->getPID() == 300);
+        // Still alive without its port: left Starting for the supervisor
+        CHECK_FALSE(findCorrected(corrected, 2).has_value());
+    )
+}
+
+TEST_CASE("A live start reads the socket table and becomes Running once its port is bound", "[core][processReconciler]")
+{
+    ARRANGE(
+        QList<Process> processes({
+            makeProcess(1, Process::Status::Starting, 100, 3000),
+            makeProcess(2, Process::Status::Starting, 101, 4000),
+            makeProcess(3, Process::Status::Running, 102, 5000),
+        });
+        // Built the way takeSnapshot() builds it: every PID alive, port owners only when asked for
+        ProcessReconciler::Snapshot snapshot;
+        snapshot.livePids = QSet<int>({100, 101, 102});
+    )
+
+    ACT(
+        const bool needsPortOwners = ProcessReconciler::needsPortOwners(processes, snapshot.livePids);
+        if (needsPortOwners)
+            snapshot.portOwners = PortOwners({{3000, 300}, {5000, 102}});
+        auto corrected = ProcessReconciler::reconcile(processes, snapshot);
+        auto running = findCorrected(corrected, 1);
+    )
+
+    ASSERT(
+        CHECK(needsPortOwners);
+        REQUIRE(corrected.size() == 1);
+        REQUIRE(running.has_value());
+        CHECK(running->getStatus() == Process::Status::Running);
+        CHECK(running->getPID() == 300);
+    )
+}
+
+TEST_CASE("Live running processes do not need the socket table", "[core][processReconciler]")
+{
+    ARRANGE(
+        QList<Process> processes({
+            makeProcess(1, Process::Status::Running, 100, 3000),
+            makeProcess(2, Process::Status::Starting, 101, 0),
+        });
+    )
+
+    ACT(
+        const bool allAlive = ProcessReconciler::needsPortOwners(processes, {100, 101});
+        const bool oneDead = ProcessReconciler::needsPortOwners(processes, {101});
+    )
+
+    ASSERT(
+        CHECK_FALSE(allAlive);
+        CHECK(oneDead);
+    )
+}
+
+TEST_CASE("Errors stay visible once nothing is running", "[core][processReconciler]")
+{
+    ARRANGE(
+        ProcessReconciler::Snapshot snapshot;
+        QList<Process> processes({
+            makeProcess(1, Process::Status::Error, 100, 3000),
+            makeProcess(2, Process::Status::Error, 0, 4000),
+        });
+    )
+
+    ACT(
+        auto corrected = ProcessReconciler::reconcile(processes, snapshot);
+    )
+
+    ASSERT(
+        REQUIRE(corrected.size() == 1);
+        CHECK(corrected.first().getId() == 1);
+        CHECK(corrected.first().getStatus() == Process::Status::Error);
+        CHECK(corrected.first().getPID() == 0);
+    )
+}
+
+TEST_CASE("An asynchronous reconcile writes nothing once its context is gone", "[core][processReconciler]")
+{
+    ARRANGE(
+        FakeProcessRepository repository;
+        // A PID that cannot exist, so the process is stopped
+        repository.active.append(makeProcess(9201, Process::Status::Running, 0x7ffffff0, 0));
+        auto* gone = new QObject();
+        QObject alive;
+        bool goneCalled = false;
+        int changed = -1;
+    )
+
+    ACT(
+        ProcessReconciler::runAsync(repository, gone, [&goneCalled](int) { goneCalled = true; });
+        delete gone;
+        waitForWorker();
+        const qsizetype updatedWhileGone = repository.updated.size();
+        ProcessReconciler::runAsync(repository, &alive, [&changed](int count) { changed = count; });
+        waitForWorker();
+    )
+
+    ASSERT(
+        CHECK_FALSE(goneCalled);
+        CHECK(updatedWhileGone == 0);
+        CHECK(changed == 1);
+        REQUIRE(repository.updated.size() == 1);
+        CHECK(repository.updated.first().getStatus() == Process::Status::Stopped);
+    )
+}
@@ -0,0 +1,348 @@
+// clang-format off
+
+#include "../../src/core/ProcessProbe.h"
+#include "../../src/core/ProcessSupervisor.h"
+#include "../helpers/TestHelpers.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QProcess>
+#include <QSemaphore>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTest>
+#include <QThread>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(Q_OS_LINUX)
+#include <csignal>
+#include <unistd.h>
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Supervisor reports a process ready once its port listens", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy readySpy(&supervisor, &ProcessSupervisor::processReady);
+        QTcpServer server;
+        REQUIRE(server.listen(QHostAddress::LocalHost, 0));
+    )
+
+    ACT(
+        supervisor.awaitPort(9001, server.serverPort(), 5000);
+        bool ready = readySpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(ready);
+        CHECK(readySpy.first().at(0).toInt() == 9001);
+        CHECK(readySpy.first().at(1).toInt() == QCoreApplication::applicationPid());
+        CHECK(supervisor.isSupervised(9001));
+        supervisor.release(9001);
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Supervisor notices a bind within milliseconds", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy readySpy(&supervisor, &ProcessSupervisor::processReady);
+
+        QTcpServer probe;
+        REQUIRE(probe.listen(QHostAddress::LocalHost, 0));
+        quint16 port = probe.serverPort();
+        probe.close();
+    )
+
+    ACT(
+        supervisor.awaitPort(9005, port, 5000);
+        QElapsedTimer elapsed;
+        elapsed.start();
+        QTcpServer server;
+        REQUIRE(server.listen(QHostAddress::LocalHost, port));
+        bool ready = readySpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(ready);
+        CHECK(readySpy.first().at(0).toInt() == 9005);
+        CHECK(elapsed.elapsed() < ProcessSupervisor::ReadinessMaxIntervalMs);
+        supervisor.release(9005);
+    )
+}
+#endif
+
+TEST_CASE("Supervisor times out when nothing listens", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy timeoutSpy(&supervisor, &ProcessSupervisor::startupTimedOut);
+    )
+
+    ACT(
+        supervisor.awaitPort(9002, 1, 0);
+        bool timedOut = timeoutSpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(timedOut);
+        CHECK(timeoutSpy.first().at(0).toInt() == 9002);
+        CHECK_FALSE(supervisor.isSupervised(9002));
+    )
+}
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("A process without a port is ready once it outlives the grace period", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy readySpy(&supervisor, &ProcessSupervisor::processReady);
+        QSignalSpy stoppedSpy(&supervisor, &ProcessSupervisor::processStopped);
+        QProcess worker;
+        supervisor.trackLaunch(&worker);
+        worker.start("sleep", {"30"});
+        REQUIRE(worker.waitForStarted());
+        const int pid = static_cast<int>(worker.processId());
+    )
+
+    ACT(
+        QElapsedTimer elapsed;
+        elapsed.start();
+        supervisor.awaitRunning(9008, pid, 200);
+        bool ready = readySpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(ready);
+        CHECK(elapsed.elapsed() >= 200);
+        CHECK(readySpy.first().at(0).toInt() == 9008);
+        CHECK(readySpy.first().at(1).toInt() == pid);
+        CHECK(stoppedSpy.isEmpty());
+        supervisor.release(9008);
+        worker.kill();
+        worker.waitForFinished();
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("A process without a port that exits during the grace period is stopped", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy readySpy(&supervisor, &ProcessSupervisor::processReady);
+        QSignalSpy stoppedSpy(&supervisor, &ProcessSupervisor::processStopped);
+        QProcess worker;
+        supervisor.trackLaunch(&worker);
+        worker.start("sleep", {"30"});
+        REQUIRE(worker.waitForStarted());
+        supervisor.awaitRunning(9009, static_cast<int>(worker.processId()), 5000);
+    )
+
+    ACT(
+        worker.kill();
+        bool stopped = stoppedSpy.wait(5000);
+    )
+
+    ASSERT(
+        REQUIRE(stopped);
+        CHECK(stoppedSpy.first().at(0).toInt() == 9009);
+        CHECK(readySpy.isEmpty());
+        CHECK_FALSE(supervisor.isSupervised(9009));
+    )
+}
+#endif
+
+TEST_CASE("Released processes are no longer supervised", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        supervisor.monitor(9003, static_cast<int>(QCoreApplication::applicationPid()), 0);
+    )
+
+    ACT(
+        supervisor.release(9003);
+    )
+
+    ASSERT(
+        CHECK_FALSE(supervisor.isSupervised(9003));
+    )
+}
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Supervisor notices an exit without waiting for the monitor tick", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy stoppedSpy(&supervisor, &ProcessSupervisor::processStopped);
+        QProcess child;
+        supervisor.trackLaunch(&child);
+        child.start("sleep", {"30"});
+        REQUIRE(child.waitForStarted());
+        supervisor.monitor(9004, static_cast<int>(child.processId()), 0);
+    )
+
+    ACT(
+        QElapsedTimer elapsed;
+        elapsed.start();
+        child.kill();
+        bool stopped = stoppedSpy.wait(ProcessSupervisor::MonitorIntervalMs * 2);
+    )
+
+    ASSERT(
+        REQUIRE(stopped);
+        CHECK(stoppedSpy.first().at(0).toInt() == 9004);
+        CHECK(elapsed.elapsed() < ProcessSupervisor::MonitorIntervalMs);
+        CHECK_FALSE(supervisor.isSupervised(9004));
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Stopping a process also stops the children it spawned", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy stopSpy(&supervisor, &ProcessSupervisor::stopFinished);
+
+        QProcess shell;
+        supervisor.trackLaunch(&shell);
+        shell.setChildProcessModifier([]() { ::setsid(); });
+        shell.start("/bin/sh", {"-c", "sleep 30 & sleep 30 & wait"});
+        REQUIRE(shell.waitForStarted());
+        int shellPid = static_cast<int>(shell.processId());
+
+        QList<int> children;
+        QElapsedTimer spawned;
+        spawned.start();
+        while (children.size() < 2 && spawned.elapsed() < 5000)
+        {
+            QThread::msleep(10);
+            children = ProcessProbe::findProcessGroupMembers(shellPid);
+            children.removeAll(shellPid);
+        }
+        REQUIRE(children.size() == 2);
+    )
+
+    ACT(
+        supervisor.stop(9006, {shellPid}, 0);
+        bool finished = stopSpy.wait(ProcessSupervisor::StopTimeoutMs * 2);
+    )
+
+    ASSERT(
+        REQUIRE(finished);
+        CHECK(shell.waitForFinished(1000));
+        CHECK(ProcessProbe::findProcessGroupMembers(shellPid).isEmpty());
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Stopping a PID in a group DevPilot did not create spares the rest of the group", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QSignalSpy stopSpy(&supervisor, &ProcessSupervisor::stopFinished);
+
+        // Stands in for a terminal job: a group of its own that no launch of ours leads
+        QProcess launcher;
+        supervisor.trackLaunch(&launcher);
+        launcher.start("/bin/sh", {"-c", "setsid /bin/sh -c 'sleep 30 & wait' & echo $!"});
+        REQUIRE(launcher.waitForFinished(5000));
+        const int foreignPid = launcher.readAllStandardOutput().trimmed().toInt();
+        REQUIRE(foreignPid > 0);
+
+        QList<int> members;
+        QElapsedTimer spawned;
+        spawned.start();
+        while (members.size() < 2 && spawned.elapsed() < 5000)
+        {
+            QThread::msleep(10);
+            members = ProcessProbe::findProcessGroupMembers(foreignPid);
+        }
+        members.removeAll(foreignPid);
+        REQUIRE(members.size() == 1);
+    )
+
+    ACT(
+        supervisor.stop(9007, {foreignPid}, 0);
+        bool finished = stopSpy.wait(ProcessSupervisor::StopTimeoutMs * 2);
+    )
+
+    ASSERT(
+        REQUIRE(finished);
+        CHECK_FALSE(ProcessProbe::isProcessRunning(foreignPid));
+        CHECK(ProcessProbe::isProcessRunning(members.first()));
+        ::kill(-foreignPid, SIGKILL);
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Supervisor reaps an adopted daemon that left the group of its command", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QProcess shell;
+        supervisor.trackLaunch(&shell);
+        shell.setChildProcessModifier([]() { ::setsid(); });
+        // The daemon leads a session of its own, so pid == pgid, and is adopted when the shell exits
+        shell.start("/bin/sh", {"-c", "setsid sleep 1 & echo $!"});
+        REQUIRE(shell.waitForFinished(5000));
+        const int daemonPid = shell.readAllStandardOutput().trimmed().toInt();
+        REQUIRE(daemonPid > 0);
+    )
+
+    ACT(
+        // Nothing is supervised, so only the exit of the watched orphan can reap it
+        auto isOurChild = [daemonPid]()
+        {
+            for (const ProcessProbe::ProcessEntry& child : ProcessProbe::findChildren(static_cast<int>(::getpid())))
+            {
+                if (child.pid == daemonPid)
+                    return true;
+            }
+            return false;
+        };
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (isOurChild() && elapsed.elapsed() < 5000)
+            QTest::qWait(20);
+    )
+
+    ASSERT(
+        CHECK_FALSE(isOurChild());
+        CHECK_FALSE(ProcessProbe::isProcessRunning(daemonPid));
+    )
+}
+
+TEST_CASE("Supervisor leaves an untracked child in its session to its QProcess", "[core][processSupervisor]")
+{
+    ARRANGE(
+        ProcessSupervisor& supervisor = ProcessSupervisor::instance();
+        QProcess child;
+        child.start("/bin/sh", {"-c", "exit 3"});
+        REQUIRE(child.waitForStarted());
+        // Without the event loop the QProcess does not collect it, so it lingers as a zombie
+        QThread::msleep(200);
+    )
+
+    ACT(
+        // A stop reaps on the worker; waiting on the worker instead of the event loop keeps the zombie there
+        supervisor.stop(9007, QList<int>(), 0);
+        QSemaphore reaped;
+        supervisor.runOnWorker([&reaped]() { reaped.release(); });
+        reaped.acquire();
+        bool finished = child.waitForFinished(5000);
+    )
+
+    ASSERT(
+        REQUIRE(finished);
+        CHECK(child.exitStatus() == QProcess::NormalExit);
+        CHECK(child.exitCode() == 3);
+    )
+}
+#endif
@@ -0,0 +1,136 @@
+// clang-format off
+
+#include "../../src/core/ResourceSampler.h"
+#include "../../src/core/RingBuffer.h"
+#include "../helpers/TestHelpers.h"
+#include <QCoreApplication>
+#include <QProcess>
+#include <QSignalSpy>
+#include <catch2/catch_test_macros.hpp>
+
+#if defined(Q_OS_LINUX)
+#include <csignal>
+#endif
+
+using CounterHistory = QHash<int, ResourceSampler::Counters>;
+
+TEST_CASE("Ring buffer keeps the newest values once full", "[core][resourceSampler]")
+{
+    ARRANGE(
+        RingBuffer<int> buffer(3);
+    )
+
+    ACT(
+        for (int value = 1; value <= 5; ++value)
+            buffer.push(value);
+    )
+
+    ASSERT(
+        REQUIRE(buffer.size() == 3);
+        CHECK(buffer.capacity() == 3);
+        CHECK(buffer.toList() == QList<int>({3, 4, 5}));
+        CHECK(buffer.last() == 5);
+    )
+}
+
+TEST_CASE("Parse CPU ticks and threads from a stat line", "[core][resourceSampler]")
+{
+    ARRANGE(
+        QByteArray stat = "4242 (node (dev)) S 4200 4242 4242 0 -1 4194560 1510 0 0 0 250 50 0 0 20 0 11 0 123456\n";
+        ResourceSampler::Counters counters;
+    )
+
+    ACT(
+        bool parsed = ResourceSampler::parseStat(stat, counters);
+    )
+
+    ASSERT(
+        REQUIRE(parsed);
+        CHECK(counters.cpuTicks == 300);
+        CHECK(counters.threads == 11);
+    )
+}
+
+TEST_CASE("Parse resident pages and I/O counters", "[core][resourceSampler]")
+{
+    ARRANGE(
+        ResourceSampler::Counters counters;
+        QByteArray io = "rchar: 3980\nwchar: 12\nsyscr: 9\nsyscw: 1\nread_bytes: 8192\nwrite_bytes: 4096\n"
+                        "cancelled_write_bytes: 0\n";
+    )
+
+    ACT(
+        bool statmParsed = ResourceSampler::parseStatm("660 354 329 5 0 123 0\n", counters);
+        bool ioParsed = ResourceSampler::parseIo(io, counters);
+    )
+
+    ASSERT(
+        REQUIRE(statmParsed);
+        REQUIRE(ioParsed);
+        CHECK(counters.residentBytes > 0);
+        CHECK(counters.residentBytes % 354 == 0);
+        CHECK(counters.readBytes == 8192);
+        CHECK(counters.writeBytes == 4096);
+    )
+}
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Sampling a tree includes the children of the root", "[core][resourceSampler]")
+{
+    ARRANGE(
+        QProcess shell;
+        shell.start("/bin/sh", {"-c", "sleep 30 & sleep 30 & wait"});
+        REQUIRE(shell.waitForStarted());
+        CounterHistory previous;
+
+        ResourceSample sample;
+        for (int attempt = 0; attempt < 100 && sample.processCount < 3; ++attempt)
+        {
+            QThread::msleep(10);
+            sample = ResourceSampler::sampleTree(static_cast<int>(shell.processId()), previous);
+        }
+    )
+
+    ACT(
+        ResourceSample second = ResourceSampler::sampleTree(static_cast<int>(shell.processId()), previous);
+    )
+
+    ASSERT(
+        CHECK(second.processCount == 3);
+        CHECK(second.threads >= 3);
+        CHECK(second.residentBytes > 0);
+        CHECK(second.openFiles > 0);
+        CHECK(second.cpuPercent >= 0.0);
+        CHECK(previous.size() == 3);
+
+        for (int pid : previous.keys())
+            ::kill(pid, SIGKILL);
+        shell.waitForFinished();
+    )
+}
+#endif
+
+#if defined(Q_OS_LINUX)
+TEST_CASE("Watched processes build up a sample history", "[core][resourceSampler]")
+{
+    ARRANGE(
+        ResourceSampler& sampler = ResourceSampler::instance();
+        QSignalSpy sampledSpy(&sampler, &ResourceSampler::sampled);
+    )
+
+    ACT(
+        sampler.watch(9101, static_cast<int>(QCoreApplication::applicationPid()));
+        bool sampled = sampledSpy.wait(ResourceSampler::SampleIntervalMs * 2);
+        QList<ResourceSample> history = sampler.history(9101);
+        sampler.unwatch(9101);
+    )
+
+    ASSERT(
+        REQUIRE(sampled);
+        CHECK(sampledSpy.first().at(0).toInt() == 9101);
+        REQUIRE_FALSE(history.isEmpty());
+        CHECK(history.last().processCount >= 1);
+        CHECK(sampler.history(9101).isEmpty());
+    )
+}
+#endif
@@ -0,0 +1,117 @@
+// clang-format off
+
+#include "../../src/core/SegmentReader.h"
+#include "../helpers/LogTestHelpers.h"
+#include "../helpers/TestHelpers.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    QByteArray segmentText(const SegmentedLog& log, const LogSegment& segment)
+    {
+        QFile file(log.filePath(segment));
+        REQUIRE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+}
+
+TEST_CASE("Segment reader maps a finished segment", "[core][segmentReader]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        LogTestHelpers::writeLines(dir.path(), 0, 300);
+        SegmentedLog log(dir.path());
+        REQUIRE(log.load());
+        REQUIRE(log.segments().size() > 1);
+        const LogSegment segment = log.segments().first();
+        const QByteArray text = segmentText(log, segment);
+        SegmentReader reader(log, segment, true, segment.size);
+    )
+
+    ACT(
+        bool opened = reader.open();
+        qint64 available = 0;
+        const char* data = reader.dataAt(10, available);
+        QByteArray middle = reader.read(100, 50);
+        QByteArray past = reader.read(segment.size, 10);
+    )
+
+    ASSERT(
+        REQUIRE(opened);
+        CHECK(reader.isFinished());
+        CHECK(reader.blockBytes() == segment.size);
+        CHECK(available == segment.size - 10);
+        CHECK(QByteArray(data, 20) == text.mid(10, 20));
+        CHECK(middle == text.mid(100, 50));
+        CHECK(past.isEmpty());
+    )
+}
+
+TEST_CASE("Segment reader reads the open segment in blocks", "[core][segmentReader]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path());
+        REQUIRE(writer.openForAppend());
+        for (int i = 0; i < 5000; ++i)
+            writer.append(LogTestHelpers::requestLine(i));
+        SegmentedLog log(dir.path());
+        REQUIRE(log.load());
+        REQUIRE(log.segments().size() == 1);
+        const LogSegment segment = log.segments().last();
+        const QByteArray text = segmentText(log, segment);
+        SegmentReader reader(log, segment, false, segment.size);
+    )
+
+    ACT(
+        bool opened = reader.open();
+        qint64 available = 0;
+        const char* data = reader.dataAt(SegmentReader::ReadBytes - 10, available);
+        QByteArray acrossBlocks = reader.read(SegmentReader::ReadBytes - 50, 100);
+    )
+
+    ASSERT(
+        REQUIRE(opened);
+        CHECK_FALSE(reader.isFinished());
+        CHECK(reader.blockBytes() == SegmentReader::ReadBytes);
+        CHECK(available == 10);
+        CHECK(QByteArray(data, 10) == text.mid(SegmentReader::ReadBytes - 10, 10));
+        CHECK(acrossBlocks == text.mid(SegmentReader::ReadBytes - 50, 100));
+    )
+}
+
+TEST_CASE("Segment reader comes up short when the open segment is truncated", "[core][segmentReader]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path());
+        REQUIRE(writer.openForAppend());
+        for (int i = 0; i < 5000; ++i)
+            writer.append(LogTestHelpers::requestLine(i));
+        SegmentedLog log(dir.path());
+        REQUIRE(log.load());
+        const LogSegment segment = log.segments().last();
+        const QByteArray text = segmentText(log, segment);
+        SegmentReader reader(log, segment, false, segment.size);
+        REQUIRE(reader.open());
+    )
+
+    ACT(
+        REQUIRE(QFile::resize(log.filePath(segment), 100));
+        qint64 availableBefore = 0;
+        const char* before = reader.dataAt(10, availableBefore);
+        QByteArray beforeText(before, 20);
+        qint64 availableAfter = 0;
+        reader.dataAt(SegmentReader::ReadBytes + 10, availableAfter);
+        QByteArray rest = reader.read(50, segment.size);
+    )
+
+    ASSERT(
+        CHECK(availableBefore == 90);
+        CHECK(beforeText == text.mid(10, 20));
+        CHECK(availableAfter == 0);
+        CHECK(rest == text.mid(50, 50));
+    )
+}
@@ -0,0 +1,219 @@
+// clang-format off
+
+#include "../../src/core/SegmentedLog.h"
+#include "../helpers/TestHelpers.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    QByteArray readAll(const QString& path)
+    {
+        SegmentedLog log(path);
+        log.load();
+        return log.read(log.startOffset(), log.endOffset() - log.startOffset());
+    }
+}
+
+TEST_CASE("Segmented log rotates at the segment size", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path(), 10, 1000);
+        REQUIRE(log.openForAppend());
+    )
+
+    ACT(
+        log.append("first\n");
+        log.append("second\n");
+        log.append("third\n");
+        log.close();
+        SegmentedLog reader(dir.path());
+        reader.load();
+    )
+
+    ASSERT(
+        REQUIRE(reader.segments().size() == 3);
+        CHECK(reader.segments()[1].startOffset == 6);
+        CHECK(reader.segments()[2].startOffset == 13);
+        CHECK(reader.segments()[2].startedAt > 0);
+        CHECK(reader.endOffset() == 19);
+        CHECK(readAll(dir.path()) == "first\nsecond\nthird\n");
+    )
+}
+
+TEST_CASE("Segmented log reads across segment boundaries", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path(), 4, 1000);
+        REQUIRE(log.openForAppend());
+        for (const char* chunk : {"abcd", "efgh", "ijkl"})
+            log.append(chunk);
+    )
+
+    ACT(
+        QByteArray middle = log.read(2, 8);
+    )
+
+    ASSERT(
+        CHECK(middle == "cdefghij");
+    )
+}
+
+TEST_CASE("Segmented log deletes the oldest segments over the total size", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path(), 10, 25);
+        REQUIRE(log.openForAppend());
+    )
+
+    ACT(
+        for (int i = 0; i < 6; ++i)
+            log.append("0123456789");
+        QStringList files = QDir(dir.path()).entryList({"*.log"}, QDir::Files);
+    )
+
+    ASSERT(
+        // The segment being written always stays; only two full ones fit next to it
+        CHECK(files.size() == 3);
+        CHECK(log.startOffset() == 30);
+        CHECK(log.endOffset() == 60);
+        CHECK(log.read(0, 100) == "012345678901234567890123456789");
+    )
+}
+
+TEST_CASE("Segmented log deletes sidecars together with their segment", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog log(dir.path(), 10, 15);
+        REQUIRE(log.openForAppend());
+        log.append("0123456789");
+        QFile sidecar(log.sidecarPath(log.segments().first(), "tri"));
+        REQUIRE(sidecar.open(QIODevice::WriteOnly));
+        sidecar.close();
+    )
+
+    ACT(
+        bool before = sidecar.exists();
+        for (int i = 0; i < 3; ++i)
+            log.append("0123456789");
+    )
+
+    ASSERT(
+        CHECK(before);
+        CHECK(sidecar.fileName().endsWith("0000000000000000.tri"));
+        CHECK_FALSE(sidecar.exists());
+    )
+}
+
+TEST_CASE("Segmented log archives finished segments", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path(), 100 * 1024, 1024 * 1024);
+        REQUIRE(writer.openForAppend());
+        for (int i = 0; i < 20000; ++i)
+            writer.append("GET /api/items/" + QByteArray::number(i) + " 200\n");
+        const QByteArray original = readAll(dir.path());
+        SegmentedLog reader(dir.path());
+        reader.load();
+        const QList<LogSegment> plain = reader.segments();
+    )
+
+    ACT(
+        int archived = reader.archiveFinished();
+        QList<LogSegment> segments = reader.segments();
+        writer.append("after archiving\n");
+    )
+
+    ASSERT(
+        REQUIRE(plain.size() > 2);
+        CHECK(archived == plain.size() - 1);
+        CHECK(segments.first().archived);
+        CHECK_FALSE(segments.last().archived);
+        CHECK(segments.first().fileId == plain.first().fileId);
+        CHECK(segments.first().size == plain.first().size);
+        CHECK_FALSE(QFile::exists(dir.filePath(plain.first().fileName)));
+        CHECK(QFileInfo(reader.filePath(segments.first())).size() * 5 < segments.first().size);
+        CHECK(readAll(dir.path()) == original + "after archiving\n");
+        CHECK(reader.archiveFinished() == 0);
+    )
+}
+
+TEST_CASE("Segmented log deletes archives like segments", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path(), 10, 25);
+        REQUIRE(writer.openForAppend());
+        writer.append("0123456789");
+        writer.append("0123456789");
+        SegmentedLog reader(dir.path());
+        reader.archiveFinished();
+        const QString archivePath = reader.filePath(reader.segments().first());
+    )
+
+    ACT(
+        bool before = QFile::exists(archivePath);
+        for (int i = 0; i < 3; ++i)
+            writer.append("0123456789");
+    )
+
+    ASSERT(
+        CHECK(before);
+        CHECK(archivePath.endsWith("0000000000000000.logz"));
+        CHECK_FALSE(QFile::exists(archivePath));
+    )
+}
+
+TEST_CASE("Segmented log continues after a reopen", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        {
+            SegmentedLog previousRun(dir.path());
+            REQUIRE(previousRun.openForAppend());
+            previousRun.append("before\n");
+        }
+        SegmentedLog log(dir.path());
+    )
+
+    ACT(
+        REQUIRE(log.openForAppend());
+        log.append("after\n");
+    )
+
+    ASSERT(
+        CHECK(log.segments().size() == 1);
+        CHECK(readAll(dir.path()) == "before\nafter\n");
+    )
+}
+
+TEST_CASE("Clearing a segmented log keeps the writer going", "[core][segmentedLog]")
+{
+    ARRANGE(
+        QTemporaryDir dir;
+        SegmentedLog writer(dir.path(), 10, 1000);
+        REQUIRE(writer.openForAppend());
+        writer.append("old line\n");
+        writer.append("old two\n");
+        SegmentedLog viewer(dir.path());
+    )
+
+    ACT(
+        REQUIRE(viewer.clear());
+        writer.append("new\n");
+        viewer.load();
+    )
+
+    ASSERT(
+        CHECK(viewer.startOffset() == 17);
+        CHECK(readAll(dir.path()) == "new\n");
+        CHECK(QDir(dir.path()).entryList({"*.log"}, QDir::Files).size() == 1);
+    )
+}
@@ -0,0 +1,56 @@
+#ifndef LOGTESTHELPERS_H
+#define LOGTESTHELPERS_H
+
+#include "../../src/core/SegmentedLog.h"
+#include <QByteArray>
+#include <QDir>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+
+// Fixtures for the indexes and filters built on a SegmentedLog
+namespace LogTestHelpers
+{
+    // An API request log; the request of every i ending in 42 failed
+    inline QByteArray requestLine(int i)
+    {
+        if (i % 100 == 42)
+            return "[api] Request " + QByteArray::number(i) + " failed: Connection REFUSED\n";
+        return "[api] GET /items/" + QByteArray::number(i) + " 200\n";
+    }
+
+    // Appends textAt(i), one or more whole lines, for every i in [first, first + count) to the log in
+    // path. Segments are small, so a few hundred lines span several of them.
+    inline void writeLines(const QString& path, int first, int count,
+                           const std::function<QByteArray(int)>& textAt = requestLine)
+    {
+        SegmentedLog log(path, 4096, 1024 * 1024);
+        REQUIRE(log.openForAppend());
+        for (int i = first; i < first + count; ++i)
+            log.append(textAt(i));
+    }
+
+    // The lines starting at offsets, without their newline
+    inline QList<QByteArray> linesAt(const QString& path, const QList<qint64>& offsets)
+    {
+        SegmentedLog log(path);
+        log.load();
+        QList<QByteArray> lines;
+        for (qint64 offset : offsets)
+        {
+            const QByteArray text = log.read(offset, 200);
+            lines.append(text.left(text.indexOf('\n')));
+        }
+        return lines;
+    }
+
+    // Sidecars of the segments in path with the given extension, e.g. "tri"
+    inline QStringList indexFiles(const QString& path, const QString& extension)
+    {
+        return QDir(path).entryList({"*." + extension}, QDir::Files);
+    }
+}
+
+#endif // LOGTESTHELPERS_H
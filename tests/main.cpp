@@ -1,11 +1,17 @@
 #include <catch2/catch_session.hpp>
-#include <QCoreApplication>
+#include <QApplication>
 #include <QSqlDatabase>
 #include <QDebug>
 
 int main(int argc, char* argv[])
 {
-    QCoreApplication app(argc, argv);
+    // Widget tests run headless unless a platform is requested explicitly
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
     QCoreApplication::addLibraryPath(QCoreApplication::applicationDirPath());
 
     int result = Catch::Session().run(argc, argv);
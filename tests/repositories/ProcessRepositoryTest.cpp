@@ -41,6 +41,18 @@ struct ProcessRepoFixture
         )");
         REQUIRE(success);
 
+        success = query.exec(R"(
+            CREATE TABLE IF NOT EXISTS process_dependencies (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                process_id INTEGER NOT NULL,
+                depends_on_id INTEGER NOT NULL,
+                FOREIGN KEY (process_id) REFERENCES processes (id) ON DELETE CASCADE,
+                FOREIGN KEY (depends_on_id) REFERENCES processes (id) ON DELETE CASCADE,
+                UNIQUE(process_id, depends_on_id)
+            )
+        )");
+        REQUIRE(success);
+
         repository = std::make_unique<ProcessRepository>(db);
     }
 
@@ -197,3 +209,114 @@ TEST_CASE_METHOD(ProcessRepoFixture, "Save with positive ID performs update", "[
         CHECK(result->getName() == "Modified");
     )
 }
+
+TEST_CASE_METHOD(ProcessRepoFixture, "setDependencies overwrites previous dependencies", "[repository][setDependencies]")
+{
+    ARRANGE(
+        auto postgres = repository->save(createTestProcess(1, "postgres"));
+        auto redis = repository->save(createTestProcess(1, "redis"));
+        auto api = repository->save(createTestProcess(1, "api"));
+        REQUIRE(postgres.has_value());
+        REQUIRE(redis.has_value());
+        REQUIRE(api.has_value());
+    )
+
+    ACT(
+        bool first = repository->setDependencies(api->getId(), {postgres->getId(), redis->getId()});
+        bool second = repository->setDependencies(api->getId(), {postgres->getId(), api->getId()});
+        QList<int> dependencies = repository->findDependencyIds(api->getId());
+    )
+
+    ASSERT(
+        CHECK(first);
+        CHECK(second);
+        CHECK(dependencies == QList<int>({postgres->getId()}));
+    )
+}
+
+TEST_CASE_METHOD(ProcessRepoFixture, "findDependenciesByProjectId only returns processes of that project", "[repository][findDependenciesByProjectId]")
+{
+    ARRANGE(
+        auto postgres = repository->save(createTestProcess(1, "postgres"));
+        auto api = repository->save(createTestProcess(1, "api"));
+        auto frontend = repository->save(createTestProcess(1, "frontend"));
+        auto other = repository->save(createTestProcess(2, "other"));
+        REQUIRE(other.has_value());
+
+        repository->setDependencies(api->getId(), {postgres->getId()});
+        repository->setDependencies(frontend->getId(), {api->getId()});
+        repository->setDependencies(other->getId(), {postgres->getId()});
+    )
+
+    ACT(
+        auto plan = repository->findDependenciesByProjectId(1);
+    )
+
+    ASSERT(
+        REQUIRE(plan.size() == 2);
+        CHECK(plan.value(api->getId()) == QList<int>({postgres->getId()}));
+        CHECK(plan.value(frontend->getId()) == QList<int>({api->getId()}));
+        CHECK_FALSE(plan.contains(other->getId()));
+    )
+}
+
+TEST_CASE_METHOD(ProcessRepoFixture, "updateRuntimeStates only writes runtime fields", "[repository][updateRuntimeStates]")
+{
+    ARRANGE(
+        auto first = repository->save(createTestProcess(1, "first"));
+        auto second = repository->save(createTestProcess(1, "second"));
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+
+        Process running = *first;
+        running.setName("Renamed");
+        running.setStatus(Process::Status::Running);
+        running.setPID(4242);
+        running.setLastStartedAt(QDateTime::currentDateTime());
+
+        Process failed = *second;
+        failed.setStatus(Process::Status::Error);
+    )
+
+    ACT(
+        bool updated = repository->updateRuntimeStates({running, failed});
+        auto storedFirst = repository->findById(first->getId());
+        auto storedSecond = repository->findById(second->getId());
+    )
+
+    ASSERT(
+        CHECK(updated);
+        REQUIRE(storedFirst.has_value());
+        REQUIRE(storedSecond.has_value());
+        CHECK(storedFirst->getName() == "first");
+        CHECK(storedFirst->getStatus() == Process::Status::Running);
+        CHECK(storedFirst->getPID() == 4242);
+        CHECK(storedFirst->getLastStartedAt().isValid());
+        CHECK(storedSecond->getStatus() == Process::Status::Error);
+    )
+}
+
+TEST_CASE_METHOD(ProcessRepoFixture, "findActive skips stopped processes", "[repository][findActive]")
+{
+    ARRANGE(
+        Process running = createTestProcess(1, "running");
+        running.setStatus(Process::Status::Running);
+        Process failed = createTestProcess(2, "failed");
+        failed.setStatus(Process::Status::Error);
+
+        repository->save(running);
+        repository->save(failed);
+        repository->save(createTestProcess(1, "stopped"));
+    )
+
+    ACT(
+        QStringList names;
+        for (const Process& process : repository->findActive())
+            names.append(process.getName());
+        names.sort();
+    )
+
+    ASSERT(
+        CHECK(names == QStringList({"failed", "running"}));
+    )
+}
@@ -0,0 +1,141 @@
+// clang-format off
+
+#include "../../src/repositories/ProcessRepository.h"
+#include "../../src/repositories/ProcessStatusWriter.h"
+#include "../helpers/TestHelpers.h"
+#include <QSignalSpy>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <catch2/catch_test_macros.hpp>
+
+struct ProcessStatusWriterFixture
+{
+    QSqlDatabase db;
+    std::unique_ptr<ProcessRepository> repository;
+
+    ProcessStatusWriterFixture()
+    {
+        db = QSqlDatabase::addDatabase("QSQLITE", "process_status_writer_test_connection");
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+
+        QSqlQuery query(db);
+        bool success = query.exec(R"(
+            CREATE TABLE IF NOT EXISTS processes (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                project_id INTEGER NOT NULL,
+                name TEXT NOT NULL,
+                command TEXT NOT NULL,
+                working_directory TEXT NOT NULL,
+                status TEXT NOT NULL DEFAULT 'stopped',
+                pid INTEGER,
+                port INTEGER,
+                log_path TEXT,
+                last_started_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+                uptime DATETIME,
+                created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+                updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
+            )
+        )");
+        REQUIRE(success);
+
+        repository = std::make_unique<ProcessRepository>(db);
+    }
+
+    ~ProcessStatusWriterFixture()
+    {
+        repository.reset();
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase("process_status_writer_test_connection");
+    }
+
+    Process createProcess(const QString& name)
+    {
+        Process process;
+        process.setProjectId(1);
+        process.setName(name);
+        process.setCommand("echo test");
+        process.setWorkingDirectory("/tmp");
+        auto saved = repository->save(process);
+        REQUIRE(saved.has_value());
+        return *saved;
+    }
+};
+
+TEST_CASE_METHOD(ProcessStatusWriterFixture, "Updates of one process are coalesced", "[repository][processStatusWriter]")
+{
+    ARRANGE(
+        ProcessStatusWriter writer(*repository);
+        Process process = createProcess("api");
+    )
+
+    ACT(
+        process.setStatus(Process::Status::Starting);
+        writer.enqueue(process);
+        process.setStatus(Process::Status::Running);
+        process.setPID(1234);
+        writer.enqueue(process);
+        int pending = writer.pendingCount();
+        auto beforeFlush = repository->findById(process.getId());
+        bool flushed = writer.flush();
+        auto afterFlush = repository->findById(process.getId());
+    )
+
+    ASSERT(
+        CHECK(pending == 1);
+        CHECK(beforeFlush->getStatus() == Process::Status::Stopped);
+        CHECK(flushed);
+        CHECK(writer.pendingCount() == 0);
+        CHECK(afterFlush->getStatus() == Process::Status::Running);
+        CHECK(afterFlush->getPID() == 1234);
+    )
+}
+
+TEST_CASE_METHOD(ProcessStatusWriterFixture, "A batch of processes is flushed by the timer", "[repository][processStatusWriter]")
+{
+    ARRANGE(
+        ProcessStatusWriter writer(*repository, 10);
+        QSignalSpy flushedSpy(&writer, &ProcessStatusWriter::flushed);
+
+        QList<Process> processes;
+        for (const QString& name : {"db", "api", "frontend"})
+            processes.append(createProcess(name));
+    )
+
+    ACT(
+        for (Process& process : processes)
+        {
+            process.setStatus(Process::Status::Running);
+            writer.enqueue(process);
+        }
+        bool flushed = flushedSpy.wait(1000);
+    )
+
+    ASSERT(
+        REQUIRE(flushed);
+        CHECK(flushedSpy.count() == 1);
+        CHECK(flushedSpy.first().at(0).toInt() == 3);
+        for (const Process& process : processes)
+            CHECK(repository->findById(process.getId())->getStatus() == Process::Status::Running);
+    )
+}
+
+TEST_CASE_METHOD(ProcessStatusWriterFixture, "Pending updates are written on destruction", "[repository][processStatusWriter]")
+{
+    ARRANGE(
+        Process process = createProcess("worker");
+        process.setStatus(Process::Status::Error);
+    )
+
+    ACT(
+        {
+            ProcessStatusWriter writer(*repository);
+            writer.enqueue(process);
+        }
+    )
+
+    ASSERT(
+        CHECK(repository->findById(process.getId())->getStatus() == Process::Status::Error);
+    )
+}